@@ -0,0 +1,116 @@
+/****************************************************************
+  File Name            : "cycle_report.c"
+  Title                : Cycle Budget Report
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Runs the firmware on the host simulator and prints the
+  simulated CPU cycles of:
+  - every interrupt handler (count, average, and maximum),
+    with a key pressed so ISR_INT0 runs, over 10 seconds.
+  - each FSM task function, called through fsm() at the
+    sleep point of the main loop with the interrupts off, so
+    the count is the task function alone.
+  The cycles are a lower bound (sim.h): register accesses,
+  __delay_cycles, and polling of the peripherals are timed.
+****************************************************************/
+
+#include <stdio.h>
+#include "header.h"
+#include "FSM.h"
+#include "sim.h"
+
+typedef struct {
+  int vector;
+  const char *name;
+} isr_name;
+
+typedef struct {
+  key keyVal;
+  const char *name;                     // Task function of the transition
+} task_step;
+
+static const isr_name isr_names[] = {
+  {INT0_vect,         "ISR_INT0 (keypad)"},
+  {INT1_vect,         "display_time_ISR (1Hz)"},
+  {INT2_vect,         "ISR_INT2"},
+  {INT3_vect,         "ISR_INT3 (alarm 1)"},
+  {TIMER2_COMP_vect,  "timeout_ISR"},
+  {TIMER1_COMPA_vect, "humidicon_ISR"},
+  {TIMER0_COMP_vect,  "lcd_tx_ISR"},
+  {USART0_UDRE_vect,  "telemetry_ISR"},
+  {USART0_TXC_vect,   "telemetry_TXC_ISR"},
+  {ADC_vect,          "co2_ADC_ISR"},
+  {EE_READY_vect,     "eelog_ISR"},
+};
+
+// Each transition of the FSM table with a different task function,
+// from the idle state back to the idle state.
+static const task_step task_steps[] = {
+  {zero,       "sensor_fn"},
+  {tempChange, "error_fn"},
+  {setTime,    "changeTime_fn (entry)"},
+  {one,        "changeTime_fn (digit)"},
+  {del,        "back_fn"},
+  {back,       "idle_fn"},
+  {setAlarm0,  "changeAlarm0_fn (entry)"},
+  {two,        "changeAlarm0_fn (digit)"},
+  {del,        "back_fn"},
+  {back,       "idle_fn"},
+  {co2,        "dispCO2_fn"},
+  {back,       "idle_fn"},
+  {del,        "diag_fn (entry)"},
+  {del,        "diag_fn (next probe)"},
+  {back,       "idle_fn"},
+};
+
+static void key_down(void *arg) {
+  keypad_model_set(*(unsigned char *)arg, 1);
+}
+
+static void key_up(void *arg) {
+  keypad_model_set(*(unsigned char *)arg, 0);
+}
+
+int main(void) {
+  static unsigned char key_position = 2;     // zero: sensor_fn, stays in idle
+  sim_time start, cycles;
+
+  humidicon_model_set(0, 0x2000, 0x1800);
+
+  // ----- Interrupts, after the power-on initialization ----- //
+  sim_run(SIM_SECONDS(1));
+  sim_irq_off_max = 0;
+  sim_at(SIM_SECONDS(4), key_down, &key_position);
+  sim_at(SIM_SECONDS(4) + SIM_MS(150), key_up, &key_position);
+  sim_run(SIM_SECONDS(9));
+
+  printf("%-26s %8s %10s %10s\n", "interrupt", "count", "average", "maximum");
+  for(unsigned int i = 0; i < sizeof(isr_names) / sizeof(isr_names[0]); i++) {
+    int v = isr_names[i].vector;
+
+    printf("%-26s %8lu %10llu %10llu\n", isr_names[i].name, sim_isr_count[v],
+           sim_isr_count[v] ? sim_isr_cycles[v] / sim_isr_count[v] : 0, sim_isr_max[v]);
+  }
+  printf("longest time with interrupts off after boot: %llu cycles\n\n", sim_irq_off_max);
+
+  // ----- FSM task functions ----- //
+  printf("%-26s %-14s %10s\n", "task function", "state", "cycles");
+  for(unsigned int i = 0; i < sizeof(task_steps) / sizeof(task_steps[0]); i++) {
+    static const char *const state_names[state_count] = {
+      "idle", "changeTime", "changeAlarm0", "dispCO2", "diag"
+    };
+    state ps = present_state;
+
+    sim_set_irq(0);
+    start = sim_now();
+    fsm(ps, task_steps[i].keyVal);
+    cycles = sim_now() - start;
+    sim_set_irq(1);
+    printf("%-26s %-14s %10llu\n", task_steps[i].name, state_names[ps], cycles);
+    sim_run(SIM_MS(500));                 // Main loop redraws, the LCD queue drains
+  }
+  return 0;
+}
@@ -0,0 +1,20 @@
+/****************************************************************
+  File Name            : "avr_macros.h" (host)
+  Title                : Bit Macros
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  Host replacement for the IAR avr_macros.h. Each macro reads
+  and writes its register once, like on the target.
+****************************************************************/
+
+#ifndef SIM_AVR_MACROS_H
+#define SIM_AVR_MACROS_H
+
+#define SETBIT(ADDRESS, BIT)    ((ADDRESS) |= (1 << (BIT)))
+#define CLEARBIT(ADDRESS, BIT)  ((ADDRESS) &= ~(1 << (BIT)))
+#define TESTBIT(ADDRESS, BIT)   ((ADDRESS) & (1 << (BIT)))
+
+#endif
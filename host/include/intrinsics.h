@@ -0,0 +1,32 @@
+/****************************************************************
+  File Name            : "intrinsics.h" (host)
+  Title                : Simulated IAR Intrinsic Functions
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  Host replacement for the IAR intrinsics.h. __interrupt and
+  __flash are dropped, the #pragma vector lines are ignored by
+  gcc, and the vector table is in host/sim/sim_vectors.c.
+  
+  The intrinsics run on simulated time (sim_io.c):
+  __delay_cycles advances it by the number of cycles, the I bit
+  of SREG is kept by the simulator, and __sleep sleeps in the 
+  mode selected in MCUCR until an interrupt wakes the CPU.
+****************************************************************/
+
+#ifndef SIM_INTRINSICS_H
+#define SIM_INTRINSICS_H
+
+#define __interrupt
+#define __flash
+
+extern void __delay_cycles(unsigned long cycles);
+extern void __enable_interrupt(void);
+extern void __disable_interrupt(void);
+extern unsigned char __save_interrupt(void);
+extern void __restore_interrupt(unsigned char sreg);
+extern void __sleep(void);
+
+#endif
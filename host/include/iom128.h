@@ -0,0 +1,163 @@
+/****************************************************************
+  File Name            : "iom128.h" (host)
+  Title                : Simulated ATmega128 Register Layer
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  Host replacement for the IAR iom128.h, picked up by header.h
+  through the include path of the host build (host/CMakeLists.txt).
+  
+  The port and data direction registers are plain variables, so
+  the drivers can keep their address tables (&PORTA). Every other
+  register is reached through sim_io() / sim_io16(), which first
+  brings the simulated peripherals up to date (sim_io.c). That lets
+  the simulator see a write to SPDR, EECR, UDR0, or a timer control
+  register, and compute PINx and TCNTx when they are read.
+  
+  int is 32 bits on the host, so the 16-bit registers are unsigned
+  ints. TCNT3 counts on all 32 bits: the Timer3 differences the 
+  firmware takes in unsigned int (event latency, awake time, 
+  profiler) are then right modulo 2^32, and do not wrap after 
+  32.7ms like on the target.
+  
+  Only the registers and bits used by src/ are declared.
+****************************************************************/
+
+#ifndef SIM_IOM128_H
+#define SIM_IOM128_H
+
+// ----- Registers behind sim_io() ----- //
+typedef enum {
+  sim_SPCR, sim_SPSR, sim_SPDR,
+  sim_MCUCR, sim_EIMSK, sim_EICRA, sim_EICRB, sim_EIFR,
+  sim_ADMUX, sim_ADCSRA,
+  sim_TCCR0, sim_TCNT0, sim_OCR0, sim_ASSR, sim_TIMSK, sim_TIFR, sim_ETIMSK, sim_ETIFR,
+  sim_TCCR1A, sim_TCCR1B, sim_TCCR2, sim_TCNT2, sim_OCR2, sim_TCCR3A, sim_TCCR3B,
+  sim_EEDR, sim_EECR,
+  sim_UCSR0A, sim_UCSR0B, sim_UCSR0C, sim_UBRR0L, sim_UBRR0H, sim_UDR0,
+  sim_SFIOR, sim_ACSR,
+  sim_PINA, sim_PINB, sim_PINC, sim_PIND, sim_PINE, sim_PINF, sim_PING,
+  sim_io_count
+} sim_io_reg;
+
+typedef enum {
+  sim_TCNT1, sim_OCR1A, sim_OCR1B, sim_ICR1, sim_TCNT3, sim_OCR3A, sim_ADC, sim_EEAR,
+  sim_io16_count
+} sim_io16_reg;
+
+extern volatile unsigned char *sim_io(sim_io_reg reg);
+extern volatile unsigned int *sim_io16(sim_io16_reg reg);
+
+#define SPCR    (*sim_io(sim_SPCR))
+#define SPSR    (*sim_io(sim_SPSR))
+#define SPDR    (*sim_io(sim_SPDR))
+#define MCUCR   (*sim_io(sim_MCUCR))
+#define EIMSK   (*sim_io(sim_EIMSK))
+#define EICRA   (*sim_io(sim_EICRA))
+#define EICRB   (*sim_io(sim_EICRB))
+#define EIFR    (*sim_io(sim_EIFR))
+#define ADMUX   (*sim_io(sim_ADMUX))
+#define ADCSRA  (*sim_io(sim_ADCSRA))
+#define TCCR0   (*sim_io(sim_TCCR0))
+#define TCNT0   (*sim_io(sim_TCNT0))
+#define OCR0    (*sim_io(sim_OCR0))
+#define ASSR    (*sim_io(sim_ASSR))
+#define TIMSK   (*sim_io(sim_TIMSK))
+#define TIFR    (*sim_io(sim_TIFR))
+#define ETIMSK  (*sim_io(sim_ETIMSK))
+#define ETIFR   (*sim_io(sim_ETIFR))
+#define TCCR1A  (*sim_io(sim_TCCR1A))
+#define TCCR1B  (*sim_io(sim_TCCR1B))
+#define TCCR2   (*sim_io(sim_TCCR2))
+#define TCNT2   (*sim_io(sim_TCNT2))
+#define OCR2    (*sim_io(sim_OCR2))
+#define TCCR3A  (*sim_io(sim_TCCR3A))
+#define TCCR3B  (*sim_io(sim_TCCR3B))
+#define EEDR    (*sim_io(sim_EEDR))
+#define EECR    (*sim_io(sim_EECR))
+#define UCSR0A  (*sim_io(sim_UCSR0A))
+#define UCSR0B  (*sim_io(sim_UCSR0B))
+#define UCSR0C  (*sim_io(sim_UCSR0C))
+#define UBRR0L  (*sim_io(sim_UBRR0L))
+#define UBRR0H  (*sim_io(sim_UBRR0H))
+#define UDR0    (*sim_io(sim_UDR0))
+#define SFIOR   (*sim_io(sim_SFIOR))
+#define ACSR    (*sim_io(sim_ACSR))
+#define PINA    (*sim_io(sim_PINA))
+#define PINB    (*sim_io(sim_PINB))
+#define PINC    (*sim_io(sim_PINC))
+#define PIND    (*sim_io(sim_PIND))
+#define PINE    (*sim_io(sim_PINE))
+#define PINF    (*sim_io(sim_PINF))
+#define PING    (*sim_io(sim_PING))
+
+#define TCNT1   (*sim_io16(sim_TCNT1))
+#define OCR1A   (*sim_io16(sim_OCR1A))
+#define OCR1B   (*sim_io16(sim_OCR1B))
+#define ICR1    (*sim_io16(sim_ICR1))
+#define TCNT3   (*sim_io16(sim_TCNT3))
+#define OCR3A   (*sim_io16(sim_OCR3A))
+#define ADC     (*sim_io16(sim_ADC))
+#define EEAR    (*sim_io16(sim_EEAR))
+
+// ----- Plain port registers ----- //
+extern volatile unsigned char PORTA, PORTB, PORTC, PORTD, PORTE, PORTF, PORTG;
+extern volatile unsigned char DDRA, DDRB, DDRC, DDRD, DDRE, DDRF, DDRG;
+
+// ----- Bit numbers ----- //
+enum {
+  // SPCR, SPSR
+  SPIE = 7, SPE = 6, DORD = 5, MSTR = 4, CPOL = 3, CPHA = 2, SPR1 = 1, SPR0 = 0,
+  SPIF = 7, WCOL = 6, SPI2X = 0,
+  // MCUCR
+  SRE = 7, SRW10 = 6, SE = 5, SM1 = 4, SM0 = 3, SM2 = 2, IVSEL = 1, IVCE = 0,
+  // EICRA, EIMSK, EIFR
+  ISC31 = 7, ISC30 = 6, ISC21 = 5, ISC20 = 4, ISC11 = 3, ISC10 = 2, ISC01 = 1, ISC00 = 0,
+  INT7 = 7, INT6 = 6, INT5 = 5, INT4 = 4, INT3 = 3, INT2 = 2, INT1 = 1, INT0 = 0,
+  INTF7 = 7, INTF6 = 6, INTF5 = 5, INTF4 = 4, INTF3 = 3, INTF2 = 2, INTF1 = 1, INTF0 = 0,
+  // ADMUX, ADCSRA
+  REFS1 = 7, REFS0 = 6, ADLAR = 5,
+  ADEN = 7, ADSC = 6, ADFR = 5, ADIF = 4, ADIE = 3, ADPS2 = 2, ADPS1 = 1, ADPS0 = 0,
+  // Timer0
+  FOC0 = 7, WGM00 = 6, COM01 = 5, COM00 = 4, WGM01 = 3, CS02 = 2, CS01 = 1, CS00 = 0,
+  AS0 = 3, TCN0UB = 2, OCR0UB = 1, TCR0UB = 0,
+  // TIMSK, TIFR
+  OCIE2 = 7, TOIE2 = 6, TICIE1 = 5, OCIE1A = 4, OCIE1B = 3, TOIE1 = 2, OCIE0 = 1, TOIE0 = 0,
+  OCF2 = 7, TOV2 = 6, ICF1 = 5, OCF1A = 4, OCF1B = 3, TOV1 = 2, OCF0 = 1, TOV0 = 0,
+  // Timer1, Timer3
+  WGM13 = 4, WGM12 = 3, CS12 = 2, CS11 = 1, CS10 = 0,
+  WGM33 = 4, WGM32 = 3, CS32 = 2, CS31 = 1, CS30 = 0,
+  // Timer2
+  FOC2 = 7, WGM20 = 6, COM21 = 5, COM20 = 4, WGM21 = 3, CS22 = 2, CS21 = 1, CS20 = 0,
+  // EECR
+  EERIE = 3, EEMWE = 2, EEWE = 1, EERE = 0,
+  // USART0
+  RXC0 = 7, TXC0 = 6, UDRE0 = 5, FE0 = 4, DOR0 = 3, UPE0 = 2, U2X0 = 1, MPCM0 = 0,
+  RXCIE0 = 7, TXCIE0 = 6, UDRIE0 = 5, RXEN0 = 4, TXEN0 = 3, UCSZ02 = 2, RXB80 = 1, TXB80 = 0,
+  UMSEL0 = 6, UPM01 = 5, UPM00 = 4, USBS0 = 3, UCSZ01 = 2, UCSZ00 = 1, UCPOL0 = 0,
+  // Port pins
+  PA7 = 7, PA6 = 6, PA5 = 5, PA4 = 4, PA3 = 3, PA2 = 2, PA1 = 1, PA0 = 0,
+  PB7 = 7, PB6 = 6, PB5 = 5, PB4 = 4, PB3 = 3, PB2 = 2, PB1 = 1, PB0 = 0,
+  PC7 = 7, PC6 = 6, PC5 = 5, PC4 = 4, PC3 = 3, PC2 = 2, PC1 = 1, PC0 = 0,
+  PD7 = 7, PD6 = 6, PD5 = 5, PD4 = 4, PD3 = 3, PD2 = 2, PD1 = 1, PD0 = 0,
+  PE7 = 7, PE6 = 6, PE5 = 5, PE4 = 4, PE3 = 3, PE2 = 2, PE1 = 1, PE0 = 0,
+  PG4 = 4, PG3 = 3, PG2 = 2, PG1 = 1, PG0 = 0,
+  DDB7 = 7, DDB6 = 6, DDB5 = 5, DDB4 = 4, DDB3 = 3, DDB2 = 2, DDB1 = 1, DDB0 = 0
+};
+
+// ----- Interrupt vectors (ignored by gcc with the #pragma) ----- //
+#define INT0_vect           2
+#define INT1_vect           3
+#define INT2_vect           4
+#define INT3_vect           5
+#define TIMER2_COMP_vect    10
+#define TIMER1_COMPA_vect   13
+#define TIMER0_COMP_vect    16
+#define USART0_UDRE_vect    20
+#define USART0_TXC_vect     21
+#define ADC_vect            22
+#define EE_READY_vect       23
+
+#endif
@@ -0,0 +1,24 @@
+/****************************************************************
+  File Name            : "stdio.h" (host)
+  Title                : printf to the LCD Buffers
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  The IAR printf writes through the putchar of 
+  lcd_ext_modified.c, so in the firmware sources (SIM_FIRMWARE
+  defined by host/CMakeLists.txt) printf is sent to 
+  sim_printf() (host/sim/sim_printf.c), which does the same.
+  The tests and the simulator keep the C library printf.
+****************************************************************/
+
+#include_next <stdio.h>
+
+#if defined(SIM_FIRMWARE) && !defined(SIM_STDIO_H)
+#define SIM_STDIO_H
+
+extern int sim_printf(const char *format, ...);
+#define printf sim_printf
+
+#endif
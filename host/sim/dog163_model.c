@@ -0,0 +1,126 @@
+/****************************************************************
+  File Name            : "dog163_model.c"
+  Title                : DOG163 LCD Model
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  EA DOGM163 (ST7036 controller, 3 lines of 16 characters) on
+  the SPI bus, /CSB on PB0 and RS on PB4. A byte is taken at
+  the end of its transfer, with RS as it was at the start:
+  RS = 1 writes DDRAM at the address counter, which then
+  increments. Line 1 is at 0x00, line 2 at 0x10, and line 3
+  at 0x20.
+
+  The controller is busy 26.3us after every byte (1.08ms
+  after Clear Display or Return Home), and for 40ms after
+  power-on. A byte that comes while it is busy is counted in
+  dog163_busy_violations.
+  The SPI mode must be 3 (data taken on the rising edge of
+  an idle high SCLK).
+****************************************************************/
+
+#include <string.h>
+#include "sim.h"
+#include "sim_internal.h"
+
+#define DOG163_POWER_ON     SIM_MS(40)
+#define DOG163_EXEC         421             // 26.3us
+#define DOG163_EXEC_LONG    SIM_US(1080)
+#define DOG163_CLEAR        0x01
+#define DOG163_HOME         0x02
+#define DOG163_SET_DDRAM    0x80
+#define DOG163_FUNCTION_SET 0x20
+
+static unsigned char ddram[0x80];
+static unsigned char address;
+static unsigned char instruction_table; // IS2:IS1 of the last Function Set
+static int cs_low;
+static sim_time busy_until = DOG163_POWER_ON;
+
+// ----- Statistics ----- //
+unsigned long dog163_commands;
+unsigned long dog163_data;
+unsigned long dog163_busy_violations;
+unsigned long dog163_clears;
+unsigned long dog163_mode_errors;
+
+/*************************************************************
+ Function             : void dog163_line(unsigned char line,
+                        char text[17])
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Characters of line 0-2, NUL terminated.
+*************************************************************/
+void dog163_line(unsigned char line, char text[17]) {
+  memcpy(text, &ddram[line * 0x10], 16);
+  text[16] = '\0';
+}
+
+/*************************************************************
+ Function             : void dog163_cs(int low)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ /CSB edge.
+*************************************************************/
+void dog163_cs(int low) {
+  cs_low = low;
+}
+
+/*************************************************************
+ Function             : void dog163_transfer(
+                        unsigned char out, int rs,
+                        unsigned char mode,
+                        unsigned long sclk)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Runs a command (rs = 0) or writes a character (rs = 1).
+ Only the commands that change the DDRAM or the address
+ counter are decoded.
+*************************************************************/
+void dog163_transfer(unsigned char out, int rs, unsigned char mode, unsigned long sclk) {
+  sim_time taken = sim_cycles + 8 * (SIM_FOSC / sclk);
+  sim_time exec = DOG163_EXEC;
+
+  if(!cs_low) {
+    return;
+  }
+  if(mode != 3) {
+    dog163_mode_errors++;
+  }
+  if(taken < busy_until) {
+    dog163_busy_violations++;
+  }
+
+  if(rs) {
+    ddram[address] = out;
+    address = (address + 1) & 0x7F;
+    dog163_data++;
+  } else {
+    dog163_commands++;
+    if(out == DOG163_CLEAR) {
+      memset(ddram, ' ', sizeof(ddram));
+      address = 0;
+      exec = DOG163_EXEC_LONG;
+      dog163_clears++;
+    } else if((out & 0xFE) == DOG163_HOME) {
+      address = 0;
+      exec = DOG163_EXEC_LONG;
+    } else if(out & DOG163_SET_DDRAM) {
+      address = out & 0x7F;
+    } else if((out & 0xE0) == DOG163_FUNCTION_SET) {
+      instruction_table = out & 0x03;
+    }
+  }
+  busy_until = taken + exec;
+}
@@ -0,0 +1,530 @@
+/****************************************************************
+  File Name            : "ds1306_model.c"
+  Title                : DS1306 RTC Model
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Serial alarm real-time clock on the SPI bus (CE on PA1).
+   0x00-0x06   seconds to year, BCD, 24 hour mode only
+   0x07-0x0A   Alarm 0, 0x0B-0x0E Alarm 1 (bit 7 = don't care)
+   0x0F        control: WP, 1HZ, AIE1, AIE0
+   0x10        status: IRQF1, IRQF0
+   0x20-0x7F   user RAM
+  Writes use the address with bit 7 set, and a burst wraps at
+  0x1F (clock) or 0x7F (RAM). The clock registers are copied
+  when CE rises, so a burst read is coherent. Accessing an
+  alarm register clears its IRQF flag.
+
+  The 1Hz output falls when the seconds increment and rises
+  half a second later. Writing the seconds register restarts
+  the countdown chain. /INT0 (PD2) is pulled low while IRQF0
+  and AIE0 are set, and 1INT (PD3) is high while IRQF1 and
+  AIE1 are set. The registers and the RAM are kept on the
+  battery: they are shared with the sim_fork() children.
+
+  The SPI mode must have CPHA = 1 and SCLK at most 2MHz (5V).
+****************************************************************/
+
+#include <string.h>
+#include "sim.h"
+#include "sim_internal.h"
+
+#define DS1306_CONTROL      0x0F
+#define DS1306_STATUS       0x10
+#define DS1306_RAM          0x20
+#define DS1306_WP           0x40
+#define DS1306_1HZ          0x04
+#define DS1306_MAX_SCLK     2000000UL
+
+// ----- Battery backed registers and RAM ----- //
+static unsigned char *ds_regs;
+
+// ----- Time base ----- //
+double ds1306_ppm;
+sim_time ds1306_first_second = SIM_SECONDS(1) / 2;
+static int ds_started;
+static double ds_edge_at;               // Exact time of the next 1Hz edge
+static sim_time ds_next_edge;
+static int ds_falling_next;             // Next edge increments the seconds
+static int ds_pin_1hz = 1;
+
+// ----- SPI transaction ----- //
+static int ds_ce;
+static unsigned int ds_byte;            // Bytes since CE rose
+static unsigned char ds_addr;
+static int ds_writing;
+static unsigned char ds_snapshot[7];    // Clock registers copied at CE rise
+
+// ----- Statistics ----- //
+unsigned long ds1306_transactions;
+unsigned long ds1306_time_reads;
+unsigned long ds1306_ram_writes;
+unsigned long ds1306_mode_errors;
+
+// ----- Local Function Prototypes ----- //
+static void ds_start(void);
+static void ds_schedule(double delay);
+static double ds_second(void);
+static void ds_increment(void);
+static int ds_alarm_match(unsigned char first);
+static void ds_access(unsigned char addr);
+static void ds_write(unsigned char addr, unsigned char value);
+static unsigned char bcd(unsigned char bin);
+static unsigned char bin(unsigned char bcd);
+
+/*************************************************************
+ Function             : void ds1306_shared_init()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Puts the registers in shared memory (sim_shared_init).
+*************************************************************/
+void ds1306_shared_init() {
+  ds_regs = sim_shared(0x80);
+  ds1306_power_on();
+}
+
+/*************************************************************
+ Function             : void ds1306_power_on()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ A new chip on its first power-up: 00:00:00 1/1/00, WP set,
+ alarms off, and the RAM holds a pattern that is not a valid
+ nv_stats block.
+*************************************************************/
+void ds1306_power_on() {
+  memset(ds_regs, 0, 0x80);
+  ds_regs[0x03] = 0x01;
+  ds_regs[0x04] = 0x01;
+  ds_regs[0x05] = 0x01;
+  ds_regs[DS1306_CONTROL] = DS1306_WP;
+  for(int addr = DS1306_RAM; addr < 0x80; addr++) {
+    ds_regs[addr] = (unsigned char)(addr * 37 + 11);
+  }
+}
+
+/*************************************************************
+ Function             : void ds1306_set_time(
+                        unsigned char hours,
+                        unsigned char minutes,
+                        unsigned char seconds,
+                        unsigned char date,
+                        unsigned char month,
+                        unsigned char year)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the clock registers (binary values) from a test.
+*************************************************************/
+void ds1306_set_time(unsigned char hours, unsigned char minutes, unsigned char seconds,
+                     unsigned char date, unsigned char month, unsigned char year) {
+  ds_regs[0x00] = bcd(seconds);
+  ds_regs[0x01] = bcd(minutes);
+  ds_regs[0x02] = bcd(hours);
+  ds_regs[0x04] = bcd(date);
+  ds_regs[0x05] = bcd(month);
+  ds_regs[0x06] = bcd(year);
+}
+
+/*************************************************************
+ Function             : void ds1306_get_time(
+                        unsigned char *hours,
+                        unsigned char *minutes,
+                        unsigned char *seconds)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Time of the clock registers, in binary.
+*************************************************************/
+void ds1306_get_time(unsigned char *hours, unsigned char *minutes, unsigned char *seconds) {
+  *hours = bin(ds_regs[0x02] & 0x3F);
+  *minutes = bin(ds_regs[0x01]);
+  *seconds = bin(ds_regs[0x00]);
+}
+
+/*************************************************************
+ Function             : unsigned char ds1306_peek(
+                        unsigned char addr)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Register or RAM byte (read address), for the tests.
+*************************************************************/
+unsigned char ds1306_peek(unsigned char addr) {
+  return ds_regs[addr & 0x7F];
+}
+
+/*************************************************************
+ Function             : void ds1306_poke(unsigned char addr,
+                        unsigned char value)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets a register or RAM byte from a test (no WP check).
+*************************************************************/
+void ds1306_poke(unsigned char addr, unsigned char value) {
+  ds_regs[addr & 0x7F] = value;
+}
+
+/*************************************************************
+ Function             : sim_time ds1306_next()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Time of the next 1Hz edge.
+*************************************************************/
+sim_time ds1306_next() {
+  if(!ds_started) {
+    ds_start();
+  }
+  return ds_next_edge;
+}
+
+/*************************************************************
+ Function             : void ds1306_update()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Runs the 1Hz edges that are due. The falling edge comes
+ with the next second and the alarm checks.
+*************************************************************/
+void ds1306_update() {
+  if(!ds_started) {
+    ds_start();
+  }
+  while(sim_cycles >= ds_next_edge) {
+    if(ds_falling_next) {
+      ds_pin_1hz = 0;
+      ds_increment();
+      if(ds_alarm_match(0x07)) {
+        ds_regs[DS1306_STATUS] |= 0x01;
+      }
+      if(ds_alarm_match(0x0B)) {
+        ds_regs[DS1306_STATUS] |= 0x02;
+      }
+    } else {
+      ds_pin_1hz = 1;
+    }
+    ds_falling_next = !ds_falling_next;
+    ds_schedule(ds_second() / 2);
+  }
+}
+
+/*************************************************************
+ Function             : int ds1306_pin_1hz()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Level of the 1Hz output (high while it is disabled).
+*************************************************************/
+int ds1306_pin_1hz() {
+  return !(ds_regs[DS1306_CONTROL] & DS1306_1HZ) || ds_pin_1hz;
+}
+
+/*************************************************************
+ Function             : int ds1306_pin_int0()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ True while /INT0 is asserted (pulled low).
+*************************************************************/
+int ds1306_pin_int0() {
+  return (ds_regs[DS1306_STATUS] & ds_regs[DS1306_CONTROL] & 0x01) != 0;
+}
+
+/*************************************************************
+ Function             : int ds1306_pin_1int()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Level of 1INT (active high).
+*************************************************************/
+int ds1306_pin_1int() {
+  return (ds_regs[DS1306_STATUS] & ds_regs[DS1306_CONTROL] & 0x02) != 0;
+}
+
+/*************************************************************
+ Function             : void ds1306_ce(int high)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ CE edge. A rising edge starts a transaction and copies
+ the clock registers.
+*************************************************************/
+void ds1306_ce(int high) {
+  ds_ce = high;
+  if(high) {
+    ds_byte = 0;
+    memcpy(ds_snapshot, ds_regs, sizeof(ds_snapshot));
+    ds1306_transactions++;
+  }
+}
+
+/*************************************************************
+ Function             : unsigned char ds1306_transfer(
+                        unsigned char out,
+                        unsigned char mode,
+                        unsigned long sclk)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ One byte of a transaction: the address, then data bytes
+ written or read at the address, which increments.
+*************************************************************/
+unsigned char ds1306_transfer(unsigned char out, unsigned char mode, unsigned long sclk) {
+  unsigned char in = 0xFF;
+  unsigned char addr;
+
+  if(!ds_ce) {
+    return 0xFF;
+  }
+  if(!(mode & 0x01) || (sclk > DS1306_MAX_SCLK)) {
+    ds1306_mode_errors++;
+  }
+  if(ds_byte++ == 0) {
+    ds_writing = (out & 0x80) != 0;
+    ds_addr = out & 0x7F;
+    if(!ds_writing && (ds_addr < 0x07)) {
+      ds1306_time_reads++;
+    }
+    return 0xFF;
+  }
+
+  addr = ds_addr;
+  ds_access(addr);
+  if(ds_writing) {
+    ds_write(addr, out);
+  } else {
+    in = (addr < 0x07) ? ds_snapshot[addr] : ds_regs[addr];
+  }
+  if(addr < DS1306_RAM) {
+    ds_addr = (addr + 1) & 0x1F;
+  } else {
+    ds_addr = (addr == 0x7F) ? DS1306_RAM : addr + 1;
+  }
+  return in;
+}
+
+/*************************************************************
+ Function             : static void ds_start()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ First falling edge at ds1306_first_second.
+*************************************************************/
+static void ds_start() {
+  ds_started = 1;
+  ds_falling_next = 1;
+  ds_edge_at = 0;
+  ds_schedule((double)ds1306_first_second);
+}
+
+/*************************************************************
+ Function             : static void ds_schedule(double delay)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Next 1Hz edge, delay cycles after the last one.
+*************************************************************/
+static void ds_schedule(double delay) {
+  ds_edge_at += delay;
+  ds_next_edge = (sim_time)ds_edge_at;
+  if(ds_next_edge <= sim_cycles) {
+    ds_next_edge = sim_cycles + 1;
+  }
+}
+
+/*************************************************************
+ Function             : static double ds_second()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ CPU cycles in a second of the DS1306 crystal.
+*************************************************************/
+static double ds_second() {
+  return (double)SIM_FOSC * (1.0 - ds1306_ppm * 1e-6);
+}
+
+/*************************************************************
+ Function             : static void ds_increment()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Next second of the calendar, with the leap years.
+*************************************************************/
+static void ds_increment() {
+  static const unsigned char month_days[13] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  unsigned char seconds = bin(ds_regs[0x00] & 0x7F), minutes = bin(ds_regs[0x01]);
+  unsigned char hours = bin(ds_regs[0x02] & 0x3F), day = ds_regs[0x03];
+  unsigned char date = bin(ds_regs[0x04]), month = bin(ds_regs[0x05]), year = bin(ds_regs[0x06]);
+  unsigned char days;
+
+  if(++seconds == 60) {
+    seconds = 0;
+    if(++minutes == 60) {
+      minutes = 0;
+      if(++hours == 24) {
+        hours = 0;
+        day = (day >= 7) ? 1 : day + 1;
+        days = ((month == 2) && ((year % 4) == 0)) ? 29 : month_days[(month >= 1 && month <= 12) ? month : 1];
+        if(++date > days) {
+          date = 1;
+          if(++month > 12) {
+            month = 1;
+            year = (year + 1) % 100;
+          }
+        }
+      }
+    }
+  }
+  ds_regs[0x00] = bcd(seconds);
+  ds_regs[0x01] = bcd(minutes);
+  ds_regs[0x02] = bcd(hours);
+  ds_regs[0x03] = day;
+  ds_regs[0x04] = bcd(date);
+  ds_regs[0x05] = bcd(month);
+  ds_regs[0x06] = bcd(year);
+}
+
+/*************************************************************
+ Function             : static int ds_alarm_match(
+                        unsigned char first)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ True if the seconds, minutes, hours, and day of the alarm
+ at first match the time. A register with bit 7 set
+ matches any value.
+*************************************************************/
+static int ds_alarm_match(unsigned char first) {
+  static const unsigned char time_regs[4] = {0x00, 0x01, 0x02, 0x03};
+
+  for(int i = 0; i < 4; i++) {
+    unsigned char alarm = ds_regs[first + i];
+
+    if(!(alarm & 0x80) && ((alarm & 0x7F) != (ds_regs[time_regs[i]] & 0x7F))) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/*************************************************************
+ Function             : static void ds_access(
+                        unsigned char addr)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Reading or writing an alarm register clears its flag.
+*************************************************************/
+static void ds_access(unsigned char addr) {
+  if((addr >= 0x07) && (addr <= 0x0A)) {
+    ds_regs[DS1306_STATUS] &= ~0x01;
+  } else if((addr >= 0x0B) && (addr <= 0x0E)) {
+    ds_regs[DS1306_STATUS] &= ~0x02;
+  }
+}
+
+/*************************************************************
+ Function             : static void ds_write(
+                        unsigned char addr,
+                        unsigned char value)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Data byte written at addr. With WP set only the control
+ register can be written.
+*************************************************************/
+static void ds_write(unsigned char addr, unsigned char value) {
+  if((ds_regs[DS1306_CONTROL] & DS1306_WP) && (addr != DS1306_CONTROL)) {
+    return;
+  }
+  if(addr < 0x07) {
+    ds_regs[addr] = (addr == 0x00) ? (value & 0x7F) : value;
+    if(addr == 0x00) {
+      // ----- Countdown chain restarts ----- //
+      ds_edge_at = (double)sim_cycles;
+      ds_falling_next = 1;
+      ds_pin_1hz = 1;
+      ds_schedule(ds_second());
+    }
+  } else if(addr < DS1306_CONTROL) {
+    ds_regs[addr] = value;
+  } else if(addr == DS1306_CONTROL) {
+    ds_regs[addr] = value & (DS1306_WP | DS1306_1HZ | 0x03);
+  } else if(addr >= DS1306_RAM) {
+    ds_regs[addr] = value;
+    ds1306_ram_writes++;
+  }
+}
+
+/*************************************************************
+ Function             : static unsigned char bcd(
+                        unsigned char bin)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Binary to BCD.
+*************************************************************/
+static unsigned char bcd(unsigned char bin) {
+  return (unsigned char)(((bin / 10) << 4) | (bin % 10));
+}
+
+/*************************************************************
+ Function             : static unsigned char bin(
+                        unsigned char bcd)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ BCD to binary.
+*************************************************************/
+static unsigned char bin(unsigned char bcd) {
+  return (unsigned char)((bcd >> 4) * 10 + (bcd & 0x0F));
+}
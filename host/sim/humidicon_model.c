@@ -0,0 +1,131 @@
+/****************************************************************
+  File Name            : "humidicon_model.c"
+  Title                : Humidicon Model
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Up to 8 Humidicon (HIH-6000 family) sensors on the SPI bus,
+  each with its own chip select.
+  A transaction of one byte or less is a measurement request:
+  the sensor measures the values set by the test for 36.65ms.
+  A longer transaction fetches the 4 data bytes:
+   byte 0    status (2 bits), RH bits 13-8
+   byte 1    RH bits 7-0
+   byte 2    temperature bits 13-6
+   byte 3    temperature bits 5-0, 2 unused bits
+  The status is 00 for the first fetch after a measurement
+  and 01 (stale) otherwise, also while measuring.
+  The SPI mode must be 0 with SCLK at most 800kHz.
+****************************************************************/
+
+#include "sim.h"
+#include "sim_internal.h"
+
+#define HUMIDICON_MAX_SCLK  800000UL
+
+typedef struct {
+  unsigned int rh, temp;                // Values set by the test
+  unsigned int rh_out, temp_out;        // Values of the last measurement
+  int measured;                         // A measurement was requested
+  int fetched;                          // Its data was fetched
+  int cs_low;
+  unsigned int bytes;                   // Bytes since the chip select fell
+  unsigned char frame[4];
+} humidicon_model;
+
+static humidicon_model sensors[SIM_HUMIDICONS];
+
+// ----- Statistics ----- //
+unsigned long humidicon_model_requests[SIM_HUMIDICONS];
+unsigned long humidicon_model_fetches[SIM_HUMIDICONS];
+unsigned long humidicon_model_stale[SIM_HUMIDICONS];
+sim_time humidicon_model_done[SIM_HUMIDICONS];
+unsigned long humidicon_model_mode_errors;
+
+/*************************************************************
+ Function             : void humidicon_model_set(
+                        unsigned char n,
+                        unsigned int rh_raw,
+                        unsigned int temp_raw)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ 14-bit RH and temperature sensor n measures from now on.
+*************************************************************/
+void humidicon_model_set(unsigned char n, unsigned int rh_raw, unsigned int temp_raw) {
+  sensors[n].rh = rh_raw & 0x3FFF;
+  sensors[n].temp = temp_raw & 0x3FFF;
+}
+
+/*************************************************************
+ Function             : void humidicon_model_cs(
+                        unsigned char n, int low)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Chip select edge of sensor n. The rising edge ends a
+ measurement request or a fetch.
+*************************************************************/
+void humidicon_model_cs(unsigned char n, int low) {
+  humidicon_model *s = &sensors[n];
+
+  s->cs_low = low;
+  if(low) {
+    s->bytes = 0;
+  } else if(s->bytes <= 1) {
+    s->rh_out = s->rh;
+    s->temp_out = s->temp;
+    s->measured = 1;
+    s->fetched = 0;
+    humidicon_model_done[n] = sim_cycles + SIM_HUMIDICON_MEASURE;
+    humidicon_model_requests[n]++;
+  } else {
+    humidicon_model_fetches[n]++;
+    if(s->frame[0] >> 6) {
+      humidicon_model_stale[n]++;
+    } else {
+      s->fetched = 1;
+    }
+  }
+}
+
+/*************************************************************
+ Function             : unsigned char humidicon_model_transfer(
+                        unsigned char n, unsigned char out,
+                        unsigned char mode,
+                        unsigned long sclk)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Next byte of the data frame of sensor n. The frame is
+ latched at its first byte.
+*************************************************************/
+unsigned char humidicon_model_transfer(unsigned char n, unsigned char out,
+                                       unsigned char mode, unsigned long sclk) {
+  humidicon_model *s = &sensors[n];
+
+  (void)out;
+  if(!s->cs_low) {
+    return 0xFF;
+  }
+  if((mode != 0) || (sclk > HUMIDICON_MAX_SCLK)) {
+    humidicon_model_mode_errors++;
+  }
+  if(s->bytes == 0) {
+    unsigned char status = (s->measured && !s->fetched && (sim_cycles >= humidicon_model_done[n])) ? 0 : 1;
+
+    s->frame[0] = (unsigned char)((status << 6) | (s->rh_out >> 8));
+    s->frame[1] = (unsigned char)s->rh_out;
+    s->frame[2] = (unsigned char)(s->temp_out >> 6);
+    s->frame[3] = (unsigned char)(s->temp_out << 2);
+  }
+  return (s->bytes < 4) ? s->frame[s->bytes++] : (s->bytes++, 0xFF);
+}
@@ -0,0 +1,83 @@
+/****************************************************************
+  File Name            : "keypad_model.c"
+  Title                : 4x4 Keypad Model
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Matrix keypad on PORTC, wired like keypad.c expects:
+   rows     PC3, PC2, PC1, PC0    key table offsets 0, 4, 8, 12
+   columns  PC7, PC6, PC5, PC4    offsets 0, 1, 2, 3
+  A key down connects its row and column. If one of them is
+  an output driving 0, both read 0. Inputs read 1 otherwise
+  (pull-ups). Keys are set by kTable position, and bouncing
+  contacts are scripted by the tests with sim_at().
+****************************************************************/
+
+#include "sim.h"
+#include "sim_internal.h"
+
+static unsigned int keys_down;          // Bit per kTable position
+
+/*************************************************************
+ Function             : void keypad_model_set(
+                        unsigned char position, int down)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Closes or opens the contact of a key.
+*************************************************************/
+void keypad_model_set(unsigned char position, int down) {
+  if(down) {
+    keys_down |= 1u << position;
+  } else {
+    keys_down &= ~(1u << position);
+  }
+  sim_pins_update();
+}
+
+/*************************************************************
+ Function             : void keypad_model_release_all()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Opens every contact.
+*************************************************************/
+void keypad_model_release_all() {
+  keys_down = 0;
+  sim_pins_update();
+}
+
+/*************************************************************
+ Function             : unsigned char keypad_model_pinc(
+                        unsigned char ddrc,
+                        unsigned char portc)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Levels of the PORTC pins with the keys that are down.
+*************************************************************/
+unsigned char keypad_model_pinc(unsigned char ddrc, unsigned char portc) {
+  unsigned char levels = (portc & ddrc) | ~ddrc;
+
+  for(int position = 0; position < 16; position++) {
+    unsigned char row = 1 << (3 - position / 4);
+    unsigned char column = 1 << (7 - position % 4);
+    unsigned char pins = row | column;
+
+    if(!(keys_down & (1u << position))) {
+      continue;
+    }
+    if(ddrc & ~portc & pins) {
+      levels &= ~pins;
+    }
+  }
+  return levels;
+}
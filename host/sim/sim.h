@@ -0,0 +1,148 @@
+/****************************************************************
+  File Name            : "sim.h"
+  Title                : ATmega128 Host Simulator
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Interface of the host simulator used by the tests and the
+  cycle harness. The firmware in src/ is compiled unchanged
+  against the shims in host/include, and every register access
+  goes through sim_io.c, which runs the peripherals and the
+  devices on the board on a simulated 16MHz clock:
+
+  - Timer0/1/2 (CTC) and Timer3 (normal), external interrupts,
+    ADC, EEPROM, USART0 transmitter, and the SPI master.
+  - DS1306 RTC, 8 Humidicons, DOG163 LCD, and the 4x4 keypad.
+  - Sleep modes: clk_IO stops in ADC Noise Reduction and
+    Power-down, and only the wake-up sources of the mode end
+    them.
+
+  A register access costs 1 cycle, __delay_cycles its count,
+  and an interrupt 4 cycles to enter and 4 to return. Other
+  CPU instructions are not timed, so cycle counts are a lower
+  bound of the target's, dominated by the peripherals (SPI,
+  EEPROM, USART) like on the target.
+
+  The firmware main runs in its own context, and sim_run()
+  lets it run until the simulated time is reached at a sleep.
+  sim_fork() runs a test in a child process: the EEPROM and
+  the DS1306 registers and RAM are shared with the parent, so
+  a reset or a power failure keeps them like on the board.
+****************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+// ----- Simulated time ----- //
+typedef unsigned long long sim_time;    // CPU cycles since reset
+
+#define SIM_FOSC            16000000ULL
+#define SIM_NEVER           (~(sim_time)0)
+#define SIM_US(us)          ((sim_time)(us) * (SIM_FOSC / 1000000))
+#define SIM_MS(ms)          ((sim_time)(ms) * (SIM_FOSC / 1000))
+#define SIM_SECONDS(s)      ((sim_time)(s) * SIM_FOSC)
+
+extern sim_time sim_now(void);
+
+// ----- Running the firmware ----- //
+extern int firmware_main(void);         // main() of Display_Time_Temp_Hum_FSM.c
+
+extern void sim_run(sim_time cycles);               // Boots the firmware on the first call
+extern void sim_advance(sim_time cycles);           // Runs the peripherals and interrupts only
+extern void sim_wake(void);                         // Ends a sleep of the firmware
+extern void sim_at(sim_time when, void (*fn)(void *arg), void *arg);
+extern int sim_fork(void (*child)(void *arg), void *arg);   // Exit status of the child
+extern void *sim_shared(unsigned long size);        // Memory shared with sim_fork() children
+
+// ----- CPU ----- //
+typedef enum {sim_active, sim_idle, sim_adc_noise, sim_power_down, sim_mode_count} sim_mode;
+
+#define SIM_VECTORS 35
+
+extern sim_time sim_mode_cycles[sim_mode_count];    // Time spent in each mode
+extern unsigned long sim_mode_entries[sim_mode_count];
+extern sim_time sim_wakeup_cycles;                  // Oscillator start-up after Power-down
+extern unsigned long sim_isr_count[SIM_VECTORS];
+extern sim_time sim_isr_cycles[SIM_VECTORS];        // Total time in each interrupt
+extern sim_time sim_isr_max[SIM_VECTORS];
+extern sim_time sim_irq_off_max;                    // Longest time with the I bit clear
+extern sim_time sim_delay_cycles;                   // Total of the __delay_cycles() calls
+extern int sim_irq_enabled(void);
+extern void sim_set_irq(int on);
+
+// ----- ADC ----- //
+extern unsigned int (*sim_adc_input)(unsigned char mux);    // 10-bit code of a conversion
+extern unsigned long sim_adc_conversions;
+extern unsigned long sim_adc_noisy;                 // Conversions ended while the CPU was awake
+
+// ----- EEPROM (4KB, shared with sim_fork() children) ----- //
+#define SIM_EEPROM_SIZE     4096
+#define SIM_EEPROM_WRITE    136000                  // 8.5ms
+#define SIM_POWER_FAIL      99                      // Exit status of a child at sim_power_fail_at
+
+extern unsigned char *sim_eeprom;
+extern unsigned long *sim_eeprom_writes;            // Erase/write cycles of each cell
+extern sim_time sim_power_fail_at;                  // Child exits here, a write in progress is lost
+
+// ----- USART0 transmitter ----- //
+extern void (*sim_usart_tx)(unsigned char data);    // Each byte when its stop bit ends
+extern int sim_usart_fd;                            // Also written here if >= 0
+extern unsigned long sim_usart_bytes;
+
+// ----- SPI ----- //
+typedef enum {sim_spi_humidicon, sim_spi_rtc = 8, sim_spi_lcd, sim_spi_devices} sim_spi_dev;
+
+typedef struct {
+  sim_time start;
+  unsigned int selected;                // Bit per sim_spi_dev
+  unsigned char mode;                   // CPOL:CPHA
+  unsigned long sclk;                   // Hz
+  unsigned char out, in;
+} sim_spi_byte;
+
+extern void (*sim_spi_trace)(const sim_spi_byte *b);
+extern unsigned long sim_spi_bytes[sim_spi_devices];
+extern unsigned long sim_spi_conflicts;             // Bytes sent with two devices selected
+extern unsigned long sim_spi_unselected;            // Bytes sent with no device selected
+extern sim_time sim_spi_busy;                       // Time the SPI was shifting
+
+// ----- DS1306 RTC ----- //
+extern void ds1306_set_time(unsigned char hours, unsigned char minutes, unsigned char seconds,
+                            unsigned char date, unsigned char month, unsigned char year);
+extern void ds1306_get_time(unsigned char *hours, unsigned char *minutes, unsigned char *seconds);
+extern unsigned char ds1306_peek(unsigned char addr);              // Register or RAM
+extern void ds1306_poke(unsigned char addr, unsigned char value);
+extern void ds1306_power_on(void);                  // Registers of a new chip, WP undefined (set)
+extern double ds1306_ppm;                           // Crystal error, > 0 runs fast
+extern sim_time ds1306_first_second;                // First 1Hz falling edge
+extern unsigned long ds1306_transactions;
+extern unsigned long ds1306_time_reads;             // Transactions reading the clock registers
+extern unsigned long ds1306_ram_writes;             // User RAM bytes written
+extern unsigned long ds1306_mode_errors;
+
+// ----- Humidicons ----- //
+#define SIM_HUMIDICONS          8
+#define SIM_HUMIDICON_MEASURE   586400              // 36.65ms
+
+extern void humidicon_model_set(unsigned char n, unsigned int rh_raw, unsigned int temp_raw);
+extern unsigned long humidicon_model_requests[SIM_HUMIDICONS];
+extern unsigned long humidicon_model_fetches[SIM_HUMIDICONS];
+extern unsigned long humidicon_model_stale[SIM_HUMIDICONS];     // Fetches of already fetched data
+extern sim_time humidicon_model_done[SIM_HUMIDICONS];           // End of the last measurement
+extern unsigned long humidicon_model_mode_errors;
+
+// ----- DOG163 LCD ----- //
+extern void dog163_line(unsigned char line, char text[17]);
+extern unsigned long dog163_commands;
+extern unsigned long dog163_data;
+extern unsigned long dog163_busy_violations;        // Bytes sent while the LCD was busy
+extern unsigned long dog163_clears;
+extern unsigned long dog163_mode_errors;
+
+// ----- Keypad ----- //
+extern void keypad_model_set(unsigned char position, int down);   // kTable position
+extern void keypad_model_release_all(void);
+
+#endif
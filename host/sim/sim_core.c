@@ -0,0 +1,631 @@
+/****************************************************************
+  File Name            : "sim_core.c"
+  Title                : Simulated Time, Interrupts and Sleep
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Runs the simulation from one event to the next: peripherals,
+  devices, calls scheduled by the tests (sim_at), and the
+  interrupts. An interrupt is taken when the I bit is set and
+  no interrupt is running, in the order of the vector numbers.
+  It costs 4 cycles to enter and 4 to return.
+
+  The IAR intrinsics are here. __sleep enters the mode of
+  MCUCR, and only the wake-up sources of that mode end it.
+  Leaving Power-down takes sim_wakeup_cycles: 16K CK, the
+  crystal start-up time of the board's fuses.
+
+  The firmware runs in its own context. When a sleep reaches
+  the time given to sim_run(), it switches back to the test.
+****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "sim.h"
+#include "sim_internal.h"
+
+#define SIM_STACK           (1 << 20)
+#define SIM_NO_SLEEP        SIM_SECONDS(5)  // Firmware never sleeping past sim_run()
+
+// ----- CPU state ----- //
+sim_time sim_cycles;
+sim_mode sim_cpu_mode = sim_active;
+int sim_in_isr;
+sim_time sim_mode_cycles[sim_mode_count];
+unsigned long sim_mode_entries[sim_mode_count];
+sim_time sim_wakeup_cycles = 16384;
+unsigned long sim_isr_count[SIM_VECTORS];
+sim_time sim_isr_cycles[SIM_VECTORS];
+sim_time sim_isr_max[SIM_VECTORS];
+sim_time sim_irq_off_max;
+sim_time sim_delay_cycles;
+sim_time sim_power_fail_at = SIM_NEVER;
+
+static int sreg_i;                      // I bit of SREG
+static sim_time irq_off_since;
+static int sleeping;
+static int waking;                      // Oscillator start-up after Power-down
+
+// ----- Calls scheduled by the tests ----- //
+typedef struct sim_call {
+  sim_time when;
+  void (*fn)(void *arg);
+  void *arg;
+  struct sim_call *next;
+} sim_call;
+
+static sim_call *calls;
+
+// ----- Firmware context ----- //
+static ucontext_t test_context, firmware_context;
+static int firmware_booted;
+static int in_firmware;
+static sim_time run_until;
+
+// ----- Local Function Prototypes ----- //
+static void set_i(int on);
+static void dispatch(void);
+static void wake(void);
+static void run_isr(int vector);
+static void firmware_entry(void);
+
+/*************************************************************
+ Function             : sim_time sim_now()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Cycles since reset.
+*************************************************************/
+sim_time sim_now() {
+  return sim_cycles;
+}
+
+/*************************************************************
+ Function             : void sim_advance_to(sim_time when)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Runs the simulation to when, event by event. While the CPU
+ sleeps it returns early when an interrupt wakes it up, also
+ one that is already pending (a key pressed by the test).
+*************************************************************/
+void sim_advance_to(sim_time when) {
+  int was_sleeping = sleeping;
+
+  for(;;) {
+    sim_time next = when, t;
+
+    // ----- A pin changed by the test between two runs ----- //
+    sim_pins_update();
+    dispatch();
+    if(was_sleeping && !sleeping) {
+      return;
+    }
+
+    if((t = sim_periph_next()) < next) {
+      next = t;
+    }
+    if((t = sim_spi_next()) < next) {
+      next = t;
+    }
+    if((t = ds1306_next()) < next) {
+      next = t;
+    }
+    if(calls && (calls->when < next)) {
+      next = calls->when;
+    }
+    if(sim_power_fail_at < next) {
+      next = sim_power_fail_at;
+    }
+    if(next > sim_cycles) {
+      sim_mode_cycles[sim_cpu_mode] += next - sim_cycles;
+      sim_cycles = next;
+    }
+
+    // ----- Events due now ----- //
+    sim_periph_update();
+    sim_spi_update();
+    ds1306_update();
+    if(sim_cycles >= sim_power_fail_at) {
+      sim_eeprom_power_fail();
+      fflush(stdout);
+      _exit(SIM_POWER_FAIL);
+    }
+    while(calls && (calls->when <= sim_cycles)) {
+      sim_call *call = calls;
+
+      calls = call->next;
+      call->fn(call->arg);
+      free(call);
+    }
+    sim_pins_update();
+    dispatch();
+
+    if((sim_cycles >= when) || (was_sleeping && !sleeping)) {
+      return;
+    }
+  }
+}
+
+/*************************************************************
+ Function             : void sim_tick(sim_time cycles)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The CPU runs for cycles. Stops the test if the firmware
+ keeps running long after the time given to sim_run().
+*************************************************************/
+void sim_tick(sim_time cycles) {
+  if(in_firmware && (sim_cycles > run_until + SIM_NO_SLEEP)) {
+    sim_fail("the firmware does not sleep");
+  }
+  sim_advance_to(sim_cycles + cycles);
+}
+
+/*************************************************************
+ Function             : int sim_clk_io()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ True if clk_IO runs (active and Idle mode).
+*************************************************************/
+int sim_clk_io() {
+  return (sim_cpu_mode == sim_active) || (sim_cpu_mode == sim_idle);
+}
+
+/*************************************************************
+ Function             : void sim_fail(const char *why)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Stops the test on a simulation error.
+*************************************************************/
+void sim_fail(const char *why) {
+  fprintf(stderr, "sim: %s at cycle %llu\n", why, sim_cycles);
+  exit(2);
+}
+
+/*************************************************************
+ Function             : int sim_irq_enabled()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ I bit of SREG.
+*************************************************************/
+int sim_irq_enabled() {
+  return sreg_i;
+}
+
+/*************************************************************
+ Function             : void sim_set_irq(int on)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the I bit from a test, without taking an interrupt
+ until the next access.
+*************************************************************/
+void sim_set_irq(int on) {
+  set_i(on);
+}
+
+/*************************************************************
+ Function             : void sim_run(sim_time cycles)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Runs the firmware until it sleeps at or after cycles from
+ now. The first call starts main() from reset.
+*************************************************************/
+void sim_run(sim_time cycles) {
+  if(in_firmware) {
+    sim_fail("sim_run() called by the firmware");
+  }
+  run_until = sim_cycles + cycles;
+  if(!firmware_booted) {
+    getcontext(&firmware_context);
+    firmware_context.uc_stack.ss_sp = malloc(SIM_STACK);
+    firmware_context.uc_stack.ss_size = SIM_STACK;
+    firmware_context.uc_link = 0;
+    makecontext(&firmware_context, firmware_entry, 0);
+    firmware_booted = 1;
+  }
+  in_firmware = 1;
+  swapcontext(&test_context, &firmware_context);
+  in_firmware = 0;
+}
+
+/*************************************************************
+ Function             : void sim_advance(sim_time cycles)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ For tests that call the firmware functions themselves:
+ runs the peripherals, devices and interrupts for cycles.
+*************************************************************/
+void sim_advance(sim_time cycles) {
+  if(in_firmware) {
+    sim_fail("sim_advance() called by the firmware");
+  }
+  sim_io_flush();
+  sim_advance_to(sim_cycles + cycles);
+}
+
+/*************************************************************
+ Function             : void sim_wake()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ For tests that call the firmware functions between two
+ sim_run() calls: ends the sleep of the firmware like a
+ wake-up source would, so the clocks of active mode run.
+ The main loop finds no event at the next sim_run().
+*************************************************************/
+void sim_wake() {
+  if(in_firmware) {
+    sim_fail("sim_wake() called by the firmware");
+  }
+  if(sleeping) {
+    wake();
+  }
+}
+
+/*************************************************************
+ Function             : void sim_at(sim_time when,
+                        void (*fn)(void *arg), void *arg)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Calls fn(arg) at the simulated time when (after the calls
+ already scheduled for that time).
+*************************************************************/
+void sim_at(sim_time when, void (*fn)(void *arg), void *arg) {
+  sim_call *call = malloc(sizeof(sim_call));
+  sim_call **p = &calls;
+
+  call->when = when;
+  call->fn = fn;
+  call->arg = arg;
+  while(*p && ((*p)->when <= when)) {
+    p = &(*p)->next;
+  }
+  call->next = *p;
+  *p = call;
+}
+
+/*************************************************************
+ Function             : int sim_fork(void (*child)(void *arg),
+                        void *arg)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Runs child(arg) from reset in a new process and returns
+ its exit status (SIM_POWER_FAIL at sim_power_fail_at).
+ The EEPROM and the DS1306 keep what the child wrote.
+*************************************************************/
+int sim_fork(void (*child)(void *arg), void *arg) {
+  pid_t pid;
+  int status;
+
+  fflush(stdout);
+  fflush(stderr);
+  pid = fork();
+  if(pid < 0) {
+    sim_fail("fork failed");
+  }
+  if(pid == 0) {
+    child(arg);
+    fflush(stdout);
+    _exit(0);
+  }
+  if((waitpid(pid, &status, 0) != pid) || !WIFEXITED(status)) {
+    return -1;
+  }
+  return WEXITSTATUS(status);
+}
+
+/*************************************************************
+ Function             : void *sim_shared(unsigned long size)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Zeroed memory shared with the sim_fork() children made
+ after this call.
+*************************************************************/
+void *sim_shared(unsigned long size) {
+  void *p = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+  if(p == MAP_FAILED) {
+    sim_fail("mmap failed");
+  }
+  return p;
+}
+
+/*************************************************************
+ Function             : void sim_shared_init()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Runs before main(): the EEPROM starts erased and the
+ DS1306 like a new chip.
+*************************************************************/
+__attribute__((constructor)) void sim_shared_init() {
+  sim_eeprom = sim_shared(SIM_EEPROM_SIZE);
+  sim_eeprom_writes = sim_shared(SIM_EEPROM_SIZE * sizeof(unsigned long));
+  memset(sim_eeprom, 0xFF, SIM_EEPROM_SIZE);
+  ds1306_shared_init();
+}
+
+// ----- IAR intrinsics ----- //
+
+/*************************************************************
+ Function             : void __delay_cycles(
+                        unsigned long cycles)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Busy wait, interrupts are taken.
+*************************************************************/
+void __delay_cycles(unsigned long cycles) {
+  sim_io_flush();
+  sim_delay_cycles += cycles;
+  sim_tick(cycles);
+}
+
+/*************************************************************
+ Function             : void __enable_interrupt()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ SEI. A pending interrupt is only taken at the next access,
+ so the SLEEP right after SEI is always reached.
+*************************************************************/
+void __enable_interrupt() {
+  sim_io_flush();
+  sim_tick(1);
+  set_i(1);
+}
+
+/*************************************************************
+ Function             : void __disable_interrupt()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ CLI.
+*************************************************************/
+void __disable_interrupt() {
+  sim_io_flush();
+  set_i(0);
+  sim_tick(1);
+}
+
+/*************************************************************
+ Function             : unsigned char __save_interrupt()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Reads SREG (only the I bit is kept).
+*************************************************************/
+unsigned char __save_interrupt() {
+  sim_io_flush();
+  sim_tick(1);
+  return sreg_i ? 0x80 : 0x00;
+}
+
+/*************************************************************
+ Function             : void __restore_interrupt(
+                        unsigned char sreg)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Writes SREG.
+*************************************************************/
+void __restore_interrupt(unsigned char sreg) {
+  sim_io_flush();
+  sim_tick(1);
+  set_i((sreg & 0x80) != 0);
+}
+
+/*************************************************************
+ Function             : void __sleep()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ SLEEP. With SE set, the CPU stays in the mode of SM2:0
+ until one of its wake-up sources is pending. Entering ADC
+ Noise Reduction starts a conversion.
+*************************************************************/
+void __sleep() {
+  static const sim_mode modes[8] = {
+    sim_idle, sim_adc_noise, sim_power_down, sim_power_down,
+    sim_power_down, sim_power_down, sim_power_down, sim_power_down
+  };
+  unsigned char mcucr;
+
+  sim_io_flush();
+  mcucr = sim_regs[sim_MCUCR];
+  if(!TESTBIT(mcucr, SE)) {
+    sim_tick(1);
+    return;
+  }
+  if(!in_firmware) {
+    sim_fail("__sleep() outside of sim_run()");
+  }
+
+  sim_periph_update();
+  sim_cpu_mode = modes[((mcucr >> SM2) & 0x01) << 2 | ((mcucr >> SM0) & 0x03)];
+  sim_mode_entries[sim_cpu_mode]++;
+  sleeping = 1;
+  if(sim_cpu_mode == sim_adc_noise) {
+    sim_adc_sleep_start();
+  }
+  while(sleeping) {
+    if(sim_cycles >= run_until) {
+      in_firmware = 0;
+      swapcontext(&firmware_context, &test_context);
+      in_firmware = 1;
+      continue;                         // The test may have called sim_wake()
+    }
+    sim_advance_to(run_until);
+  }
+}
+
+/*************************************************************
+ Function             : static void set_i(int on)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the I bit and keeps the longest time it was clear.
+*************************************************************/
+static void set_i(int on) {
+  if(sreg_i && !on) {
+    irq_off_since = sim_cycles;
+  } else if(!sreg_i && on && (sim_cycles - irq_off_since > sim_irq_off_max)) {
+    sim_irq_off_max = sim_cycles - irq_off_since;
+  }
+  sreg_i = on;
+}
+
+/*************************************************************
+ Function             : static void dispatch()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Wakes the CPU on a wake-up source of its sleep mode, and
+ takes the pending interrupts while the I bit is set.
+*************************************************************/
+static void dispatch() {
+  int vector;
+
+  if(sim_in_isr || waking || (!sreg_i && !sleeping)) {
+    return;
+  }
+  while((vector = sim_irq_pending(sleeping ? sim_cpu_mode : sim_active)) >= 0) {
+    if(sleeping) {
+      wake();
+    }
+    if(!sreg_i) {
+      return;
+    }
+    run_isr(vector);
+  }
+}
+
+/*************************************************************
+ Function             : static void wake()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Back to active mode, after the oscillator start-up if the
+ CPU was in Power-down.
+*************************************************************/
+static void wake() {
+  if(sim_cpu_mode == sim_power_down) {
+    waking = 1;
+    sim_advance_to(sim_cycles + sim_wakeup_cycles);
+    waking = 0;
+  }
+  sim_periph_update();
+  sim_cpu_mode = sim_active;
+  sleeping = 0;
+}
+
+/*************************************************************
+ Function             : static void run_isr(int vector)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Takes an interrupt: clears its flag and the I bit, runs
+ the handler, and returns with RETI.
+*************************************************************/
+static void run_isr(int vector) {
+  sim_time start = sim_cycles, time;
+
+  if(!sim_vectors[vector]) {
+    sim_fail("interrupt without a handler");
+  }
+  sim_irq_taken(vector);
+  set_i(0);
+  sim_in_isr = 1;
+  sim_tick(4);
+  sim_vectors[vector]();
+  sim_io_flush();
+  sim_tick(4);
+  sim_in_isr = 0;
+  set_i(1);
+
+  time = sim_cycles - start;
+  sim_isr_count[vector]++;
+  sim_isr_cycles[vector] += time;
+  if(time > sim_isr_max[vector]) {
+    sim_isr_max[vector] = time;
+  }
+}
+
+/*************************************************************
+ Function             : static void firmware_entry()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Start of the firmware context.
+*************************************************************/
+static void firmware_entry() {
+  firmware_main();
+  sim_fail("main() returned");
+}
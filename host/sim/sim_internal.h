@@ -0,0 +1,88 @@
+/****************************************************************
+  File Name            : "sim_internal.h"
+  Title                : Simulator Internals
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Shared between the simulator modules only. sim.h must be
+  included first.
+   sim_core.c    time, interrupts, sleep, firmware context
+   sim_io.c      registers, ports, pins, external interrupts
+   sim_periph.c  timers, ADC, EEPROM, USART0
+   sim_spi.c     SPI master and chip selects
+   *_model.c     devices on the board
+****************************************************************/
+
+#ifndef SIM_INTERNAL_H
+#define SIM_INTERNAL_H
+
+#include <iom128.h>
+#include <avr_macros.h>
+
+// ----- sim_core.c ----- //
+extern sim_time sim_cycles;                 // Present time
+extern sim_mode sim_cpu_mode;
+extern int sim_in_isr;
+
+extern void sim_tick(sim_time cycles);      // CPU busy for cycles, interrupts are taken
+extern void sim_advance_to(sim_time when);
+extern int sim_clk_io(void);                // clk_IO runs in the present mode
+extern void sim_fail(const char *why);
+extern void (*const sim_vectors[SIM_VECTORS])(void);    // sim_vectors.c
+
+// ----- sim_io.c ----- //
+extern volatile unsigned char sim_regs[sim_io_count];
+extern volatile unsigned int sim_regs16[sim_io16_count];
+extern unsigned char sim_eifr;              // External interrupt flags
+extern unsigned char sim_tifr;              // Timer interrupt flags
+
+extern void sim_io_flush(void);             // Ends the pending register access
+extern void sim_ports_sync(void);
+extern void sim_pins_update(void);          // Edges on INT0-INT3
+extern int sim_irq_pending(sim_mode mode);  // Vector to take, -1 if none
+extern void sim_irq_taken(int vector);
+
+// ----- sim_periph.c ----- //
+extern unsigned char sim_usart_flags;       // UDRE0 and TXC0
+extern int sim_ee_busy;
+
+extern sim_time sim_periph_next(void);
+extern void sim_periph_update(void);        // Brings the peripherals to sim_cycles
+extern void sim_periph_write(sim_io_reg reg, unsigned char before, unsigned char value);
+extern void sim_periph_write16(sim_io16_reg reg, unsigned int before, unsigned int value);
+extern void sim_periph_read(sim_io_reg reg, int again);
+extern void sim_periph_read16(sim_io16_reg reg);
+extern void sim_adc_sleep_start(void);      // Entering ADC Noise Reduction mode
+extern void sim_eeprom_power_fail(void);
+
+// ----- sim_spi.c ----- //
+extern sim_time sim_spi_next(void);
+extern void sim_spi_update(void);
+extern void sim_spi_start(unsigned char out);
+extern void sim_spi_cs_sync(void);
+extern int sim_spi_busy_now(void);
+
+// ----- Devices ----- //
+extern unsigned char ds1306_transfer(unsigned char out, unsigned char mode, unsigned long sclk);
+extern void ds1306_ce(int high);
+extern sim_time ds1306_next(void);
+extern void ds1306_update(void);
+extern int ds1306_pin_1hz(void);
+extern int ds1306_pin_int0(void);           // Active low, open drain
+extern int ds1306_pin_1int(void);           // Active high
+
+extern unsigned char humidicon_model_transfer(unsigned char n, unsigned char out,
+                                              unsigned char mode, unsigned long sclk);
+extern void humidicon_model_cs(unsigned char n, int low);
+
+extern void dog163_transfer(unsigned char out, int rs, unsigned char mode, unsigned long sclk);
+extern void dog163_cs(int low);
+
+extern unsigned char keypad_model_pinc(unsigned char ddrc, unsigned char portc);
+
+extern void sim_shared_init(void);          // Persistent device state
+extern void ds1306_shared_init(void);
+
+#endif
@@ -0,0 +1,418 @@
+/****************************************************************
+  File Name            : "sim_io.c"
+  Title                : Simulated Registers and Pins
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Backs the registers of host/include/iom128.h. sim_io() hands
+  out the address of a register, so a write can only be seen
+  at the next register access (or intrinsic): the access is
+  kept pending and is a write if the value changed. The
+  registers whose writes cannot be told by their value use
+  their own rule:
+   SPDR     a write is always followed by the SPIF poll of SPSR
+   UDR0     only written by the firmware
+   TIFR     kept at 0, the bits written as 1 clear their flag
+   EIFR     same as TIFR
+   UCSR0A   only holds U2X0, writing TXC0 clears the flag
+   SPSR     SPIF is cleared by reading SPSR with SPIF set,
+            then accessing SPDR
+  Each access costs 1 cycle (2 for the 16-bit registers), and
+  PINx and TCNTx are computed when they are accessed.
+****************************************************************/
+
+#include "sim.h"
+#include "sim_internal.h"
+
+// ----- Register storage ----- //
+volatile unsigned char sim_regs[sim_io_count];
+volatile unsigned int sim_regs16[sim_io16_count];
+volatile unsigned char PORTA, PORTB, PORTC, PORTD, PORTE, PORTF, PORTG;
+volatile unsigned char DDRA, DDRB, DDRC, DDRD, DDRE, DDRF, DDRG;
+unsigned char sim_eifr;
+unsigned char sim_tifr;
+
+// ----- Pending access ----- //
+typedef enum {pend_none, pend_8, pend_16} pend_kind;
+
+static pend_kind pending = pend_none;
+static int pending_reg;
+static unsigned int pending_value;
+static int last_reg = -1;               // Last 8-bit register accessed
+static int spif_read;                   // SPSR read with SPIF set
+
+// ----- Pins ----- //
+static volatile unsigned char *const port_regs[14] = {
+  &PORTA, &PORTB, &PORTC, &PORTD, &PORTE, &PORTF, &PORTG,
+  &DDRA, &DDRB, &DDRC, &DDRD, &DDRE, &DDRF, &DDRG
+};
+static unsigned char port_shadow[14];
+static unsigned char int_levels = 0x0F; // INT3:0 pin levels
+
+// ----- Local Function Prototypes ----- //
+static void resolve(int next);
+static void prepare(sim_io_reg reg);
+static unsigned char pin_read(sim_io_reg reg);
+static unsigned char pind_inputs(void);
+
+/*************************************************************
+ Function             : volatile unsigned char *sim_io(
+                        sim_io_reg reg)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Ends the pending access, runs the simulation for the cycle
+ of this one, and returns the register with its present
+ value.
+*************************************************************/
+volatile unsigned char *sim_io(sim_io_reg reg) {
+  sim_ports_sync();
+  resolve(reg);
+  sim_tick(1);
+  prepare(reg);
+  last_reg = reg;
+  pending = pend_8;
+  pending_reg = reg;
+  pending_value = sim_regs[reg];
+  return &sim_regs[reg];
+}
+
+/*************************************************************
+ Function             : volatile unsigned int *sim_io16(
+                        sim_io16_reg reg)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Same as sim_io() for a 16-bit register (two accesses
+ through the TEMP register on the target).
+*************************************************************/
+volatile unsigned int *sim_io16(sim_io16_reg reg) {
+  sim_ports_sync();
+  resolve(-1);
+  sim_tick(2);
+  sim_periph_read16(reg);
+  last_reg = -1;
+  pending = pend_16;
+  pending_reg = reg;
+  pending_value = sim_regs16[reg];
+  return &sim_regs16[reg];
+}
+
+/*************************************************************
+ Function             : void sim_io_flush()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Ends the pending access before an intrinsic or at the end
+ of an interrupt, and takes the port changes made since.
+*************************************************************/
+void sim_io_flush() {
+  sim_ports_sync();
+  resolve(-1);
+  last_reg = -1;
+}
+
+/*************************************************************
+ Function             : static void resolve(int next)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Decides whether the pending access was a write and hands
+ it to the peripheral. next is the register accessed now
+ (-1 for a 16-bit register or an intrinsic).
+*************************************************************/
+static void resolve(int next) {
+  pend_kind kind = pending;
+  unsigned int before = pending_value;
+
+  pending = pend_none;
+  if(kind == pend_16) {
+    if(sim_regs16[pending_reg] != before) {
+      sim_periph_write16((sim_io16_reg)pending_reg, before, sim_regs16[pending_reg]);
+    }
+    return;
+  }
+  if(kind != pend_8) {
+    return;
+  }
+
+  switch(pending_reg) {
+    case sim_SPDR:
+      if(next == sim_SPSR) {
+        sim_spi_start(sim_regs[sim_SPDR]);
+      }
+      break;
+    case sim_SPSR:
+      // ----- Only SPI2X can be written ----- //
+      sim_regs[sim_SPSR] = (before & (1 << SPIF)) | (sim_regs[sim_SPSR] & (1 << SPI2X));
+      break;
+    case sim_UDR0:
+      sim_periph_write(sim_UDR0, before, sim_regs[sim_UDR0]);
+      break;
+    case sim_TIFR:
+      sim_tifr &= ~sim_regs[sim_TIFR];
+      sim_regs[sim_TIFR] = 0;
+      break;
+    case sim_EIFR:
+      sim_eifr &= ~sim_regs[sim_EIFR];
+      sim_regs[sim_EIFR] = 0;
+      break;
+    default:
+      if(sim_regs[pending_reg] != before) {
+        sim_periph_write((sim_io_reg)pending_reg, before, sim_regs[pending_reg]);
+      }
+      break;
+  }
+}
+
+/*************************************************************
+ Function             : static void prepare(sim_io_reg reg)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Puts the present value in the register before it is
+ handed out. Polling SPSR during a transfer skips to its
+ end.
+*************************************************************/
+static void prepare(sim_io_reg reg) {
+  switch(reg) {
+    case sim_SPSR:
+      while(sim_spi_busy_now()) {
+        sim_advance_to(sim_spi_next());
+      }
+      spif_read = TESTBIT(sim_regs[sim_SPSR], SPIF) != 0;
+      break;
+    case sim_SPDR:
+      if(spif_read) {
+        CLEARBIT(sim_regs[sim_SPSR], SPIF);
+        spif_read = 0;
+      }
+      break;
+    case sim_PINA: case sim_PINB: case sim_PINC: case sim_PIND:
+    case sim_PINE: case sim_PINF: case sim_PING:
+      sim_regs[reg] = pin_read(reg);
+      break;
+    default:
+      sim_periph_read(reg, last_reg == (int)reg);
+      break;
+  }
+}
+
+/*************************************************************
+ Function             : void sim_ports_sync()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The PORTx and DDRx registers are plain variables. Their
+ changes are taken here: chip selects, and the keypad
+ lines that drive INT0.
+*************************************************************/
+void sim_ports_sync() {
+  int changed = 0;
+
+  for(int i = 0; i < 14; i++) {
+    if(*port_regs[i] != port_shadow[i]) {
+      port_shadow[i] = *port_regs[i];
+      changed = 1;
+    }
+  }
+  if(changed) {
+    sim_spi_cs_sync();
+    sim_pins_update();
+  }
+}
+
+/*************************************************************
+ Function             : void sim_pins_update()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the flag of INT0-INT3 on the edge selected in EICRA.
+ Flags are set even while the interrupt is masked. The
+ low level sense has no flag (sim_irq_pending).
+*************************************************************/
+void sim_pins_update() {
+  unsigned char levels = pind_inputs() & 0x0F;
+  unsigned char changed = levels ^ int_levels;
+
+  for(int n = 0; n < 4; n++) {
+    unsigned char sense = (sim_regs[sim_EICRA] >> (2 * n)) & 0x03;
+    unsigned char bit = 1 << n;
+
+    if(!(changed & bit)) {
+      continue;
+    }
+    if((sense == 1) ||
+       ((sense == 2) && !(levels & bit)) ||
+       ((sense == 3) && (levels & bit))) {
+      sim_eifr |= bit;
+    }
+  }
+  int_levels = levels;
+}
+
+/*************************************************************
+ Function             : int sim_irq_pending(sim_mode mode)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the vector of the highest priority interrupt that
+ is enabled and pending, among the wake-up sources of mode
+ (all of them for active and Idle), or -1.
+*************************************************************/
+int sim_irq_pending(sim_mode mode) {
+  unsigned char timsk = sim_regs[sim_TIMSK];
+  unsigned char ucsr0b = sim_regs[sim_UCSR0B];
+  unsigned char adcsra = sim_regs[sim_ADCSRA];
+
+  // ----- INT0-INT3 (every mode) ----- //
+  for(int n = 0; n < 4; n++) {
+    unsigned char sense = (sim_regs[sim_EICRA] >> (2 * n)) & 0x03;
+
+    if(!TESTBIT(sim_regs[sim_EIMSK], n)) {
+      continue;
+    }
+    if((sense == 0) ? !TESTBIT(int_levels, n) : TESTBIT(sim_eifr, n)) {
+      return INT0_vect + n;
+    }
+  }
+  if(mode == sim_power_down) {
+    return -1;
+  }
+
+  // ----- clk_IO sources (stopped in ADC Noise Reduction) ----- //
+  if(mode != sim_adc_noise) {
+    if(TESTBIT(timsk, OCIE2) && TESTBIT(sim_tifr, OCF2)) {
+      return TIMER2_COMP_vect;
+    }
+    if(TESTBIT(timsk, OCIE1A) && TESTBIT(sim_tifr, OCF1A)) {
+      return TIMER1_COMPA_vect;
+    }
+    if(TESTBIT(timsk, OCIE0) && TESTBIT(sim_tifr, OCF0)) {
+      return TIMER0_COMP_vect;
+    }
+    if(TESTBIT(ucsr0b, UDRIE0) && TESTBIT(sim_usart_flags, UDRE0)) {
+      return USART0_UDRE_vect;
+    }
+    if(TESTBIT(ucsr0b, TXCIE0) && TESTBIT(sim_usart_flags, TXC0)) {
+      return USART0_TXC_vect;
+    }
+  }
+  if(TESTBIT(adcsra, ADIE) && TESTBIT(adcsra, ADIF)) {
+    return ADC_vect;
+  }
+  if(TESTBIT(sim_regs[sim_EECR], EERIE) && !sim_ee_busy) {
+    return EE_READY_vect;
+  }
+  return -1;
+}
+
+/*************************************************************
+ Function             : void sim_irq_taken(int vector)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Clears the flag the hardware clears when the interrupt
+ is taken. UDRE0, EE_READY and the low levels stay until
+ their cause is gone.
+*************************************************************/
+void sim_irq_taken(int vector) {
+  switch(vector) {
+    case INT0_vect: case INT1_vect: case INT2_vect: case INT3_vect:
+      CLEARBIT(sim_eifr, vector - INT0_vect);
+      break;
+    case TIMER2_COMP_vect:
+      CLEARBIT(sim_tifr, OCF2);
+      break;
+    case TIMER1_COMPA_vect:
+      CLEARBIT(sim_tifr, OCF1A);
+      break;
+    case TIMER0_COMP_vect:
+      CLEARBIT(sim_tifr, OCF0);
+      break;
+    case USART0_TXC_vect:
+      CLEARBIT(sim_usart_flags, TXC0);
+      break;
+    case ADC_vect:
+      CLEARBIT(sim_regs[sim_ADCSRA], ADIF);
+      break;
+  }
+}
+
+/*************************************************************
+ Function             : static unsigned char pin_read(
+                        sim_io_reg reg)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Level of the pins of a port: outputs read back PORTx, the
+ inputs the board. Unconnected inputs read 1.
+*************************************************************/
+static unsigned char pin_read(sim_io_reg reg) {
+  int n = reg - sim_PINA;
+  unsigned char ddr = *port_regs[7 + n];
+  unsigned char outputs = *port_regs[n] & ddr;
+
+  switch(reg) {
+    case sim_PINC:
+      return keypad_model_pinc(DDRC, PORTC);
+    case sim_PIND:
+      return outputs | (pind_inputs() & ~ddr);
+    default:
+      return outputs | ~ddr;
+  }
+}
+
+/*************************************************************
+ Function             : static unsigned char pind_inputs()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Levels driven on PORTD by the board:
+  PD0  INT0   low while a key connects a driven column
+              to a row (AND of the rows)
+  PD1  INT1   DS1306 1Hz output
+  PD2  INT2   DS1306 /INT0, open drain with the pull-up
+  PD3  INT3   DS1306 1INT
+*************************************************************/
+static unsigned char pind_inputs() {
+  unsigned char levels = 0xF0;
+
+  if((keypad_model_pinc(DDRC, PORTC) & 0x0F) == 0x0F) {
+    levels |= 0x01;
+  }
+  if(ds1306_pin_1hz()) {
+    levels |= 0x02;
+  }
+  if(!ds1306_pin_int0()) {
+    levels |= 0x04;
+  }
+  if(ds1306_pin_1int()) {
+    levels |= 0x08;
+  }
+  return levels;
+}
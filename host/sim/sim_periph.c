@@ -0,0 +1,577 @@
+/****************************************************************
+  File Name            : "sim_periph.c"
+  Title                : Simulated Timers, ADC, EEPROM and USART0
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  The on-chip peripherals used by the firmware. sim_core.c
+  brings them up to the present time (sim_periph_update) and
+  asks for the time of their next event (sim_periph_next).
+  Timer0-3 use clk_IO, so they stop with the USART in ADC
+  Noise Reduction and Power-down. The ADC stops in Power-down,
+  and an EEPROM write runs in every mode.
+   Timer0/1/2   CTC on OCR0/OCR1A/OCR2, the flag is set when the
+                count goes from TOP to 0
+   Timer3       normal mode, 32 bits on the host (iom128.h)
+   ADC          13 ADC clocks, 25 for the first after ADEN
+   EEPROM       8.5ms per byte, EEWE within 4 cycles of EEMWE
+   USART0       transmitter only, UDR0 buffer + shift register
+****************************************************************/
+
+#include <unistd.h>
+#include "sim.h"
+#include "sim_internal.h"
+
+// ----- Timers ----- //
+typedef struct {
+  unsigned long count;
+  sim_time rest;                        // Cycles since the last timer clock
+} sim_timer;
+
+static sim_timer timers[4];
+static sim_time periph_time;            // Time the peripherals were updated to
+
+static const unsigned int prescale0[8] = {0, 1, 8, 32, 64, 128, 256, 1024};
+static const unsigned int prescale1[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+
+// ----- ADC ----- //
+unsigned int (*sim_adc_input)(unsigned char mux);
+unsigned long sim_adc_conversions;
+unsigned long sim_adc_noisy;
+static sim_time adc_done = SIM_NEVER;
+static int adc_first;                   // Next conversion is the first after ADEN
+
+// ----- EEPROM ----- //
+unsigned char *sim_eeprom;
+unsigned long *sim_eeprom_writes;
+int sim_ee_busy;
+static sim_time ee_done = SIM_NEVER;
+static sim_time eemwe_at;
+static unsigned int ee_addr;
+static unsigned char ee_data;
+
+// ----- USART0 ----- //
+void (*sim_usart_tx)(unsigned char data);
+int sim_usart_fd = -1;
+unsigned long sim_usart_bytes;
+unsigned char sim_usart_flags = (1 << UDRE0);
+static sim_time tx_done = SIM_NEVER;
+static unsigned char tx_shift;
+static unsigned char tx_buffer;
+static int tx_full;
+
+// ----- Local Function Prototypes ----- //
+static unsigned int timer_prescale(int t);
+static int timer_ctc(int t, unsigned long *top, unsigned char *flag);
+static unsigned long timer_width(int t);
+static void timer_count(int t, unsigned long ticks);
+static sim_time timer_next(int t);
+static void adc_start(void);
+static void usart_sent(void);
+static sim_time usart_frame(void);
+
+/*************************************************************
+ Function             : sim_time sim_periph_next()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Time of the next compare match, conversion, EEPROM write,
+ or transmitted byte. SIM_NEVER if nothing is running.
+*************************************************************/
+sim_time sim_periph_next() {
+  sim_time next = ee_done;
+
+  if(sim_clk_io()) {
+    for(int t = 0; t < 3; t++) {
+      sim_time match = timer_next(t);
+
+      if(match < next) {
+        next = match;
+      }
+    }
+    if(tx_done < next) {
+      next = tx_done;
+    }
+  }
+  if((sim_cpu_mode != sim_power_down) && (adc_done < next)) {
+    next = adc_done;
+  }
+  return next;
+}
+
+/*************************************************************
+ Function             : void sim_periph_update()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Counts the timer clocks since the last update, and ends
+ the conversion, write, and byte that are due. What runs
+ on a stopped clock is pushed back by the time asleep.
+*************************************************************/
+void sim_periph_update() {
+  sim_time dt = sim_cycles - periph_time;
+
+  periph_time = sim_cycles;
+  if(dt != 0) {
+    if(sim_clk_io()) {
+      for(int t = 0; t < 4; t++) {
+        unsigned int prescale = timer_prescale(t);
+
+        if(prescale != 0) {
+          sim_time total = timers[t].rest + dt;
+
+          timers[t].rest = total % prescale;
+          timer_count(t, (unsigned long)(total / prescale));
+        }
+      }
+    } else if(tx_done != SIM_NEVER) {
+      tx_done += dt;
+    }
+    if((sim_cpu_mode == sim_power_down) && (adc_done != SIM_NEVER)) {
+      adc_done += dt;
+    }
+  }
+
+  // ----- ADC conversion complete ----- //
+  if(sim_cycles >= adc_done) {
+    adc_done = SIM_NEVER;
+    sim_regs16[sim_ADC] = (sim_adc_input ? sim_adc_input(sim_regs[sim_ADMUX] & 0x1F) : 0) & 0x3FF;
+    CLEARBIT(sim_regs[sim_ADCSRA], ADSC);
+    SETBIT(sim_regs[sim_ADCSRA], ADIF);
+    sim_adc_conversions++;
+    if(sim_cpu_mode == sim_active) {
+      sim_adc_noisy++;
+    }
+  }
+
+  // ----- EEPROM write complete ----- //
+  if(sim_cycles >= ee_done) {
+    ee_done = SIM_NEVER;
+    sim_eeprom[ee_addr] = ee_data;
+    sim_eeprom_writes[ee_addr]++;
+    sim_ee_busy = 0;
+    CLEARBIT(sim_regs[sim_EECR], EEWE);
+  }
+
+  // ----- Stop bit sent ----- //
+  while(sim_cycles >= tx_done) {
+    usart_sent();
+  }
+}
+
+/*************************************************************
+ Function             : void sim_periph_write(sim_io_reg reg,
+                        unsigned char before,
+                        unsigned char value)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ A register was written with value (was before). The
+ register keeps the bits that can be written; the status
+ bits are the peripheral's.
+*************************************************************/
+void sim_periph_write(sim_io_reg reg, unsigned char before, unsigned char value) {
+  switch(reg) {
+    case sim_TCNT0:
+      timers[0].count = value;
+      break;
+    case sim_TCNT2:
+      timers[2].count = value;
+      break;
+    case sim_TCCR0:
+    case sim_TCCR2:
+    case sim_TCCR1B:
+    case sim_TCCR3B: {
+      int t = (reg == sim_TCCR0) ? 0 : (reg == sim_TCCR1B) ? 1 : (reg == sim_TCCR2) ? 2 : 3;
+
+      if(timer_prescale(t) == 0) {
+        timers[t].rest = 0;
+      }
+      break;
+    }
+
+    // ----- ADC ----- //
+    case sim_ADCSRA: {
+      int adif = TESTBIT(before, ADIF) && !TESTBIT(value, ADIF);    // Written as 1 clears it
+
+      if(!TESTBIT(value, ADEN)) {
+        adc_done = SIM_NEVER;
+      } else {
+        if(!TESTBIT(before, ADEN)) {
+          adc_first = 1;
+        }
+        if(TESTBIT(value, ADSC) && (adc_done == SIM_NEVER)) {
+          sim_regs[sim_ADCSRA] = value;
+          adc_start();
+        }
+      }
+      sim_regs[sim_ADCSRA] = (value & ~((1 << ADIF) | (1 << ADSC))) |
+                             (adif << ADIF) | ((adc_done != SIM_NEVER) << ADSC);
+      break;
+    }
+
+    // ----- EEPROM ----- //
+    case sim_EECR:
+      if(TESTBIT(value, EEMWE) && !TESTBIT(before, EEMWE)) {
+        eemwe_at = sim_cycles;
+      }
+      if(TESTBIT(value, EEWE) && !TESTBIT(before, EEWE) && TESTBIT(value, EEMWE) &&
+         (sim_cycles - eemwe_at <= 4) && !sim_ee_busy) {
+        ee_addr = sim_regs16[sim_EEAR] & (SIM_EEPROM_SIZE - 1);
+        ee_data = sim_regs[sim_EEDR];
+        ee_done = sim_cycles + SIM_EEPROM_WRITE;
+        sim_ee_busy = 1;
+        CLEARBIT(value, EEMWE);
+      }
+      if(TESTBIT(value, EERE) && !sim_ee_busy) {
+        sim_regs[sim_EEDR] = sim_eeprom[sim_regs16[sim_EEAR] & (SIM_EEPROM_SIZE - 1)];
+      }
+      sim_regs[sim_EECR] = (value & ((1 << EERIE) | (1 << EEMWE))) | (sim_ee_busy << EEWE);
+      break;
+
+    // ----- USART0 ----- //
+    case sim_UCSR0A:
+      if(TESTBIT(value, TXC0)) {
+        CLEARBIT(sim_usart_flags, TXC0);
+      }
+      sim_regs[sim_UCSR0A] = value & ((1 << U2X0) | (1 << MPCM0));
+      break;
+    case sim_UDR0:
+      if(!TESTBIT(sim_regs[sim_UCSR0B], TXEN0)) {
+        break;
+      }
+      if(tx_done == SIM_NEVER) {
+        tx_shift = value;
+        tx_done = sim_cycles + usart_frame();
+      } else if(!tx_full) {
+        tx_buffer = value;
+        tx_full = 1;
+        CLEARBIT(sim_usart_flags, UDRE0);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*************************************************************
+ Function             : void sim_periph_write16(
+                        sim_io16_reg reg, unsigned int before,
+                        unsigned int value)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ A 16-bit register was written. OCR1A and EEAR are read
+ where they are used.
+*************************************************************/
+void sim_periph_write16(sim_io16_reg reg, unsigned int before, unsigned int value) {
+  (void)before;
+  if(reg == sim_TCNT1) {
+    timers[1].count = value & 0xFFFF;
+  } else if(reg == sim_TCNT3) {
+    timers[3].count = value;
+  }
+}
+
+/*************************************************************
+ Function             : void sim_periph_read(sim_io_reg reg,
+                        int again)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Present value of a register about to be accessed. again
+ is set when the last access was to the same register: a
+ loop polling EEWE skips to the end of the write.
+*************************************************************/
+void sim_periph_read(sim_io_reg reg, int again) {
+  switch(reg) {
+    case sim_TCNT0:
+      sim_regs[sim_TCNT0] = (unsigned char)timers[0].count;
+      break;
+    case sim_TCNT2:
+      sim_regs[sim_TCNT2] = (unsigned char)timers[2].count;
+      break;
+    case sim_EECR:
+      if(again) {
+        while(sim_ee_busy) {
+          sim_advance_to(ee_done);
+        }
+      }
+      if(TESTBIT(sim_regs[sim_EECR], EEMWE) && (sim_cycles - eemwe_at > 4)) {
+        CLEARBIT(sim_regs[sim_EECR], EEMWE);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*************************************************************
+ Function             : void sim_periph_read16(
+                        sim_io16_reg reg)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Present value of a 16-bit register about to be accessed.
+*************************************************************/
+void sim_periph_read16(sim_io16_reg reg) {
+  if(reg == sim_TCNT1) {
+    sim_regs16[sim_TCNT1] = (unsigned int)timers[1].count;
+  } else if(reg == sim_TCNT3) {
+    sim_regs16[sim_TCNT3] = (unsigned int)timers[3].count;
+  }
+}
+
+/*************************************************************
+ Function             : void sim_adc_sleep_start()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Entering ADC Noise Reduction mode starts a conversion if
+ the ADC is enabled and idle.
+*************************************************************/
+void sim_adc_sleep_start() {
+  if(TESTBIT(sim_regs[sim_ADCSRA], ADEN) && (adc_done == SIM_NEVER)) {
+    adc_start();
+  }
+}
+
+/*************************************************************
+ Function             : void sim_eeprom_power_fail()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Power is lost: a byte being written is left erased.
+*************************************************************/
+void sim_eeprom_power_fail() {
+  if(sim_ee_busy) {
+    sim_eeprom[ee_addr] = 0xFF;
+    sim_eeprom_writes[ee_addr]++;
+  }
+}
+
+/*************************************************************
+ Function             : static unsigned int timer_prescale(
+                        int t)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ CPU cycles per count of timer t, 0 if it is stopped.
+ Timer0 has its own prescaler.
+*************************************************************/
+static unsigned int timer_prescale(int t) {
+  switch(t) {
+    case 0:
+      return prescale0[sim_regs[sim_TCCR0] & 0x07];
+    case 1:
+      return prescale1[sim_regs[sim_TCCR1B] & 0x07];
+    case 2:
+      return prescale1[sim_regs[sim_TCCR2] & 0x07];
+    default:
+      return prescale1[sim_regs[sim_TCCR3B] & 0x07];
+  }
+}
+
+/*************************************************************
+ Function             : static int timer_ctc(int t,
+                        unsigned long *top,
+                        unsigned char *flag)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ True if timer t is in CTC mode, with its TOP and the bit
+ of its compare flag in TIFR.
+*************************************************************/
+static int timer_ctc(int t, unsigned long *top, unsigned char *flag) {
+  switch(t) {
+    case 0:
+      *top = sim_regs[sim_OCR0];
+      *flag = OCF0;
+      return TESTBIT(sim_regs[sim_TCCR0], WGM01) && !TESTBIT(sim_regs[sim_TCCR0], WGM00);
+    case 1:
+      *top = sim_regs16[sim_OCR1A] & 0xFFFF;
+      *flag = OCF1A;
+      return TESTBIT(sim_regs[sim_TCCR1B], WGM12) && !TESTBIT(sim_regs[sim_TCCR1B], WGM13) &&
+             ((sim_regs[sim_TCCR1A] & 0x03) == 0);
+    case 2:
+      *top = sim_regs[sim_OCR2];
+      *flag = OCF2;
+      return TESTBIT(sim_regs[sim_TCCR2], WGM21) && !TESTBIT(sim_regs[sim_TCCR2], WGM20);
+    default:
+      return 0;
+  }
+}
+
+/*************************************************************
+ Function             : static unsigned long timer_width(
+                        int t)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Largest count of timer t.
+*************************************************************/
+static unsigned long timer_width(int t) {
+  switch(t) {
+    case 1:
+      return 0xFFFF;
+    case 3:
+      return 0xFFFFFFFF;
+    default:
+      return 0xFF;
+  }
+}
+
+/*************************************************************
+ Function             : static void timer_count(int t,
+                        unsigned long ticks)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Advances timer t by ticks counts. A count above TOP in
+ CTC mode runs to the end of the range without a match.
+*************************************************************/
+static void timer_count(int t, unsigned long ticks) {
+  unsigned long width = timer_width(t);
+  unsigned long top, count = timers[t].count;
+  unsigned char flag;
+
+  if(!timer_ctc(t, &top, &flag)) {
+    timers[t].count = (count + ticks) & width;
+    return;
+  }
+  if(count > top) {
+    if(ticks < width - count + 1) {
+      timers[t].count = count + ticks;
+      return;
+    }
+    ticks -= width - count + 1;
+    count = 0;
+  }
+  if(ticks >= top - count + 1) {
+    SETBIT(sim_tifr, flag);
+    ticks -= top - count + 1;
+    count = ticks % (top + 1);
+  } else {
+    count += ticks;
+  }
+  timers[t].count = count;
+}
+
+/*************************************************************
+ Function             : static sim_time timer_next(int t)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Time of the next compare match of timer t.
+*************************************************************/
+static sim_time timer_next(int t) {
+  unsigned int prescale = timer_prescale(t);
+  unsigned long top, count = timers[t].count, ticks;
+  unsigned char flag;
+
+  if((prescale == 0) || !timer_ctc(t, &top, &flag)) {
+    return SIM_NEVER;
+  }
+  ticks = top - count + 1;
+  if(count > top) {
+    ticks = timer_width(t) - count + 1 + top + 1;
+  }
+  return sim_cycles + (sim_time)ticks * prescale - timers[t].rest;
+}
+
+/*************************************************************
+ Function             : static void adc_start()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Starts a conversion with the prescaler in ADCSRA.
+*************************************************************/
+static void adc_start() {
+  unsigned int prescale = 1 << (sim_regs[sim_ADCSRA] & 0x07);
+
+  if(prescale == 1) {
+    prescale = 2;
+  }
+  adc_done = sim_cycles + (sim_time)(adc_first ? 25 : 13) * prescale;
+  adc_first = 0;
+  SETBIT(sim_regs[sim_ADCSRA], ADSC);
+}
+
+/*************************************************************
+ Function             : static void usart_sent()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The byte in the shift register is out. The buffered byte
+ is moved in, or TXC0 is set.
+*************************************************************/
+static void usart_sent() {
+  sim_usart_bytes++;
+  if(sim_usart_tx) {
+    sim_usart_tx(tx_shift);
+  }
+  if(sim_usart_fd >= 0) {
+    if(write(sim_usart_fd, &tx_shift, 1) != 1) {
+      sim_usart_fd = -1;
+    }
+  }
+  if(tx_full) {
+    tx_shift = tx_buffer;
+    tx_full = 0;
+    SETBIT(sim_usart_flags, UDRE0);
+    tx_done += usart_frame();
+  } else {
+    tx_done = SIM_NEVER;
+    SETBIT(sim_usart_flags, TXC0);
+  }
+}
+
+/*************************************************************
+ Function             : static sim_time usart_frame()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Cycles per frame: start bit, 8 data bits, 1 or 2 stop
+ bits, (UBRR + 1) x 16 cycles per bit (x 8 with U2X).
+*************************************************************/
+static sim_time usart_frame() {
+  unsigned int ubrr = ((sim_regs[sim_UBRR0H] & 0x0F) << 8) | sim_regs[sim_UBRR0L];
+  unsigned int bit = (ubrr + 1) * (TESTBIT(sim_regs[sim_UCSR0A], U2X0) ? 8 : 16);
+  unsigned int bits = TESTBIT(sim_regs[sim_UCSR0C], USBS0) ? 11 : 10;
+
+  return (sim_time)bit * bits;
+}
@@ -0,0 +1,47 @@
+/****************************************************************
+  File Name            : "sim_printf.c"
+  Title                : printf to the LCD Buffers
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  printf of the firmware sources (host/include/stdio.h). The
+  text is formatted by the C library, then written through the
+  putchar of lcd_ext_modified.c, like the IAR printf does.
+****************************************************************/
+
+#include <stdarg.h>
+
+#define SIM_PRINTF_SIZE     128
+
+// Declared here: the glibc stdio.h may inline its own putchar
+extern int vsnprintf(char *text, unsigned long size, const char *format, va_list args);
+extern int putchar(int c);              // lcd_ext_modified.c
+
+/*************************************************************
+ Function             : int sim_printf(const char *format, ...)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Formats into a buffer and puts each character on the LCD.
+ Returns the number of characters written.
+*************************************************************/
+int sim_printf(const char *format, ...) {
+  char text[SIM_PRINTF_SIZE];
+  va_list args;
+  int length;
+
+  va_start(args, format);
+  length = vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  if(length >= SIM_PRINTF_SIZE) {
+    length = SIM_PRINTF_SIZE - 1;
+  }
+  for(int i = 0; i < length; i++) {
+    putchar(text[i]);
+  }
+  return length;
+}
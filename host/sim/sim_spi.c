@@ -0,0 +1,230 @@
+/****************************************************************
+  File Name            : "sim_spi.c"
+  Title                : Simulated SPI Master and Chip Selects
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  A byte written to SPDR is shifted in 8 SCLK periods, then
+  SPIF is set and SPDR holds the byte read. Every device whose
+  chip select is asserted sees the byte with the mode and
+  SCLK of SPCR/SPSR, so a device selected with the wrong mode
+  or with another device is counted.
+   DS1306     PA1 active high
+   DOG163     PB0 active low, RS on PB4
+   Humidicon  PA0, PA3-PA7, PG0, PG1 active low
+  A chip select is only asserted while its pin is an output.
+****************************************************************/
+
+#include "sim.h"
+#include "sim_internal.h"
+
+// ----- Statistics ----- //
+void (*sim_spi_trace)(const sim_spi_byte *b);
+unsigned long sim_spi_bytes[sim_spi_devices];
+unsigned long sim_spi_conflicts;
+unsigned long sim_spi_unselected;
+sim_time sim_spi_busy;
+
+// ----- Transfer in progress ----- //
+static sim_time spi_done = SIM_NEVER;
+static unsigned char spi_in;
+static unsigned int cs_selected;        // Bit per sim_spi_dev
+
+// Humidicon chip selects, as in humidicon.c
+static volatile unsigned char *const humidicon_ports[SIM_HUMIDICONS] = {
+  &PORTA, &PORTA, &PORTA, &PORTA, &PORTA, &PORTA, &PORTG, &PORTG
+};
+static volatile unsigned char *const humidicon_ddrs[SIM_HUMIDICONS] = {
+  &DDRA, &DDRA, &DDRA, &DDRA, &DDRA, &DDRA, &DDRG, &DDRG
+};
+static const unsigned char humidicon_pins[SIM_HUMIDICONS] = {0, 3, 4, 5, 6, 7, 0, 1};
+
+static const unsigned int spi_divider[4] = {4, 16, 64, 128};
+
+// ----- Local Function Prototypes ----- //
+static unsigned int cs_read(void);
+static void cs_notify(int dev, int selected);
+
+/*************************************************************
+ Function             : void sim_spi_start(unsigned char out)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ SPDR was written: hands out to the selected devices and
+ starts the transfer. MISO reads 1 when no device drives
+ it, and the devices driving it are ANDed.
+*************************************************************/
+void sim_spi_start(unsigned char out) {
+  unsigned char spcr = sim_regs[sim_SPCR];
+  unsigned int divider = spi_divider[spcr & 0x03];
+  sim_spi_byte b;
+  int count = 0;
+
+  if(!TESTBIT(spcr, SPE) || !TESTBIT(spcr, MSTR)) {
+    return;
+  }
+  if(TESTBIT(sim_regs[sim_SPSR], SPI2X)) {
+    divider /= 2;
+  }
+  b.start = sim_cycles;
+  b.selected = cs_selected;
+  b.mode = (spcr >> CPHA) & 0x03;
+  b.sclk = (unsigned long)(SIM_FOSC / divider);
+  b.out = out;
+  b.in = 0xFF;
+
+  for(int dev = 0; dev < sim_spi_devices; dev++) {
+    if(!(cs_selected & (1 << dev))) {
+      continue;
+    }
+    count++;
+    sim_spi_bytes[dev]++;
+    if(dev == sim_spi_rtc) {
+      b.in &= ds1306_transfer(out, b.mode, b.sclk);
+    } else if(dev == sim_spi_lcd) {
+      dog163_transfer(out, TESTBIT(PORTB, PB4) != 0, b.mode, b.sclk);
+    } else {
+      b.in &= humidicon_model_transfer(dev - sim_spi_humidicon, out, b.mode, b.sclk);
+    }
+  }
+  if(count == 0) {
+    sim_spi_unselected++;
+  } else if(count > 1) {
+    sim_spi_conflicts++;
+  }
+  if(sim_spi_trace) {
+    sim_spi_trace(&b);
+  }
+
+  spi_in = b.in;
+  spi_done = sim_cycles + 8 * divider;
+  sim_spi_busy += 8 * divider;
+  CLEARBIT(sim_regs[sim_SPSR], SPIF);
+}
+
+/*************************************************************
+ Function             : sim_time sim_spi_next()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ End of the transfer in progress, SIM_NEVER if none.
+*************************************************************/
+sim_time sim_spi_next() {
+  return spi_done;
+}
+
+/*************************************************************
+ Function             : int sim_spi_busy_now()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ True while a byte is being shifted.
+*************************************************************/
+int sim_spi_busy_now() {
+  return spi_done != SIM_NEVER;
+}
+
+/*************************************************************
+ Function             : void sim_spi_update()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Ends the transfer if it is due: SPIF is set and the byte
+ read is in SPDR.
+*************************************************************/
+void sim_spi_update() {
+  if(sim_cycles >= spi_done) {
+    spi_done = SIM_NEVER;
+    sim_regs[sim_SPDR] = spi_in;
+    SETBIT(sim_regs[sim_SPSR], SPIF);
+  }
+}
+
+/*************************************************************
+ Function             : void sim_spi_cs_sync()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Tells the devices about their chip select edges. The
+ de-selected devices are told first, so a device is never
+ seen selected with the one that released the bus.
+*************************************************************/
+void sim_spi_cs_sync() {
+  unsigned int selected = cs_read();
+  unsigned int changed = selected ^ cs_selected;
+
+  if(changed == 0) {
+    return;
+  }
+  for(int dev = 0; dev < sim_spi_devices; dev++) {
+    if((changed & (1 << dev)) && !(selected & (1 << dev))) {
+      cs_notify(dev, 0);
+    }
+  }
+  cs_selected = selected;
+  for(int dev = 0; dev < sim_spi_devices; dev++) {
+    if((changed & (1 << dev)) && (selected & (1 << dev))) {
+      cs_notify(dev, 1);
+    }
+  }
+}
+
+/*************************************************************
+ Function             : static unsigned int cs_read()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Devices whose chip select is asserted, bit per sim_spi_dev.
+*************************************************************/
+static unsigned int cs_read() {
+  unsigned int selected = 0;
+
+  for(int n = 0; n < SIM_HUMIDICONS; n++) {
+    unsigned char bit = 1 << humidicon_pins[n];
+
+    if((*humidicon_ddrs[n] & bit) && !(*humidicon_ports[n] & bit)) {
+      selected |= 1 << (sim_spi_humidicon + n);
+    }
+  }
+  if(TESTBIT(DDRA, PA1) && TESTBIT(PORTA, PA1)) {
+    selected |= 1 << sim_spi_rtc;
+  }
+  if(TESTBIT(DDRB, PB0) && !TESTBIT(PORTB, PB0)) {
+    selected |= 1 << sim_spi_lcd;
+  }
+  return selected;
+}
+
+/*************************************************************
+ Function             : static void cs_notify(int dev,
+                        int selected)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Chip select edge of one device.
+*************************************************************/
+static void cs_notify(int dev, int selected) {
+  if(dev == sim_spi_rtc) {
+    ds1306_ce(selected);
+  } else if(dev == sim_spi_lcd) {
+    dog163_cs(selected);
+  } else {
+    humidicon_model_cs(dev - sim_spi_humidicon, selected);
+  }
+}
@@ -0,0 +1,43 @@
+/****************************************************************
+  File Name            : "sim_vectors.c"
+  Title                : Interrupt Vector Table
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  gcc ignores the #pragma vector lines of the firmware, so the
+  interrupt handlers are listed here by vector number (the
+  *_vect numbers of iom128.h). A lower number has the higher
+  priority.
+****************************************************************/
+
+#include "sim.h"
+#include "sim_internal.h"
+
+// ----- Interrupt handlers in src/ ----- //
+extern void ISR_INT0(void);             // keypad.c
+extern void display_time_ISR(void);     // DS1306_RTC_drivers.c
+extern void ISR_INT2(void);             // Display_Time_Temp_Hum_FSM.c
+extern void ISR_INT3(void);             // Display_Time_Temp_Hum_FSM.c
+extern void timeout_ISR(void);          // timeout.c
+extern void humidicon_ISR(void);        // humidicon.c
+extern void lcd_tx_ISR(void);           // lcd_dog_iar_driver.c
+extern void telemetry_ISR(void);        // telemetry.c
+extern void telemetry_TXC_ISR(void);    // telemetry.c
+extern void co2_ADC_ISR(void);          // co2.c
+extern void eelog_ISR(void);            // eelog.c
+
+void (*const sim_vectors[SIM_VECTORS])(void) = {
+  [INT0_vect]         = ISR_INT0,
+  [INT1_vect]         = display_time_ISR,
+  [INT2_vect]         = ISR_INT2,
+  [INT3_vect]         = ISR_INT3,
+  [TIMER2_COMP_vect]  = timeout_ISR,
+  [TIMER1_COMPA_vect] = humidicon_ISR,
+  [TIMER0_COMP_vect]  = lcd_tx_ISR,
+  [USART0_UDRE_vect]  = telemetry_ISR,
+  [USART0_TXC_vect]   = telemetry_TXC_ISR,
+  [ADC_vect]          = co2_ADC_ISR,
+  [EE_READY_vect]     = eelog_ISR
+};
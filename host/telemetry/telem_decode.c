@@ -0,0 +1,181 @@
+/****************************************************************
+  File Name            : "telem_decode.c"
+  Title                : Telemetry Frame Decoder
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Byte at a time decoder of the telemetry frames. Bytes are
+  collected from a sync pair until the frame is complete. A
+  frame with a bad length or CRC is dropped, and its bytes 
+  after the first sync byte are decoded again, so a sync pair
+  inside a corrupt frame is found.
+****************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+#include "telemetry.h"
+#include "telem_decode.h"
+
+// ----- Local Function Prototypes ----- //
+static int frame_done(telem_decoder *d, telem_frame *frame);
+static unsigned int crc16_ccitt(unsigned int crc, unsigned char data);
+
+/*************************************************************
+ Function             : void telem_decoder_init(
+                        telem_decoder *d)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Clears the decoder state and counters.
+*************************************************************/
+void telem_decoder_init(telem_decoder *d) {
+  memset(d, 0, sizeof(*d));
+}
+
+/*************************************************************
+ Function             : int telem_decode_byte(
+                        telem_decoder *d, unsigned char byte,
+                        telem_frame *frame)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Adds a received byte. Returns 1 and fills frame when it
+ completes a good frame.
+*************************************************************/
+int telem_decode_byte(telem_decoder *d, unsigned char byte, telem_frame *frame) {
+  unsigned char rest[TELEM_FRAME_SIZE];
+  unsigned int count;
+  int found = 0;
+
+  // ----- Hunt for the sync pair ----- //
+  if((d->length == 0) && (byte != TELEM_SYNC1)) {
+    d->skipped++;
+    return 0;
+  }
+  if((d->length == 1) && (byte != TELEM_SYNC2)) {
+    d->skipped++;
+    d->length = 0;
+    return telem_decode_byte(d, byte, frame);
+  }
+
+  d->buffer[d->length++] = byte;
+  if(d->length < TELEM_FRAME_SIZE) {
+    if((d->length == 3) && (byte != TELEM_PAYLOAD)) {
+      d->length = TELEM_FRAME_SIZE;     // Bad length: resynchronize below
+    } else {
+      return 0;
+    }
+  }
+
+  if(frame_done(d, frame)) {
+    d->length = 0;
+    return 1;
+  }
+
+  // ----- Bad frame: decode its bytes again after the first sync byte ----- //
+  d->crc_errors++;
+  count = d->length - 1;
+  memcpy(rest, &d->buffer[1], count);
+  d->length = 0;
+  d->skipped++;
+  for(unsigned int i = 0; i < count; i++) {
+    found |= telem_decode_byte(d, rest[i], frame);
+  }
+  return found;
+}
+
+/*************************************************************
+ Function             : double telem_rh_percent(
+                        unsigned int rh_raw)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Relative humidity of a raw Humidicon code.
+*************************************************************/
+double telem_rh_percent(unsigned int rh_raw) {
+  return rh_raw * 100.0 / 16382.0;
+}
+
+/*************************************************************
+ Function             : double telem_temp_celsius(
+                        unsigned int temp_raw)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Temperature of a raw Humidicon code.
+*************************************************************/
+double telem_temp_celsius(unsigned int temp_raw) {
+  return temp_raw * 165.0 / 16382.0 - 40.0;
+}
+
+/*************************************************************
+ Function             : static int frame_done(
+                        telem_decoder *d, telem_frame *frame)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Checks the length and CRC of a complete frame, unpacks it,
+ and counts the frames missing from the sequence numbers.
+*************************************************************/
+static int frame_done(telem_decoder *d, telem_frame *frame) {
+  const unsigned char *b = d->buffer;
+  unsigned int crc = 0xFFFF;
+
+  if(b[2] != TELEM_PAYLOAD) {
+    return 0;
+  }
+  for(int i = 2; i < TELEM_FRAME_SIZE - 2; i++) {
+    crc = crc16_ccitt(crc, b[i]);
+  }
+  if(crc != (b[13] | ((unsigned int)b[14] << 8))) {
+    return 0;
+  }
+
+  frame->seq = b[3];
+  frame->stamp = b[4] | ((unsigned int)b[5] << 8);
+  frame->rh_raw = b[6] | ((unsigned int)b[7] << 8);
+  frame->temp_raw = b[8] | ((unsigned int)b[9] << 8);
+  frame->co2_counts = b[10] | ((unsigned int)b[11] << 8);
+  frame->flags = b[12];
+
+  if(d->have_seq) {
+    d->missing += (unsigned char)(frame->seq - d->last_seq - 1);
+  }
+  d->have_seq = 1;
+  d->last_seq = frame->seq;
+  d->frames++;
+  if(frame->flags & TELEM_DROPPED) {
+    d->flagged++;
+  }
+  return 1;
+}
+
+/*************************************************************
+ Function             : static unsigned int crc16_ccitt(
+                        unsigned int crc, unsigned char data)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ CRC-16/CCITT (0x1021) of one more byte.
+*************************************************************/
+static unsigned int crc16_ccitt(unsigned int crc, unsigned char data) {
+  crc ^= (unsigned int)data << 8;
+  for(int bit = 0; bit < 8; bit++) {
+    crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+  }
+  return crc & 0xFFFF;
+}
@@ -0,0 +1,47 @@
+/****************************************************************
+  File Name            : "telem_decode.h"
+  Title                : Telemetry Frame Decoder Header File
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Decodes the USART0 telemetry stream of the firmware (frame
+  layout in src/telemetry.h) one byte at a time. The decoder
+  finds the sync bytes, checks the length and the CRC, and 
+  resynchronizes after a bad frame without losing the frames
+  that follow it.
+****************************************************************/
+
+#ifndef TELEM_DECODE_H
+#define TELEM_DECODE_H
+
+// One decoded frame
+typedef struct {
+  unsigned char seq;
+  unsigned int stamp;                   // Seconds since reset
+  unsigned int rh_raw;                  // Raw Humidicon codes
+  unsigned int temp_raw;
+  unsigned int co2_counts;
+  unsigned char flags;                  // TELEM_xxx
+} telem_frame;
+
+// Decoder state and counters
+typedef struct {
+  unsigned char buffer[16];             // Frame being received
+  unsigned int length;
+  int have_seq;
+  unsigned char last_seq;
+  unsigned long frames;                 // Good frames
+  unsigned long crc_errors;             // Frames with a bad CRC or length
+  unsigned long skipped;                // Bytes skipped to find a sync
+  unsigned long missing;                // Frames missing from the sequence numbers
+  unsigned long flagged;                // Frames with TELEM_DROPPED
+} telem_decoder;
+
+extern void telem_decoder_init(telem_decoder *d);
+extern int telem_decode_byte(telem_decoder *d, unsigned char byte, telem_frame *frame);
+extern double telem_rh_percent(unsigned int rh_raw);
+extern double telem_temp_celsius(unsigned int temp_raw);
+
+#endif
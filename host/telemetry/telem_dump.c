@@ -0,0 +1,60 @@
+/****************************************************************
+  File Name            : "telem_dump.c"
+  Title                : Telemetry Stream Dump
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Reads the telemetry stream of the board from a serial port
+  (set to 115200 baud 8N1, raw) or from a file or stdin, and
+  prints one line per frame:
+    seq stamp RH% temperature(C) CO2-counts flags
+  The decoder counters are printed at the end of the stream.
+  Usage: telem_dump [device or file]
+****************************************************************/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <termios.h>
+#include <unistd.h>
+#include "telem_decode.h"
+
+int main(int argc, char **argv) {
+  telem_decoder decoder;
+  telem_frame frame;
+  unsigned char bytes[256];
+  struct termios tio;
+  ssize_t count;
+  int fd = 0;
+
+  if(argc > 1) {
+    fd = open(argv[1], O_RDONLY | O_NOCTTY);
+    if(fd < 0) {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+  if(tcgetattr(fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tcsetattr(fd, TCSANOW, &tio);
+  }
+
+  telem_decoder_init(&decoder);
+  while((count = read(fd, bytes, sizeof(bytes))) > 0) {
+    for(ssize_t i = 0; i < count; i++) {
+      if(telem_decode_byte(&decoder, bytes[i], &frame)) {
+        printf("%3u %5u %6.2f%% %7.2fC %4u 0x%02X\n", frame.seq, frame.stamp,
+               telem_rh_percent(frame.rh_raw), telem_temp_celsius(frame.temp_raw),
+               frame.co2_counts, frame.flags);
+        fflush(stdout);
+      }
+    }
+  }
+
+  fprintf(stderr, "%lu frames, %lu bad, %lu missing, %lu with dropped frames before them, %lu bytes skipped\n",
+          decoder.frames, decoder.crc_errors, decoder.missing, decoder.flagged, decoder.skipped);
+  return 0;
+}
@@ -0,0 +1,28 @@
+/****************************************************************
+  File Name            : "test.h"
+  Title                : Host Test Macros
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  A test is a program that returns 0 when every CHECK holds.
+  The numbers a test measures are printed for the log of 
+  ctest --output-on-failure.
+****************************************************************/
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim.h"
+
+#define CHECK(cond) do { \
+    if(!(cond)) { \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      exit(1); \
+    } \
+  } while(0)
+
+#endif
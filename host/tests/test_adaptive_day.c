@@ -0,0 +1,143 @@
+/****************************************************************
+  File Name            : "test_adaptive_day.c"
+  Title                : Host Test: Adaptive Sampling over a Day
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Replays two diurnal traces of a day, one sample a second,
+  into the Humidicon model (a child process each):
+  - calm: temperature 16C->28C and RH 75%->45% following the
+    sun, with +/-2 codes of sensor noise,
+  - vents: the same day with 8 vent openings of 10 minutes
+    (-3C and +10% RH at once, then back).
+  Reports the measurements taken, the worst delay from a step
+  to its detection (the cached reading of sensor 0 half way to
+  the new value), and the sensor energy and SPI bus time saved
+  against a measurement every second. The delay may not be
+  longer than HUMIDICON_MAX_INTERVAL seconds plus a conversion.
+  A stale fetch must bring the sampling back to every second
+  instead of counting as a stable sample, and a key press must
+  measure at once.
+  Sensor energy: HUMIDICON_MA at 5V during each 36.65ms
+  measurement cycle (HIH6130 typical supply current).
+****************************************************************/
+
+#include <math.h>
+#include "header.h"
+#include "humidicon.h"
+#include "test.h"
+
+#define DAY             86400
+#define STEPS           8
+#define STEP_SECONDS    600
+#define HUMIDICON_MA    0.65            // Supply current while measuring
+#define HUMIDICON_V     5.0
+#define FETCH_BYTES     4               // Plus the measurement request
+
+static const double pi = 3.14159265358979;
+static unsigned long noise_state = 2026;
+
+// Deterministic noise of +/- range codes
+static int noise(int range) {
+  noise_state = noise_state * 1103515245UL + 12345UL;
+  return (int)((noise_state >> 16) % (2 * range + 1)) - range;
+}
+
+// Trace value at second t: 0.01 degrees C and 0.01% RH
+static void trace(int t, int vents, int *temp, unsigned int *rh) {
+  double sun = sin(2.0 * pi * (t - 9 * 3600) / DAY);     // Warmest at 15:00
+
+  *temp = (int)(2200 + 600 * sun);
+  *rh = (unsigned int)(6000 - 1500 * sun);
+  if(vents && ((t / 3600) % 3 == 1) && ((t % 3600) >= 1800) && ((t % 3600) < 1800 + STEP_SECONDS)) {
+    *temp -= 300;
+    *rh += 1000;
+  }
+}
+
+// True once the cached reading is at least half way from before to after
+static int detected(unsigned int before, unsigned int after) {
+  unsigned int rh, temp;
+
+  humidicon_raw(&rh, &temp);
+  return (after > before) ? (rh >= (before + after) / 2) : (rh <= (before + after) / 2);
+}
+
+static void replay(void *arg) {
+  int vents = (arg != 0), temp, steps = 0;
+  unsigned int rh, rh_before = 0, rh_after = 0;
+  unsigned long requests, spi_bytes;
+  sim_time step_at = 0, delay, delay_max = 0;
+  double saved, energy;
+
+  trace(0, vents, &temp, &rh);
+  humidicon_model_set(0, humidicon_rh_to_raw(rh), humidicon_temp_to_raw(temp));
+  sim_run(SIM_MS(500));
+  requests = humidicon_model_requests[0];
+  spi_bytes = sim_spi_bytes[sim_spi_humidicon];
+
+  for(int t = 1; t < DAY; t++) {
+    int temp_was = temp;
+    unsigned int rh_was = rh;
+
+    trace(t, vents, &temp, &rh);
+    humidicon_model_set(0, humidicon_rh_to_raw(rh) + noise(2), humidicon_temp_to_raw(temp) + noise(2));
+    if(abs(temp - temp_was) >= 100) {           // A vent opened or closed
+      step_at = sim_now();
+      rh_before = humidicon_rh_to_raw(rh_was);
+      rh_after = humidicon_rh_to_raw(rh);
+    }
+    if(step_at == 0) {
+      sim_run(SIM_SECONDS(1));
+      continue;
+    }
+    for(int ms = 0; ms < 1000; ms += 10) {      // 10ms resolution while a step is pending
+      sim_run(SIM_MS(10));
+      if((step_at != 0) && detected(rh_before, rh_after)) {
+        delay = sim_now() - step_at;
+        delay_max = (delay > delay_max) ? delay : delay_max;
+        step_at = 0;
+        steps++;
+      }
+    }
+  }
+  requests = humidicon_model_requests[0] - requests;
+  spi_bytes = sim_spi_bytes[sim_spi_humidicon] - spi_bytes;
+
+  // ----- Against a measurement every second ----- //
+  energy = HUMIDICON_MA * 1e-3 * HUMIDICON_V * (double)SIM_HUMIDICON_MEASURE / SIM_FOSC;
+  saved = (double)(DAY - requests) * energy;
+  printf("%-6s %5lu measurements (%4.1f%% of %d), %lu SPI bytes, steps detected %d, worst delay %5.2fs, "
+         "sensor energy saved %.2fJ/day (%.1f%%), SPI bus time saved %.2fs\n",
+         vents ? "vents" : "calm", requests, 100.0 * requests / DAY, DAY, spi_bytes, steps,
+         (double)delay_max / SIM_FOSC, saved, 100.0 * saved / (DAY * energy),
+         (double)((DAY * (1 + FETCH_BYTES)) - spi_bytes) * 8 / 4e6);
+  CHECK(requests < DAY / 4);
+  CHECK(step_at == 0);
+  CHECK(steps == (vents ? 2 * STEPS : 0));
+  CHECK(delay_max <= SIM_SECONDS(HUMIDICON_MAX_INTERVAL) + SIM_HUMIDICON_MEASURE + SIM_MS(20));
+  CHECK(humidicon_model_stale[0] == 0);
+
+  // ----- A stale fetch is retried on the next tick ----- //
+  sim_wake();
+  CHECK(!fetch_humidicon());            // The last sample was already read
+  CHECK(humidicon_model_stale[0] == 1);
+  requests = humidicon_model_requests[0];
+  sim_run(SIM_SECONDS(4));
+  CHECK(humidicon_model_requests[0] - requests >= 3);
+
+  // ----- A key press measures at once ----- //
+  requests = humidicon_model_requests[0];
+  keypad_model_set(2, 1);               // zero: sensor page
+  sim_run(SIM_MS(100));
+  keypad_model_set(2, 0);
+  CHECK(humidicon_model_requests[0] == requests + 1);
+}
+
+int main(void) {
+  CHECK(sim_fork(replay, 0) == 0);
+  CHECK(sim_fork(replay, (void *)1) == 0);
+  return 0;
+}
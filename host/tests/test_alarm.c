@@ -0,0 +1,180 @@
+/****************************************************************
+  File Name            : "test_alarm.c"
+  Title                : Host Test: Threshold Alarms
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Plays synthetic traces, one sample a second, through 
+  alarm_check() with the default limits (temperature 5.00C to
+  35.00C, humidity 30% to 90%, CO2 above 2000ppm, hysteresis,
+  10 seconds on and off) and checks the second each alarm is
+  raised and cleared and the PD7 output:
+  - a 9 second excursion and a chattering sample never alarm,
+  - noise inside the hysteresis does not clear an alarm,
+  - a Humidicon sampled every 4 seconds alarms once the samples
+    span 10 seconds,
+  - CO2 samples of a preheating sensor are ignored.
+  The simulator times the register accesses, delays and 
+  peripherals but not the instructions, so the per-sample 
+  budget checked is 0 simulated cycles: no bus transfer, no 
+  wait and no delay. The compares themselves are timed with 
+  the profiler on the target.
+  Then boots the firmware with the Humidicon above 35C and 
+  checks the indicator on the sensor page and PD7.
+****************************************************************/
+
+#include <string.h>
+#include "header.h"
+#include "humidicon.h"
+#include "co2.h"
+#include "alarm.h"
+#include "test.h"
+
+#define ALARM_BUDGET    0               // Simulated cycles of a sample
+#define NO_CHANGE       -1
+
+static sim_time cycles_max, cycles_total;
+static unsigned long samples;
+
+// Inputs of one second of a trace, in display units
+typedef struct {
+  int temp;                             // 0.01 degrees C
+  unsigned int rh;                      // 0.01% RH
+  unsigned int co2;                     // 12-bit counts
+} sample;
+
+static const sample normal = {2000, 5000, 0};
+
+// One second: a fresh Humidicon sample if fresh. Returns true if a level changed.
+static bool tick(const sample *s, bool fresh) {
+  sim_time start, cycles;
+  bool changed;
+
+  if(fresh) {
+    humidicon_sequence++;
+  }
+  start = sim_now();
+  changed = alarm_check(humidicon_rh_to_raw(s->rh), humidicon_temp_to_raw(s->temp), s->co2);
+  cycles = sim_now() - start;
+  cycles_total += cycles;
+  cycles_max = (cycles > cycles_max) ? cycles : cycles_max;
+  samples++;
+  return changed;
+}
+
+// Runs seconds of s and returns the second (1 = first) of the
+// first level change, or NO_CHANGE
+static int hold(sample s, int seconds, int every) {
+  int change = NO_CHANGE;
+
+  for(int t = 0; t < seconds; t++) {
+    if(tick(&s, (t % every) == 0) && (change == NO_CHANGE)) {
+      change = t + 1;
+    }
+  }
+  return change;
+}
+
+static bool pd7(void) {
+  return (PORTD & (1 << 7)) != 0;
+}
+
+static void traces(void *arg) {
+  sample s;
+
+  (void)arg;
+  init_alarms();
+  CHECK(hold(normal, 5, 1) == NO_CHANGE);
+
+  // ----- 9 seconds above the high limit ----- //
+  s = normal;
+  s.temp = 3600;
+  CHECK(hold(s, 9, 1) == NO_CHANGE);
+  CHECK(hold(normal, 20, 1) == NO_CHANGE);
+  printf("temperature 9s at 36C: no alarm\n");
+
+  // ----- Chattering around the limit ----- //
+  for(int t = 0; t < 60; t++) {
+    s.temp = (t & 1) ? 3400 : 3600;
+    CHECK(!tick(&s, true));
+  }
+  printf("temperature 60s alternating 34C/36C: no alarm\n");
+
+  // ----- Raised on the 10th second, noise inside the hysteresis keeps it ----- //
+  init_alarms();
+  s.temp = 3600;
+  CHECK(hold(s, 30, 1) == 10);
+  CHECK((alarm_get(alarm_temp) == alarm_high) && pd7());
+  for(int t = 0; t < 60; t++) {
+    s.temp = 3500 + ((t * 37) % 90) - 45;     // 34.55C -> 35.44C, above 34.50C
+    CHECK(!tick(&s, true));
+  }
+  CHECK(hold(normal, 30, 1) == 10);
+  CHECK((alarm_get(alarm_temp) == alarm_ok) && !pd7());
+  printf("temperature high: raised after 10s, kept by 34.55C->35.44C, cleared 10s after 20C\n");
+
+  // ----- Humidity low with its hysteresis ----- //
+  s = normal;
+  s.rh = 2500;
+  CHECK(hold(s, 30, 1) == 10);
+  CHECK((alarm_get(alarm_rh) == alarm_low) && pd7());
+  s.rh = 3100;                                  // Inside by less than 2%
+  CHECK(hold(s, 60, 1) == NO_CHANGE);
+  s.rh = 3300;
+  CHECK(hold(s, 30, 1) == 10);
+  CHECK((alarm_get(alarm_rh) == alarm_ok) && !pd7());
+  printf("humidity low: raised after 10s, kept at 31%%, cleared 10s after 33%%\n");
+
+  // ----- Humidicon sampled every 4 seconds ----- //
+  s = normal;
+  s.temp = 3600;
+  CHECK(hold(s, 40, 4) == 13);                  // Samples at 1, 5, 9, 13: 10s spanned at 13
+  CHECK(hold(normal, 40, 4) == 13);
+  printf("temperature sampled every 4s: raised and cleared on the 4th sample (13s)\n");
+
+  // ----- CO2: preheating ignored, then high ----- //
+  s = normal;
+  s.co2 = 100;
+  CHECK(hold(s, 30, 1) == NO_CHANGE);
+  s.co2 = co2_ppm_to_counts(2500);
+  CHECK(hold(s, 30, 1) == 10);
+  CHECK((alarm_get(alarm_co2) == alarm_high) && pd7());
+  s.co2 = co2_ppm_to_counts(1950);
+  CHECK(hold(s, 30, 1) == NO_CHANGE);
+  s.co2 = co2_ppm_to_counts(1800);
+  CHECK(hold(s, 30, 1) == 10);
+  CHECK(!pd7());
+  printf("CO2: ignored while preheating, raised after 10s at 2500ppm, kept at 1950ppm, cleared at 1800ppm\n");
+
+  printf("%lu samples: %llu simulated cycles at most, %.2f on average\n", samples, cycles_max,
+         (double)cycles_total / samples);
+  CHECK(cycles_max <= ALARM_BUDGET);
+  CHECK(alarm_raised_count == 4);
+}
+
+static void firmware(void *arg) {
+  char line[17];
+
+  (void)arg;
+  humidicon_model_set(0, 0x2000, humidicon_temp_to_raw(3600));
+  sim_run(SIM_SECONDS(20));
+  dog163_line(0, line);
+  printf("[%s]\n", line);
+  CHECK((strstr(line, "T^") != 0) && pd7());
+  dog163_line(1, line);
+  CHECK(strncmp(line, "Temp: 36.00", 11) == 0);
+
+  humidicon_model_set(0, 0x2000, humidicon_temp_to_raw(2000));
+  sim_run(SIM_SECONDS(20));
+  dog163_line(0, line);
+  printf("[%s]\n", line);
+  CHECK((strstr(line, "T^") == 0) && !pd7());
+}
+
+int main(void) {
+  CHECK(sim_fork(traces, 0) == 0);
+  CHECK(sim_fork(firmware, 0) == 0);
+  return 0;
+}
@@ -0,0 +1,129 @@
+/****************************************************************
+  File Name            : "test_alarm_tick.c"
+  Title                : Host Test: Tick Rate and DS1306 Alarm 0
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  For each alarm type 1->5 (a child process each) the DS1306 
+  is set to 10:00:00 on weekday 3, and Alarm 0 is typed on 
+  the keypad for 10:00:30 on weekday 3, then the firmware runs
+  80 seconds. Every second must have exactly one tick from the
+  1Hz output, and once the entry is done the time on the LCD,
+  read half way between the ticks, must be the clock's and
+  advance by one second per second. Alarm 0 must fire 
+  every second for type 1 and once (at 10:00:30) for types 
+  2->5. A weekly alarm on weekday 4 must not fire.
+****************************************************************/
+
+#include <string.h>
+#include "header.h"
+#include "events.h"
+#include "clock.h"
+#include "test.h"
+
+#define RUN_SECONDS     80
+#define ENTRY_SECONDS   12              // The entry and its confirmation are done
+
+typedef struct {
+  unsigned char type;
+  unsigned char weekday;
+  unsigned int alarms_min, alarms_max;
+} alarm_case;
+
+static const alarm_case cases[] = {
+  {1, 3, 60, RUN_SECONDS},              // Every second once enabled
+  {2, 3, 1, 1},                         // Every minute at :30
+  {3, 3, 1, 1},                         // Every hour at 00:30
+  {4, 3, 1, 1},                         // Every day at 10:00:30
+  {5, 3, 1, 1},                         // Every week, weekday 3 at 10:00:30
+  {5, 4, 0, 0}                          // Every week, weekday 4: not today
+};
+
+// kTable positions of the digits 0->9
+static const unsigned char digit_position[10] = {2, 15, 14, 13, 11, 10, 9, 7, 6, 5};
+
+static const alarm_case *current;
+static unsigned int typed;
+
+// Keys: setAlarm0, type, weekday, 10:00:30
+static void key(void *arg) {
+  const unsigned char digits[8] = {current->type, current->weekday, 1, 0, 0, 0, 3, 0};
+  unsigned char position = (typed == 0) ? 8 : digit_position[digits[typed - 1]];
+
+  keypad_model_set(position, arg != 0);
+  if(arg == 0) {
+    typed++;
+  }
+}
+
+// Seconds of the time on the first LCD line, or -1
+static int lcd_seconds(void) {
+  char line[17];
+
+  dog163_line(0, line);
+  if(strncmp(line, "Time: ", 6) != 0) {
+    return -1;
+  }
+  return (line[12] - '0') * 10 + (line[13] - '0');
+}
+
+static void run_case(void *arg) {
+  sim_time start;
+  unsigned int ticks, alarms, total_ticks = 0;
+  int last = -1, shown, steps = 0;
+
+  current = arg;
+  humidicon_model_set(0, 0x2000, 0x1800);
+  sim_run(SIM_MS(100));
+  ds1306_set_time(10, 0, 0, 16, 10, 26);
+  ds1306_poke(0x03, 3);
+  sim_wake();
+  clock_sync(false);
+
+  start = sim_now() + SIM_MS(500);
+  for(int k = 0; k < 9; k++) {
+    sim_at(start + (sim_time)k * SIM_MS(400), key, (void *)1);
+    sim_at(start + (sim_time)k * SIM_MS(400) + SIM_MS(80), key, 0);
+  }
+
+  // ----- Samples half way between the ticks ----- //
+  ticks = event_counts[ev_tick];
+  while(event_counts[ev_tick] == ticks) {
+    sim_run(SIM_MS(1));
+  }
+  sim_run(SIM_MS(500));
+
+  // ----- One tick per second, the LCD time follows ----- //
+  alarms = event_counts[ev_alarm0];
+  for(int s = 0; s < RUN_SECONDS; s++) {
+    ticks = event_counts[ev_tick];
+    sim_run(SIM_SECONDS(1));
+    CHECK(event_counts[ev_tick] - ticks == 1);
+    total_ticks += event_counts[ev_tick] - ticks;
+    shown = lcd_seconds();
+    if(s >= ENTRY_SECONDS) {
+      CHECK(shown == clock_now()->seconds);
+      if(last >= 0) {
+        CHECK(shown == (last + 1) % 60);
+        steps++;
+      }
+    }
+    last = shown;
+  }
+  alarms = event_counts[ev_alarm0] - alarms;
+  printf("alarm type %u, weekday %u: %u ticks in %ds, LCD time advanced 1s %d times, Alarm 0 fired %u times\n",
+         current->type, current->weekday, total_ticks, RUN_SECONDS, steps, alarms);
+  CHECK(typed == 9);
+  CHECK(steps == RUN_SECONDS - ENTRY_SECONDS);
+  CHECK((alarms >= current->alarms_min) && (alarms <= current->alarms_max));
+  CHECK(events_dropped == 0);
+}
+
+int main(void) {
+  for(unsigned int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    CHECK(sim_fork(run_case, (void *)&cases[i]) == 0);
+  }
+  return 0;
+}
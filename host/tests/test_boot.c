@@ -0,0 +1,49 @@
+/****************************************************************
+  File Name            : "test_boot.c"
+  Title                : Host Test: Boot
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Boots the firmware for 3 seconds and checks the main view,
+  the 1Hz ticks, and that every SPI device was driven in its
+  own mode, one at a time, and never while it was busy.
+****************************************************************/
+
+#include <string.h>
+#include "header.h"
+#include "test.h"
+
+int main(void) {
+  char line[3][17];
+
+  humidicon_model_set(0, 0x2000, 0x1800);     // 50.01%, 21.89C
+  sim_run(SIM_SECONDS(3) + SIM_MS(100));
+
+  for(int i = 0; i < 3; i++) {
+    dog163_line(i, line[i]);
+    printf("line %d: [%s]\n", i + 1, line[i]);
+  }
+  printf("1Hz ticks %lu, active %llu, idle %llu, adc noise %llu, power-down %llu cycles\n",
+         sim_isr_count[INT1_vect], sim_mode_cycles[sim_active], sim_mode_cycles[sim_idle],
+         sim_mode_cycles[sim_adc_noise], sim_mode_cycles[sim_power_down]);
+
+  // ----- Time set to 00:00:00 by DS1306_RTC_config ----- //
+  CHECK(sim_isr_count[INT1_vect] == 2);
+  CHECK(strncmp(line[0], "Time: 00:00:02", 14) == 0);
+  CHECK(strncmp(line[1], "Temp: 21.89", 11) == 0);
+  CHECK(strncmp(line[2], "RH:   50.01%", 12) == 0);
+
+  // ----- SPI bus ----- //
+  CHECK(sim_spi_conflicts == 0);
+  CHECK(sim_spi_unselected == 0);
+  CHECK(ds1306_mode_errors == 0);
+  CHECK(humidicon_model_mode_errors == 0);
+  CHECK(dog163_mode_errors == 0);
+  CHECK(dog163_busy_violations == 0);
+
+  // ----- The CPU sleeps between events ----- //
+  CHECK(sim_mode_cycles[sim_power_down] > sim_mode_cycles[sim_active]);
+  return 0;
+}
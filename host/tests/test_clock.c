@@ -0,0 +1,113 @@
+/****************************************************************
+  File Name            : "test_clock.c"
+  Title                : Host Test: Software Clock Rollovers
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Boots the firmware (a child process each), sets the DS1306
+  model 10 seconds before a rollover and resyncs the clock as
+  the set time handler does (the boot writes its own time), 
+  then checks the software clock against the model every 
+  second for 30 seconds: midnight and the end of a 30 day 
+  month, February of a common year, February of a leap year,
+  and 12/31/99 to 01/01/00.
+  Then runs a day from noon on 02/28/24 through the leap day,
+  with the DS1306 seconds moved 5 seconds ahead once (a lost
+  tick) so the next hourly resync flags the drift, and counts
+  the DS1306 transactions and clock reads of the day.
+****************************************************************/
+
+#include "header.h"
+#include "clock.h"
+#include "test.h"
+
+typedef struct {
+  unsigned char hours, minutes, seconds, date, month, year;
+} start_time;
+
+static const start_time rollovers[] = {
+  {23, 59, 50, 30,  4, 26},             // 04/30/26 -> 05/01/26
+  {23, 59, 50, 28,  2, 25},             // 02/28/25 -> 03/01/25
+  {23, 59, 50, 28,  2, 24},             // 02/28/24 -> 02/29/24
+  {23, 59, 50, 29,  2, 24},             // 02/29/24 -> 03/01/24
+  {23, 59, 50, 31, 12, 99}              // 12/31/99 -> 01/01/00
+};
+
+static unsigned char bin(unsigned char bcd) {
+  return (bcd >> 4) * 10 + (bcd & 0x0F);
+}
+
+// True if the software clock shows the time of the DS1306 model
+static int clock_matches(void) {
+  const clock_time *now = clock_now();
+
+  return (now->seconds == bin(ds1306_peek(0x00) & 0x7F)) && (now->minutes == bin(ds1306_peek(0x01))) &&
+         (now->hours == bin(ds1306_peek(0x02) & 0x3F)) && (now->day == ds1306_peek(0x03)) &&
+         (now->date == bin(ds1306_peek(0x04))) && (now->month == bin(ds1306_peek(0x05))) &&
+         (now->year == bin(ds1306_peek(0x06)));
+}
+
+// Boots, then sets the DS1306 and the software clock to t
+static void start_at(const start_time *t) {
+  humidicon_model_set(0, 0x2000, 0x1800);
+  sim_run(SIM_MS(100));
+  ds1306_set_time(t->hours, t->minutes, t->seconds, t->date, t->month, t->year);
+  sim_wake();
+  clock_sync(false);
+}
+
+static void rollover(void *arg) {
+  const start_time *t = arg;
+  const clock_time *now = clock_now();
+
+  start_at(t);
+  for(int s = 0; s < 30; s++) {
+    sim_run(SIM_SECONDS(1));
+    CHECK(clock_matches());
+  }
+  CHECK(clock_drift_count == 0);
+  printf("%02u/%02u/%02u %02u:%02u:%02u + 30s = %02u/%02u/%02u %02u:%02u:%02u\n",
+         t->month, t->date, t->year, t->hours, t->minutes, t->seconds,
+         now->month, now->date, now->year, now->hours, now->minutes, now->seconds);
+}
+
+static void day(void *arg) {
+  const clock_time *now = clock_now();
+
+  static const start_time noon = {12, 0, 0, 28, 2, 24};
+  unsigned long transactions, reads;
+  unsigned char h, m, s;
+
+  (void)arg;
+  start_at(&noon);
+  transactions = ds1306_transactions;
+  reads = ds1306_time_reads;
+  for(int hour = 1; hour <= 24; hour++) {
+    if(hour == 2) {
+      ds1306_get_time(&h, &m, &s);                  // A lost tick: the DS1306 5 seconds ahead
+      CHECK(s < 50);
+      ds1306_set_time(h, m, s + 5, 28, 2, 24);
+    }
+    sim_run(SIM_SECONDS(3600));
+    if(hour == 1) {
+      CHECK(clock_matches() && (clock_drift_count == 0));
+    }
+  }
+  CHECK(clock_matches());
+  CHECK((now->date == 29) && (now->month == 2) && (now->hours == 12));
+  printf("a day from 02/28/24 12:00: %u resyncs, %u drift of %lds, %lu DS1306 transactions, "
+         "%lu clock reads\n", clock_syncs, clock_drift_count, clock_last_drift,
+         ds1306_transactions - transactions, ds1306_time_reads - reads);
+  CHECK((clock_drift_count == 1) && (clock_last_drift == 5));
+  CHECK((clock_syncs >= 86400 / CLOCK_SYNC_SECONDS) && (ds1306_time_reads - reads <= 86400 / CLOCK_SYNC_SECONDS + 1));
+}
+
+int main(void) {
+  for(unsigned int i = 0; i < sizeof(rollovers) / sizeof(rollovers[0]); i++) {
+    CHECK(sim_fork(rollover, (void *)&rollovers[i]) == 0);
+  }
+  CHECK(sim_fork(day, 0) == 0);
+  return 0;
+}
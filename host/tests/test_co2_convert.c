@@ -0,0 +1,160 @@
+/****************************************************************
+  File Name            : "test_co2_convert.c"
+  Title                : Host Test: CO2 Conversion
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Checks co2_convert() for every 10-bit ADC code against the
+  exact voltage/ppm curve (2.5mV per count, 400mV -> 0ppm,
+  3.125ppm per mV):
+  - the Fault (0V) and Preheating (< 400mV) classification
+    of the float code it replaced.
+  - the default curve within 1ppm, and a 4-point curve within
+    3ppm for every 12-bit oversampled result (the 8 fraction
+    bits of the slope lose at most 1/256ppm per count).
+  - co2_ppm_to_counts() is the lowest result at a ppm.
+  - tables with equal counts, falling counts or falling ppm
+    convert like the table without those points, a table
+    with fewer than 2 usable points sets the default curve,
+    and a steep segment is clamped without wrapping.
+  The cycles are not compared here: the host has a floating
+  point unit and the ATmega128 does not, and the simulator
+  only times register accesses.
+****************************************************************/
+
+#include "header.h"
+#include "co2.h"
+#include "test.h"
+
+static const co2_point default_curve[2] = {{160, 0}, {800, 5000}};
+static const co2_point curve[4] = {{160, 0}, {300, 800}, {500, 2500}, {800, 5000}};
+
+// Tables with points co2_set_calibration() must skip, each converts like curve[]
+static const co2_point equal_counts[5] = {{160, 0}, {300, 800}, {300, 900}, {500, 2500}, {800, 5000}};
+static const co2_point falling_counts[5] = {{160, 0}, {300, 800}, {250, 1000}, {500, 2500}, {800, 5000}};
+static const co2_point falling_ppm[5] = {{160, 0}, {300, 800}, {400, 700}, {500, 2500}, {800, 5000}};
+static const co2_point no_curve[2] = {{300, 800}, {300, 900}};
+static const co2_point steep[2] = {{160, 0}, {161, 60000}};
+
+static unsigned int curve_ppm[4096];
+
+// True if the table converts every 12-bit result like curve[]
+static bool same_as_curve(const co2_point *points, unsigned char count) {
+  unsigned int ppm;
+
+  CHECK(co2_set_calibration(points, count));
+  for(unsigned int counts = CO2_PREHEAT_COUNTS; counts < 4096; counts++) {
+    co2_convert(counts, &ppm);
+    if(ppm != curve_ppm[counts]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Exact ppm of a 10-bit code (fractional for oversampled results)
+static double exact(const co2_point *points, int count, double code) {
+  int i;
+
+  if(code <= points[0].counts) {
+    return points[0].ppm;
+  }
+  for(i = 1; (i < count - 1) && (code >= points[i].counts); i++);
+  return points[i - 1].ppm + (code - points[i - 1].counts) *
+         (double)(points[i].ppm - points[i - 1].ppm) / (points[i].counts - points[i - 1].counts);
+}
+
+// The float conversion of dispCO2_fn before co2.c
+static co2_status float_convert(int code, float *concentration) {
+  float voltage = code * (2560 / 1024.0);
+
+  if(voltage == 0) {
+    return co2_fault;
+  } else if(voltage < 400) {
+    return co2_preheating;
+  }
+  *concentration = ((int)voltage - 400) * (50.0 / 16.0);
+  return co2_valid;
+}
+
+int main(void) {
+  unsigned int ppm;
+  float concentration;
+  double error, int_error = 0.0, float_error = 0.0;
+
+  // ----- Default curve, every 10-bit code ----- //
+  co2_set_calibration(default_curve, 2);
+  for(int code = 0; code < 1024; code++) {
+    co2_status status = co2_convert(code << 2, &ppm);
+
+    CHECK(status == float_convert(code, &concentration));
+    if(status != co2_valid) {
+      continue;
+    }
+    error = ppm - exact(default_curve, 2, code);
+    CHECK((error > -1.0) && (error <= 0.0));          // Truncated, like the float code
+    if(-error > int_error) {
+      int_error = -error;
+    }
+    error = concentration - exact(default_curve, 2, code);
+    if((error < 0 ? -error : error) > float_error) {
+      float_error = error < 0 ? -error : error;
+    }
+  }
+  printf("default curve: integer within %.3fppm, float code within %.3fppm\n", int_error, float_error);
+
+  // ----- 4-point curve, every 12-bit result ----- //
+  co2_set_calibration(curve, 4);
+  int_error = 0.0;
+  for(unsigned int counts = CO2_PREHEAT_COUNTS; counts < 4096; counts++) {
+    CHECK(co2_convert(counts, &ppm) == co2_valid);
+    error = ppm - exact(curve, 4, counts / 4.0);
+    if((error < 0 ? -error : error) > int_error) {
+      int_error = error < 0 ? -error : error;
+    }
+    CHECK((error > -3.0) && (error < 3.0));
+    curve_ppm[counts] = ppm;
+  }
+  printf("4-point curve: integer within %.3fppm\n", int_error);
+
+  // ----- Inverse ----- //
+  for(unsigned int limit = 1; limit <= 8000; limit++) {
+    unsigned int counts = co2_ppm_to_counts(limit);
+
+    CHECK(co2_convert(counts, &ppm) == co2_valid);
+    CHECK(ppm >= limit);
+    if(counts > CO2_PREHEAT_COUNTS) {
+      co2_convert(counts - 1, &ppm);
+      CHECK(ppm < limit);
+    }
+  }
+
+  // ----- Points that do not rise are skipped ----- //
+  CHECK(same_as_curve(equal_counts, 5));
+  CHECK(same_as_curve(falling_counts, 5));
+  CHECK(same_as_curve(falling_ppm, 5));
+  CHECK(!co2_set_calibration(no_curve, 2));
+  for(int code = 160; code < 1024; code++) {
+    co2_convert(code << 2, &ppm);
+    CHECK(ppm == (unsigned int)exact(default_curve, 2, code));
+  }
+
+  // ----- Steep segment: clamped slope, no wrap ----- //
+  {
+    unsigned int last = 0;
+
+    CHECK(co2_set_calibration(steep, 2));
+    for(unsigned int counts = CO2_PREHEAT_COUNTS; counts < 4096; counts++) {
+      CHECK(co2_convert(counts, &ppm) == co2_valid);
+      CHECK(ppm >= last);
+      last = ppm;
+    }
+    co2_convert(161 << 2, &ppm);
+    printf("steep segment: %uppm at the last point, %uppm at full scale\n", ppm, last);
+    CHECK(ppm == 60000);
+    CHECK(last == 0xFFFF);
+  }
+  return 0;
+}
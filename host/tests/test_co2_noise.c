@@ -0,0 +1,83 @@
+/****************************************************************
+  File Name            : "test_co2_noise.c"
+  Title                : Host Test: CO2 Oversampling
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Feeds ADC3 a constant voltage between two codes with about
+  1.2 LSB rms of noise, and reads co2_read() every second for
+  5 minutes. Reports the rms noise of a single conversion and
+  of the filtered value, the effective resolution gained,
+  the CPU time of the ADC interrupts per sample, and how many
+  conversions ran while the CPU was awake.
+****************************************************************/
+
+#include <math.h>
+#include "header.h"
+#include "co2.h"
+#include "test.h"
+
+#define RUN_SECONDS     300
+#define SETTLE_SECONDS  10
+#define TRUE_CODE       493.8           // 1.2345V in 10-bit counts
+
+static unsigned long noise_state = 2026;
+static double raw_sum, raw_squares;
+static unsigned long raw_count;
+
+// Sum of 4 uniform values: about gaussian, 1.15 LSB rms
+static double noise(void) {
+  double sum = 0.0;
+
+  for(int i = 0; i < 4; i++) {
+    noise_state = noise_state * 1103515245UL + 12345UL;
+    sum += ((noise_state >> 16) & 0x7FFF) / 32768.0 - 0.5;
+  }
+  return 2.0 * sum;
+}
+
+static unsigned int adc3(unsigned char mux) {
+  double code = floor(TRUE_CODE + noise() + 0.5);
+
+  CHECK(mux == 3);
+  raw_sum += code - TRUE_CODE;
+  raw_squares += (code - TRUE_CODE) * (code - TRUE_CODE);
+  raw_count++;
+  return (unsigned int)code;
+}
+
+int main(void) {
+  unsigned int counts;
+  double error, squares = 0.0, sum = 0.0, raw_rms, filtered_rms, bits;
+  int samples = 0;
+
+  sim_adc_input = adc3;
+  sim_run(SIM_SECONDS(SETTLE_SECONDS));
+  for(int s = SETTLE_SECONDS; s < RUN_SECONDS; s++) {
+    sim_run(SIM_SECONDS(1));
+    CHECK(co2_read(&counts));
+    error = counts / 4.0 - TRUE_CODE;     // In 10-bit counts
+    sum += error;
+    squares += error * error;
+    samples++;
+  }
+
+  raw_rms = sqrt(raw_squares / raw_count);
+  filtered_rms = sqrt(squares / samples);
+  bits = log2(raw_rms / filtered_rms);
+  printf("single conversion: %.3f LSB rms; filtered: %.3f LSB rms, %.3f LSB mean error\n",
+         raw_rms, filtered_rms, sum / samples);
+  printf("effective resolution: 10 + %.2f bits\n", bits);
+  printf("ADC interrupts: %.1f per sample, %.1fus of CPU per sample\n",
+         (double)sim_isr_count[ADC_vect] / RUN_SECONDS,
+         sim_isr_cycles[ADC_vect] / 16.0 / RUN_SECONDS);
+  printf("conversions: %lu, %lu ended with the CPU awake\n", sim_adc_conversions, sim_adc_noisy);
+
+  CHECK(bits >= 2.0);
+  CHECK(fabs(sum / samples) < 0.25);
+  CHECK(sim_isr_cycles[ADC_vect] / RUN_SECONDS < SIM_US(50));
+  CHECK(sim_adc_noisy * 10 < sim_adc_conversions);
+  return 0;
+}
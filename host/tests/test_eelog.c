@@ -0,0 +1,171 @@
+/****************************************************************
+  File Name            : "test_eelog.c"
+  Title                : Host Test: EEPROM Sample Log
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Calls the log functions directly, with the EE_READY 
+  interrupt writing the records on the simulated EEPROM.
+  1. Power fails at every byte write of a record, on the
+     first pass, at slot 0 of the second pass, and in the 
+     middle of the second pass. After the next boot the older
+     records are intact and the newest one is either the old
+     or the new record, never a mix.
+  2. The write head is found at boot with fewer EEPROM reads
+     than a scan, and an append returns in a few cycles.
+  3. Years of a record every 5 minutes: reports the worst 
+     cell wear and the years to the 100k cycle endurance.
+  Each record holds values derived from its sequence number,
+  so any mix of two records is detected.
+****************************************************************/
+
+#include <string.h>
+#include "header.h"
+#include "eelog.h"
+#include "test.h"
+
+#define RECORD_SIZE     10
+#define RECORD_WRITES   11          // The mark, 9 data bytes, and the commit
+#define PER_YEAR        (365UL * 24 * 12)
+#define YEARS           5
+#define ENDURANCE       100000UL
+
+static unsigned char eeprom_image[SIM_EEPROM_SIZE];
+
+static void append(unsigned long seq) {
+  CHECK(eelog_append(seq & 0x3FFF, (seq * 3) & 0x3FFF, (seq * 7) & 0x0FFF));
+  sim_advance(SIM_EEPROM_WRITE * (RECORD_WRITES + 1));
+  CHECK(!eelog_busy());
+}
+
+// Sequence number of a record, or -1 if its values do not match one
+static long record_seq(const eelog_record *rec, unsigned long newest) {
+  for(unsigned long seq = newest + 1; seq-- > 0;) {
+    if((rec->rh_raw == (seq & 0x3FFF)) && (rec->temp_raw == ((seq * 3) & 0x3FFF)) &&
+       (rec->co2_counts == ((seq * 7) & 0x0FFF))) {
+      return (long)seq;
+    }
+  }
+  return -1;
+}
+
+// ----- Children: each one starts from reset ----- //
+static void fill(void *arg) {
+  sim_set_irq(1);
+  eelog_init();
+  for(unsigned long seq = 0; seq < (unsigned long)arg; seq++) {
+    append(seq);
+  }
+}
+
+static unsigned long fail_seq;      // Record being written when the power fails
+static unsigned int fail_write;     // Byte write it fails at
+
+static void append_fail(void *arg) {
+  (void)arg;
+  sim_set_irq(1);
+  eelog_init();
+  CHECK(eelog_count == ((fail_seq < EELOG_RECORDS) ? fail_seq : EELOG_RECORDS));
+  sim_power_fail_at = sim_now() + SIM_EEPROM_WRITE * fail_write + SIM_EEPROM_WRITE / 2;
+  append(fail_seq);
+  exit(1);                          // The power did not fail
+}
+
+static void check_log(void *arg) {
+  eelog_record rec;
+  long seq, newest;
+  unsigned int age = 0;
+
+  (void)arg;
+  sim_set_irq(1);
+  eelog_init();
+
+  // ----- Newest record: the old or the new one ----- //
+  CHECK(eelog_read(0, &rec));
+  newest = record_seq(&rec, fail_seq);
+  CHECK((newest == (long)fail_seq) || (newest == (long)fail_seq - 1));
+
+  // ----- All the older records in order ----- //
+  for(age = 1; age < eelog_count; age++) {
+    if(!eelog_read(age, &rec)) {
+      CHECK(newest == (long)fail_seq - 1);          // Only the lost record
+      continue;
+    }
+    seq = record_seq(&rec, fail_seq);
+    CHECK(seq == newest - (long)age);
+  }
+
+  // ----- The log goes on ----- //
+  append(fail_seq + 1);
+  CHECK(eelog_read(0, &rec));
+  CHECK(record_seq(&rec, fail_seq + 1) == (long)fail_seq + 1);
+}
+
+static void power_fail(unsigned long seq) {
+  memset(sim_eeprom, 0xFF, SIM_EEPROM_SIZE);
+  CHECK(sim_fork(fill, (void *)seq) == 0);
+  memcpy(eeprom_image, sim_eeprom, SIM_EEPROM_SIZE);
+
+  fail_seq = seq;
+  for(fail_write = 0; fail_write < RECORD_WRITES; fail_write++) {
+    memcpy(sim_eeprom, eeprom_image, SIM_EEPROM_SIZE);
+    CHECK(sim_fork(append_fail, 0) == SIM_POWER_FAIL);
+    CHECK(sim_fork(check_log, 0) == 0);
+  }
+  printf("power failed at each of the %d writes of record %lu (slot %lu): log recovered\n",
+         RECORD_WRITES, seq, seq % EELOG_RECORDS);
+}
+
+int main(void) {
+  unsigned long worst = 0, least = SIM_EEPROM_SIZE, records = YEARS * PER_YEAR;
+  sim_time start, init_cycles, append_cycles;
+  double worst_per_year;
+
+  // ----- Power failures ----- //
+  power_fail(5);
+  power_fail(EELOG_RECORDS);
+  power_fail(EELOG_RECORDS + 200);
+
+  // ----- Years of logging from an erased EEPROM ----- //
+  memset(sim_eeprom, 0xFF, SIM_EEPROM_SIZE);
+  memset(sim_eeprom_writes, 0, SIM_EEPROM_SIZE * sizeof(unsigned long));
+  sim_set_irq(1);
+  eelog_init();
+  for(unsigned long seq = 0; seq < records; seq++) {
+    if(seq == records / 2) {
+      start = sim_now();
+      CHECK(eelog_append(seq & 0x3FFF, (seq * 3) & 0x3FFF, (seq * 7) & 0x0FFF));
+      append_cycles = sim_now() - start;
+      sim_advance(SIM_EEPROM_WRITE * (RECORD_WRITES + 1));
+      continue;
+    }
+    append(seq);
+  }
+
+  // ----- Boot: find the head ----- //
+  start = sim_now();
+  eelog_init();
+  init_cycles = sim_now() - start;
+  CHECK(eelog_count == EELOG_RECORDS);
+  printf("boot: head found in %llu cycles (a scan reads %d commit bytes, 4 register accesses each)\n",
+         init_cycles, EELOG_RECORDS);
+  CHECK(init_cycles < EELOG_RECORDS * 4);
+  printf("append: %llu cycles, the record is written by EE_READY in %.1f ms\n",
+         append_cycles, (double)SIM_EEPROM_WRITE * RECORD_WRITES * 1000 / SIM_FOSC);
+  CHECK(append_cycles < 100);
+
+  // ----- Wear ----- //
+  for(unsigned int addr = 0; addr < EELOG_RECORDS * RECORD_SIZE; addr++) {
+    worst = (sim_eeprom_writes[addr] > worst) ? sim_eeprom_writes[addr] : worst;
+    least = (sim_eeprom_writes[addr] < least) ? sim_eeprom_writes[addr] : least;
+  }
+  worst_per_year = (double)worst / YEARS;
+  printf("%d years, %lu records: worst cell %lu writes, least %lu (%.0f years to %lu cycles)\n",
+         YEARS, records, worst, least, ENDURANCE / worst_per_year, ENDURANCE);
+  CHECK(worst <= 2 * (records / EELOG_RECORDS + 1));    // The commit byte, twice per pass
+  CHECK(least >= records / EELOG_RECORDS);              // Every cell used
+  CHECK(ENDURANCE / worst_per_year > 190);          // As documented in eelog.c
+  return 0;
+}
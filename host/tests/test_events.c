@@ -0,0 +1,86 @@
+/****************************************************************
+  File Name            : "test_events.c"
+  Title                : Host Test: Event Latency
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Injects key presses interleaved with the 1Hz ticks for a
+  minute, at offsets that sweep the whole second, and reports
+  the worst case duration of the interrupts that post events
+  and the worst case latency of each event type, from the
+  post to the main loop. No event may be lost.
+  The latency is measured by events.c with Timer3, which
+  stops in Power-down: it is the time the CPU is running,
+  from the wake-up to the event handler.
+****************************************************************/
+
+#include "header.h"
+#include "events.h"
+#include "keypad.h"
+#include "test.h"
+
+#define RUN_SECONDS     60
+#define PRESSES         50
+#define NO_KEY          0xFF
+
+static const char *const event_names[ev_count] = {
+  "key", "tick", "alarm0", "alarm1", "humidicon", "timeout", "lcd"
+};
+
+static void key(void *arg) {
+  // co2 (CO2 page), back (idle), eight (error message), none (the
+  // message times out), zero (sensor page)
+  static const unsigned char positions[5] = {1, 4, 6, NO_KEY, 2};
+  static unsigned int presses;
+  int down = (arg != 0);
+
+  if(positions[presses % 5] != NO_KEY) {
+    keypad_model_set(positions[presses % 5], down);
+  }
+  if(!down) {
+    presses++;
+  }
+}
+
+int main(void) {
+  // ----- A press every 1.037s, held 80ms: all offsets to the tick ----- //
+  for(int i = 0; i < PRESSES; i++) {
+    sim_time at = SIM_SECONDS(2) + (sim_time)i * SIM_MS(1037);
+
+    sim_at(at, key, (void *)1);
+    sim_at(at + SIM_MS(80), key, 0);
+  }
+  sim_run(SIM_SECONDS(1));
+  sim_irq_off_max = 0;                  // Interrupts are off during the power-on initialization
+  sim_run(SIM_SECONDS(RUN_SECONDS - 1));
+
+  printf("%-10s %6s %12s\n", "event", "count", "latency max");
+  for(int t = 0; t < ev_count; t++) {
+    printf("%-10s %6u %10.1fus\n", event_names[t], event_counts[t], event_latency_max[t] / 2.0);
+  }
+  printf("ISR worst case: tick %llu, key %llu, key scan %llu, humidicon %llu cycles\n",
+         sim_isr_max[INT1_vect], sim_isr_max[INT0_vect], sim_isr_max[TIMER2_COMP_vect],
+         sim_isr_max[TIMER1_COMPA_vect]);
+  printf("interrupts off at most %llu cycles, %u events dropped\n", sim_irq_off_max, events_dropped);
+
+  CHECK(events_dropped == 0);
+  CHECK(keypad_dropped == 0);
+  CHECK(event_counts[ev_tick] >= RUN_SECONDS - 1);
+  CHECK(event_counts[ev_key] >= 2 * PRESSES * 4 / 5);     // A press and a release each
+  CHECK(sim_isr_count[INT0_vect] >= PRESSES * 4 / 5);
+  CHECK(event_counts[ev_timeout] >= PRESSES / 5);
+
+  // ----- ISRs only post events ----- //
+  CHECK(sim_isr_max[INT1_vect] < 100);
+  CHECK(sim_isr_max[INT0_vect] < 100);
+  CHECK(sim_isr_max[TIMER2_COMP_vect] < 200);
+  CHECK(sim_irq_off_max < 200);
+
+  // ----- The main loop gets every event within 5ms ----- //
+  for(int t = 0; t < ev_count; t++) {
+    CHECK(event_latency_max[t] < 2 * 5000);
+  }
+  return 0;
+}
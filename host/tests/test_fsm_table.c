@@ -0,0 +1,153 @@
+/****************************************************************
+  File Name            : "test_fsm_table.c"
+  Title                : Host Test: Dense FSM Table
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Checks the dense [state][key] table of fsm_ui.c against the
+  linear search of the per-state arrays it replaced, for
+  every state and key, and compares the cost of a dispatch:
+  the rows the search reads against one table cell, and the
+  simulated cycles fsm() adds to its task function.
+****************************************************************/
+
+#include "header.h"
+#include "FSM.h"
+#include "test.h"
+
+typedef void (* task_fn_ptr) (key keyVal);
+
+// Layout of a cell of fsm_table (fsm_ui.c)
+typedef struct {
+  state next_state;
+  task_fn_ptr tf_ptr;
+} transition;
+
+extern const transition fsm_table[state_count][eol + 1];
+
+// ----- The per-state arrays searched by the old fsm() ----- //
+typedef struct {
+  key keyval;
+  state next_state;
+  task_fn_ptr tf_ptr;
+} search_row;
+
+static const search_row idle_rows[] = {
+  {setTime,   changeTime,   changeTime_fn},
+  {setAlarm0, changeAlarm0, changeAlarm0_fn},
+  {co2,       dispCO2,      dispCO2_fn},
+  {del,       diag,         diag_fn},
+  {zero,      idle,         sensor_fn},
+  {one,       idle,         sensor_fn},
+  {two,       idle,         sensor_fn},
+  {three,     idle,         sensor_fn},
+  {four,      idle,         sensor_fn},
+  {five,      idle,         sensor_fn},
+  {six,       idle,         sensor_fn},
+  {seven,     idle,         sensor_fn},
+  {eol,       idle,         error_fn}
+};
+
+static const search_row changeTime_rows[] = {
+  {zero,      changeTime,   changeTime_fn},
+  {one,       changeTime,   changeTime_fn},
+  {two,       changeTime,   changeTime_fn},
+  {three,     changeTime,   changeTime_fn},
+  {four,      changeTime,   changeTime_fn},
+  {five,      changeTime,   changeTime_fn},
+  {six,       changeTime,   changeTime_fn},
+  {seven,     changeTime,   changeTime_fn},
+  {eight,     changeTime,   changeTime_fn},
+  {nine,      changeTime,   changeTime_fn},
+  {back,      idle,         idle_fn},
+  {del,       changeTime,   back_fn},
+  {eol,       changeTime,   error_fn}
+};
+
+static const search_row changeAlarm0_rows[] = {
+  {zero,      changeAlarm0, changeAlarm0_fn},
+  {one,       changeAlarm0, changeAlarm0_fn},
+  {two,       changeAlarm0, changeAlarm0_fn},
+  {three,     changeAlarm0, changeAlarm0_fn},
+  {four,      changeAlarm0, changeAlarm0_fn},
+  {five,      changeAlarm0, changeAlarm0_fn},
+  {six,       changeAlarm0, changeAlarm0_fn},
+  {seven,     changeAlarm0, changeAlarm0_fn},
+  {eight,     changeAlarm0, changeAlarm0_fn},
+  {nine,      changeAlarm0, changeAlarm0_fn},
+  {back,      idle,         idle_fn},
+  {del,       changeAlarm0, back_fn},
+  {eol,       changeAlarm0, error_fn}
+};
+
+static const search_row dispCO2_rows[] = {
+  {back,      idle,         idle_fn},
+  {eol,       dispCO2,      error_fn}
+};
+
+static const search_row diag_rows[] = {
+  {back,      idle,         idle_fn},
+  {eol,       diag,         diag_fn}
+};
+
+static const search_row *const search_tables[state_count] = {
+  idle_rows, changeTime_rows, changeAlarm0_rows, dispCO2_rows, diag_rows
+};
+
+/*************************************************************
+ Function             : static const search_row *search(
+                        state ps, key keyval, int *rows)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : Linux host (gcc)
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The search of the old fsm(). rows is the number of rows
+ it read.
+*************************************************************/
+static const search_row *search(state ps, key keyval, int *rows) {
+  int i;
+
+  for(i = 0; (search_tables[ps][i].keyval != keyval) && (search_tables[ps][i].keyval != eol); i++);
+  *rows = i + 1;
+  return &search_tables[ps][i];
+}
+
+int main(void) {
+  int rows, worst_rows = 0;
+  unsigned long total_rows = 0, pairs = 0;
+  sim_time start;
+
+  // ----- Same transition for every state and key ----- //
+  for(int ps = 0; ps < state_count; ps++) {
+    for(int k = 0; k <= eol; k++) {
+      const search_row *old_row = search((state)ps, (key)k, &rows);
+      const transition *cell = &fsm_table[ps][k];
+
+      CHECK(cell->next_state == old_row->next_state);
+      CHECK(cell->tf_ptr == old_row->tf_ptr);
+      total_rows += rows;
+      pairs++;
+      if(rows > worst_rows) {
+        worst_rows = rows;
+      }
+    }
+  }
+
+  // ----- Dispatch cost ----- //
+  // changeTime, back calls idle_fn, which does nothing: the cycles
+  // counted are those of fsm() alone.
+  start = sim_now();
+  fsm(changeTime, back);
+  CHECK(present_state == idle);
+  CHECK(sim_now() - start == 0);
+
+  printf("%lu state/key pairs match\n", pairs);
+  printf("old search: %.2f rows read on average, %d worst case; dense table: 1 cell\n",
+         (double)total_rows / pairs, worst_rows);
+  printf("fsm() dispatch: %llu simulated cycles besides the task function\n", sim_now() - start);
+  CHECK(worst_rows == 13);
+  return 0;
+}
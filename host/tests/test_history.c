@@ -0,0 +1,111 @@
+/****************************************************************
+  File Name            : "test_history.c"
+  Title                : Host Test: Sensor History
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Adds 2000 samples (the sample numbers wrap around 256 and
+  the window many times) in random, rising, falling, and
+  constant runs, with the extreme codes of each channel.
+  After every sample the snapshot and every sample of the
+  window are checked against a plain copy of the last
+  HISTORY_SIZE samples. Reports the SRAM footprint on the
+  target from the packed layout of history.c.
+****************************************************************/
+
+#include "header.h"
+#include "history.h"
+#include "test.h"
+
+#define SAMPLES         2000
+
+static const unsigned int channel_max[hist_channels] = {0x3FFF, 0x3FFF, 0x0FFF};
+
+static unsigned int window[HISTORY_SIZE][hist_channels];
+static unsigned int window_stamp[HISTORY_SIZE];
+static unsigned long noise_state = 11;
+
+static unsigned int random_value(unsigned int max) {
+  noise_state = noise_state * 1103515245UL + 12345UL;
+  return (unsigned int)((noise_state >> 8) % (max + 1));
+}
+
+// Value of a channel for sample n: runs of 100 samples of each pattern
+static unsigned int pattern(unsigned long n, int ch) {
+  unsigned int max = channel_max[ch];
+
+  switch((n / 100) % 5) {
+    case 0:  return random_value(max);
+    case 1:  return (unsigned int)((n % 100) * (max / 99));                 // Rising, up to max
+    case 2:  return (unsigned int)(max - (n % 100) * (max / 99));           // Falling, down to 0 or so
+    case 3:  return 1000 + ch;                                              // Constant
+    default: return (n & 1) ? max : 0;                                      // Extremes
+  }
+}
+
+int main(void) {
+  hist_snapshot snap;
+  unsigned int stamp, values[hist_channels];
+  unsigned long target_bytes;
+
+  history_snapshot(&snap);
+  CHECK(snap.count == 0);
+  CHECK(!history_sample(0, &stamp, values));
+
+  for(unsigned long n = 0; n < SAMPLES; n++) {
+    unsigned int slot = n % HISTORY_SIZE;
+    unsigned int count = (n + 1 < HISTORY_SIZE) ? n + 1 : HISTORY_SIZE;
+
+    for(int ch = 0; ch < hist_channels; ch++) {
+      window[slot][ch] = pattern(n, ch);
+    }
+    window_stamp[slot] = (unsigned int)(n * 7) & 0xFFFF;
+    history_add(window_stamp[slot], window[slot][hist_rh], window[slot][hist_temp], window[slot][hist_co2]);
+
+    // ----- Window statistics ----- //
+    history_snapshot(&snap);
+    CHECK(snap.count == count);
+    CHECK(snap.newest_stamp == window_stamp[slot]);
+    for(int ch = 0; ch < hist_channels; ch++) {
+      unsigned long sum = 0;
+      unsigned int min = 0xFFFF, max = 0;
+
+      for(unsigned int i = 0; i < count; i++) {
+        unsigned int v = window[(n - i) % HISTORY_SIZE][ch];
+
+        sum += v;
+        min = (v < min) ? v : min;
+        max = (v > max) ? v : max;
+      }
+      CHECK(snap.channel[ch].sum == sum);
+      CHECK(snap.channel[ch].min == min);
+      CHECK(snap.channel[ch].max == max);
+    }
+
+    // ----- Every sample of the window ----- //
+    for(unsigned int age = 0; age < count; age++) {
+      unsigned int old_slot = (n - age) % HISTORY_SIZE;
+
+      CHECK(history_sample(age, &stamp, values));
+      CHECK(stamp == window_stamp[old_slot]);
+      for(int ch = 0; ch < hist_channels; ch++) {
+        CHECK(values[ch] == window[old_slot][ch]);
+      }
+    }
+    CHECK(!history_sample(count, &stamp, values));
+  }
+
+  // ----- Target SRAM: 2-byte int, 4-byte long, no padding ----- //
+  target_bytes = (2 + 5) * HISTORY_SIZE                        // Packed samples
+               + 2 * hist_channels * (HISTORY_SIZE + 2)         // Min and max queues
+               + (1 + 2 + hist_channels * (4 + 2 + 2))          // Running statistics
+               + 2;                                             // Sample number and count
+  printf("%d samples checked, window of %d: %lu bytes of SRAM on the target "
+         "(%lu unpacked with 16-bit codes)\n", SAMPLES, HISTORY_SIZE, target_bytes,
+         target_bytes + (8 - 5) * HISTORY_SIZE);
+  CHECK(target_bytes == 873);                                   // As documented in history.c
+  CHECK(HISTORY_SIZE * (unsigned long)channel_max[hist_rh] < 0xFFFFFFFFUL);   // Sum fits a target long
+  return 0;
+}
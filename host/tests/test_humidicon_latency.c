@@ -0,0 +1,88 @@
+/****************************************************************
+  File Name            : "test_humidicon_latency.c"
+  Title                : Host Test: Humidicon Read Latency
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Runs 30 seconds with the humidity and temperature changing
+  every second, so a measurement is started on every tick.
+  Checks that:
+  - every fetch comes after its 36.65ms conversion, so no
+    fetch waits or gets stale data, and reports how long
+    after the conversion the data is read.
+  - the tick handler (display_time probe) never waits for
+    the sensor.
+  - a fetch of data already fetched is detected with the
+    status bits and keeps the last values.
+****************************************************************/
+
+#include "header.h"
+#include "humidicon.h"
+#include "profile.h"
+#include "test.h"
+
+#define RUN_SECONDS     30
+
+static sim_time fetched_done;           // Conversion whose data was read
+static sim_time fetch_delay_max;
+static unsigned long fetches_traced;
+
+static void trace(const sim_spi_byte *b) {
+  sim_time done = humidicon_model_done[0];
+
+  if(!(b->selected & (1u << sim_spi_humidicon)) || (done == fetched_done) || (b->start < done)) {
+    return;
+  }
+  // First byte after a conversion ended: the fetch
+  fetched_done = done;
+  fetches_traced++;
+  if(b->start - done > fetch_delay_max) {
+    fetch_delay_max = b->start - done;
+  }
+}
+
+static void change(void *arg) {
+  unsigned long second = (unsigned long)arg;
+
+  humidicon_model_set(0, 0x2000 + 64 * (second % 5), 0x1800 + 48 * (second % 3));
+}
+
+int main(void) {
+  prof_stats tick;
+  unsigned int rh, temp, rh_after, temp_after;
+
+  sim_spi_trace = trace;
+  change(0);
+  for(unsigned long s = 1; s < RUN_SECONDS; s++) {
+    sim_at(SIM_SECONDS(s) + SIM_MS(250), change, (void *)s);
+  }
+  sim_run(SIM_SECONDS(RUN_SECONDS));
+  prof_read(prof_display_time, &tick);
+
+  printf("%lu requests, %lu fetches, %lu stale\n", humidicon_model_requests[0],
+         humidicon_model_fetches[0], humidicon_model_stale[0]);
+  printf("data read %.2fms after the conversion at worst (conversion %.2fms)\n",
+         fetch_delay_max / 16000.0, SIM_HUMIDICON_MEASURE / 16000.0);
+  printf("tick handler: %.1fus worst, %.1fus average\n", tick.max / 2.0,
+         tick.count ? tick.total / 2.0 / tick.count : 0.0);
+
+  CHECK(humidicon_model_requests[0] >= RUN_SECONDS - 2);
+  CHECK(humidicon_model_stale[0] == 0);
+  CHECK(humidicon_stale_count == 0);
+  CHECK(fetches_traced == humidicon_model_fetches[0]);
+  CHECK(fetch_delay_max < SIM_MS(2));                 // Power-down wake-up and the main loop
+  CHECK(tick.count >= RUN_SECONDS - 2);
+  CHECK(tick.max / 2 < 1000);                          // Well below the conversion time
+
+  // ----- Data already fetched ----- //
+  humidicon_raw(&rh, &temp);
+  sim_wake();
+  CHECK(!fetch_humidicon());
+  humidicon_raw(&rh_after, &temp_after);
+  CHECK(humidicon_status == 0x01);
+  CHECK(humidicon_stale_count == 1);
+  CHECK((rh_after == rh) && (temp_after == temp));
+  return 0;
+}
@@ -0,0 +1,121 @@
+/****************************************************************
+  File Name            : "test_humidicon_round.c"
+  Title                : Host Test: Humidicon Round with 8 Sensors
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Built with HUMIDICON_COUNT = 8 (plant_host8). Runs 20 seconds
+  with the values of all 8 sensor models changing every second,
+  so a round is started on every tick, and traces the Humidicon
+  bytes on the SPI bus. A round starts with the first 
+  measurement request and ends with the last byte fetched.
+  Reports the acquisition time per round, which must be about
+  one conversion (36.65ms) instead of 8, and checks that every
+  sensor was requested and fetched once per round and read 
+  with its own values. Then shows the page of sensor 3.
+****************************************************************/
+
+#include "header.h"
+#include "humidicon.h"
+#include <string.h>
+#include "test.h"
+
+#define RUN_SECONDS     20
+#define ROUND_GAP       SIM_MS(100)     // Rounds are a second apart
+
+static sim_time round_start, round_end, round_max, round_min = SIM_NEVER, round_total;
+static sim_time spi_round, spi_max;     // Humidicon bytes on the bus in a round
+static unsigned int rounds;
+
+static void end_round(void) {
+  sim_time t = round_end - round_start;
+
+  if(round_end == 0) {
+    return;
+  }
+  rounds++;
+  round_total += t;
+  round_max = (t > round_max) ? t : round_max;
+  round_min = (t < round_min) ? t : round_min;
+  spi_max = (spi_round > spi_max) ? spi_round : spi_max;
+}
+
+static void trace(const sim_spi_byte *b) {
+  sim_time length = SIM_FOSC * 8 / b->sclk;
+
+  if(!(b->selected & (((1u << SIM_HUMIDICONS) - 1) << sim_spi_humidicon))) {
+    return;
+  }
+  if(b->start > round_end + ROUND_GAP) {
+    end_round();
+    round_start = b->start;
+    spi_round = 0;
+  }
+  round_end = b->start + length;
+  spi_round += length;
+}
+
+// Values of sensor n in second s
+static unsigned int rh_raw(unsigned char n, int s) {
+  return 0x1000 + n * 0x300 + s * 7;
+}
+
+static unsigned int temp_raw(unsigned char n, int s) {
+  return 0x1800 + n * 0x100 + s * 5;
+}
+
+int main(void) {
+  unsigned int rh, temp;
+  char line[17];
+
+  for(unsigned char n = 0; n < SIM_HUMIDICONS; n++) {
+    humidicon_model_set(n, rh_raw(n, 0), temp_raw(n, 0));
+  }
+  sim_run(SIM_SECONDS(1));
+  sim_spi_trace = trace;
+  for(int s = 1; s <= RUN_SECONDS; s++) {
+    for(unsigned char n = 0; n < SIM_HUMIDICONS; n++) {
+      humidicon_model_set(n, rh_raw(n, s), temp_raw(n, s));
+    }
+    sim_run(SIM_SECONDS(1));
+  }
+  sim_spi_trace = 0;
+  end_round();
+
+  printf("%u rounds of %d sensors: %.2f->%.2fms (average %.2fms), SPI %.1fus per round, "
+         "%.2fms one after the other\n", rounds, HUMIDICON_COUNT, (double)round_min / SIM_MS(1),
+         (double)round_max / SIM_MS(1), (double)round_total / rounds / SIM_MS(1),
+         (double)spi_max / SIM_US(1), HUMIDICON_COUNT * (double)SIM_HUMIDICON_MEASURE / SIM_MS(1));
+
+  // ----- One conversion time per round, not 8 ----- //
+  CHECK(HUMIDICON_COUNT == SIM_HUMIDICONS);
+  CHECK(rounds >= RUN_SECONDS - 1);
+  CHECK(round_min >= SIM_HUMIDICON_MEASURE);
+  CHECK(round_max < SIM_HUMIDICON_MEASURE + SIM_MS(5));
+  CHECK(humidicon_model_mode_errors == 0);
+
+  // ----- Every sensor requested and fetched with its own values ----- //
+  for(unsigned char n = 0; n < SIM_HUMIDICONS; n++) {
+    humidicon_sensor_raw(n, &rh, &temp);
+    printf("sensor %u: %lu requests, %lu fetches, %lu stale, raw %04X %04X\n", n,
+           humidicon_model_requests[n], humidicon_model_fetches[n], humidicon_model_stale[n], rh, temp);
+    CHECK(humidicon_model_requests[n] == humidicon_model_requests[0]);
+    CHECK(humidicon_model_fetches[n] == humidicon_model_fetches[0]);
+    CHECK(humidicon_model_stale[n] == 0);
+    CHECK((rh == rh_raw(n, RUN_SECONDS)) && (temp == temp_raw(n, RUN_SECONDS)));
+  }
+
+  // ----- Page of sensor 3 ----- //
+  keypad_model_set(13, 1);              // three
+  sim_run(SIM_MS(100));
+  keypad_model_set(13, 0);
+  sim_run(SIM_SECONDS(1));
+  for(unsigned char l = 0; l < 3; l++) {
+    dog163_line(l, line);
+    printf("[%s]\n", line);
+  }
+  CHECK((strncmp(line, "RH:", 3) == 0) && (strstr(line, " S3") != 0));
+  return 0;
+}
@@ -0,0 +1,148 @@
+/****************************************************************
+  File Name            : "test_keypad.c"
+  Title                : Host Test: Keypad Debouncing
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Plays scripted switch waveforms on the keypad model: a clean
+  press, short and long contact bounce on the press and on the
+  release, and chatter while the key is held. Each one is
+  played 10 times at offsets that step 1.03ms, alternating co2
+  and back, and must give exactly one press and one release, with
+  the FSM on the page of the key.
+  A 3ms glitch must give no key at all.
+  Reports the detection latency (first contact to the press in
+  the key FIFO, polled every 0.5ms) and the time spent in the
+  INT0 and Timer2 interrupts per keypress.
+****************************************************************/
+
+#include "header.h"
+#include "events.h"
+#include "keypad.h"
+#include "FSM.h"
+#include "test.h"
+
+#define POS_CO2         1
+#define POS_BACK        4
+#define OFFSETS         10
+#define LATENCY_MAX     SIM_MS(60)
+
+// A level change of the switch, in us from the first contact
+typedef struct {
+  unsigned int us;
+  unsigned char down;
+} edge;
+
+typedef struct {
+  const char *name;
+  const edge *edges;
+  unsigned int count;
+} waveform;
+
+static const edge clean[] = {{0, 1}, {120000, 0}};
+static const edge bounce_short[] = {
+  {0, 1}, {300, 0}, {700, 1}, {1100, 0}, {1600, 1},
+  {120000, 0}, {120400, 1}, {120900, 0}
+};
+static const edge bounce_long[] = {
+  {0, 1}, {1000, 0}, {2500, 1}, {4000, 0}, {6000, 1}, {7000, 0}, {9500, 1},
+  {150000, 0}, {152000, 1}, {154000, 0}, {157000, 1}, {158000, 0}
+};
+static const edge chatter[] = {
+  {0, 1}, {50000, 0}, {50300, 1}, {90000, 0}, {90800, 1}, {130000, 0}
+};
+static const edge glitch[] = {{0, 1}, {3000, 0}};
+
+#define WAVE(w) {#w, w, sizeof(w) / sizeof(w[0])}
+
+static const waveform waves[] = {
+  WAVE(clean), WAVE(bounce_short), WAVE(bounce_long), WAVE(chatter)
+};
+
+static unsigned char position;
+
+static void set_key(void *arg) {
+  keypad_model_set(position, arg != 0);
+}
+
+// Schedules a waveform at start
+static void play(const edge *edges, unsigned int count, sim_time start) {
+  for(unsigned int i = 0; i < count; i++) {
+    sim_at(start + SIM_US(edges[i].us), set_key, edges[i].down ? (void *)1 : 0);
+  }
+}
+
+// ISR time of the keypad so far
+static sim_time isr_cycles(void) {
+  return sim_isr_cycles[INT0_vect] + sim_isr_cycles[TIMER2_COMP_vect];
+}
+
+int main(void) {
+  sim_time latency_max = 0, latency_min = SIM_NEVER, latency_total = 0, isr_max = 0, isr_total = 0;
+  unsigned int presses = 0;
+
+  humidicon_model_set(0, 0x2000, 0x1800);
+  sim_run(SIM_SECONDS(2));
+  printf("%-13s %8s %8s %10s\n", "waveform", "average", "max", "ISR/press");
+
+  for(unsigned int w = 0; w < sizeof(waves) / sizeof(waves[0]); w++) {
+    sim_time wave_max = 0, wave_total = 0, wave_isr = 0;
+
+    for(unsigned int i = 0; i < OFFSETS; i++) {
+      unsigned int keys = event_counts[ev_key];
+      unsigned long int0 = sim_isr_count[INT0_vect];
+      sim_time start = sim_now() + SIM_MS(100) + (sim_time)i * SIM_US(1030), isr = isr_cycles(), latency;
+
+      position = (presses & 1) ? POS_BACK : POS_CO2;
+      play(waves[w].edges, waves[w].count, start);
+      sim_run(start - sim_now());
+      while(event_counts[ev_key] == keys) {
+        sim_run(SIM_US(500));
+        CHECK(sim_now() - start < SIM_MS(200));
+      }
+      latency = sim_now() - start;
+      sim_run(SIM_MS(400));
+
+      // ----- One press and one release, INT0 once ----- //
+      CHECK(event_counts[ev_key] - keys == 2);
+      CHECK(sim_isr_count[INT0_vect] - int0 == 1);
+      CHECK(present_state == ((presses & 1) ? idle : dispCO2));
+      presses++;
+
+      isr = isr_cycles() - isr;
+      wave_isr += isr;
+      isr_total += isr;
+      isr_max = (isr > isr_max) ? isr : isr_max;
+      latency_total += latency;
+      wave_total += latency;
+      wave_max = (latency > wave_max) ? latency : wave_max;
+      latency_min = (latency < latency_min) ? latency : latency_min;
+    }
+    printf("%-13s %6.1fms %6.1fms %8llu cy\n", waves[w].name, (double)wave_total / OFFSETS / SIM_MS(1), (double)wave_max / SIM_MS(1),
+           wave_isr / OFFSETS);
+    latency_max = (wave_max > latency_max) ? wave_max : latency_max;
+  }
+
+  // ----- A glitch is not a key ----- //
+  {
+    unsigned int keys = event_counts[ev_key];
+
+    position = POS_CO2;
+    play(glitch, sizeof(glitch) / sizeof(glitch[0]), sim_now() + SIM_MS(100));
+    sim_run(SIM_MS(500));
+    CHECK(event_counts[ev_key] == keys);
+    CHECK(present_state == idle);
+  }
+
+  printf("%u presses: latency %.1f->%.1fms (average %.1fms), ISR %llu cycles per press "
+         "(max %llu, %.1fus)\n", presses, (double)latency_min / SIM_MS(1), (double)latency_max / SIM_MS(1),
+         (double)latency_total / presses / SIM_MS(1), isr_total / presses, isr_max,
+         (double)isr_max / SIM_US(1));
+  CHECK(latency_max <= LATENCY_MAX);
+  CHECK(isr_max < 2000);
+  CHECK(keypad_dropped == 0);
+  CHECK(events_dropped == 0);
+  return 0;
+}
@@ -0,0 +1,116 @@
+/****************************************************************
+  File Name            : "test_lcd_day.c"
+  Title                : Host Test: A Day of LCD Frames
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Replays the 86400 idle frames of a day (clock, temperature
+  and RH drifting with sensor noise), written with the
+  lcd_put functions of the view, and reports the SPI bytes
+  and bus time of each changed-run refresh against the full
+  refresh (DDRAM address set and 48 data bytes).
+****************************************************************/
+
+#include <string.h>
+#include "header.h"
+#include "lcd.h"
+#include "test.h"
+
+#define FULL_BYTES      (1 + 48)
+#define DAY             86400UL
+
+static unsigned long noise_state = 12345;
+
+// Deterministic noise of +/- range
+static int noise(int range) {
+  noise_state = noise_state * 1103515245UL + 12345UL;
+  return (int)((noise_state >> 16) % (2 * range + 1)) - range;
+}
+
+// Triangle wave of a day, -amplitude at midnight and +amplitude at noon
+static int diurnal(unsigned long second, int amplitude) {
+  long phase = (long)(second % DAY) - (long)(DAY / 2);
+
+  if(phase < 0) {
+    phase = -phase;
+  }
+  return (int)(amplitude - 2L * amplitude * phase / (long)(DAY / 2));
+}
+
+static void frame(unsigned long second) {
+  lcd_puts("\fTime: ");
+  lcd_put_2digits(second / 3600);
+  putchar(':');
+  lcd_put_2digits((second / 60) % 60);
+  putchar(':');
+  lcd_put_2digits(second % 60);
+  lcd_puts("\nTemp: ");
+  lcd_put_fixed(2300 + diurnal(second, 400) + noise(3), 2);
+  putchar(0xDF);
+  putchar('C');
+  lcd_puts("\nRH:   ");
+  lcd_put_fixed(5500 - diurnal(second, 1200) + noise(5), 2);
+  putchar('%');
+}
+
+int main(void) {
+  unsigned long bytes, total_bytes = 0, max_bytes = 0;
+  sim_time start, bus, total_bus = 0, max_bus = 0, full_bus;
+
+  sim_run(SIM_SECONDS(1));
+
+  // ----- Full refresh of the first frame for reference ----- //
+  invalidate_lcd_dog();
+  memset(dsp_buff_1, '#', 16);
+  memset(dsp_buff_2, '#', 16);
+  memset(dsp_buff_3, '#', 16);
+  update_lcd_dog();
+  while(!lcd_tx_done) {
+    sim_advance(SIM_US(10));
+  }
+  frame(0);
+  sim_wake();
+  start = sim_now();
+  update_lcd_dog();
+  while(!lcd_tx_done) {
+    sim_advance(SIM_US(10));
+  }
+  full_bus = sim_now() - start;
+
+  // ----- The next frames of the day ----- //
+  for(unsigned long second = 1; second < DAY; second++) {
+    bytes = sim_spi_bytes[sim_spi_lcd];
+    frame(second);
+    sim_wake();
+    start = sim_now();
+    update_lcd_dog();
+    while(!lcd_tx_done) {
+      sim_advance(SIM_US(10));
+    }
+    bus = sim_now() - start;
+    bytes = sim_spi_bytes[sim_spi_lcd] - bytes;
+
+    total_bytes += bytes;
+    total_bus += bus;
+    if(bytes > max_bytes) {
+      max_bytes = bytes;
+    }
+    if(bus > max_bus) {
+      max_bus = bus;
+    }
+  }
+
+  printf("full refresh:    %d bytes, %.3fms on the bus\n", FULL_BYTES, full_bus / 16000.0);
+  printf("changed runs:    %.2f bytes, %.3fms on the bus per frame on average\n",
+         (double)total_bytes / (DAY - 1), total_bus / 16000.0 / (DAY - 1));
+  printf("worst frame:     %lu bytes, %.3fms on the bus\n", max_bytes, max_bus / 16000.0);
+  printf("bytes in a day:  %lu (full refresh: %lu)\n", total_bytes, FULL_BYTES * (DAY - 1));
+
+  CHECK(max_bytes < FULL_BYTES);
+  CHECK(total_bytes * 4 < FULL_BYTES * (DAY - 1));    // Less than a quarter of the full refresh
+  CHECK(dog163_busy_violations == 0);
+  CHECK(sim_spi_conflicts == 0);
+  return 0;
+}
@@ -0,0 +1,111 @@
+/****************************************************************
+  File Name            : "test_lcd_format.c"
+  Title                : Host Test: LCD Number Formatting
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Checks the lcd_put functions byte for byte against the 
+  printf output they replace, over the 16-bit range of the
+  target's int:
+   lcd_put_uint(v, w)     "%0*u"
+   lcd_put_fixed(v, d)    "%.*f" of v / 10^d
+   lcd_put_2digits(v)     "%02u", "--" above 99
+  Then times each against printf on the host (a rough guide,
+  the target is not timed).
+****************************************************************/
+
+#include <string.h>
+#include <time.h>
+#include "header.h"
+#include "lcd.h"
+#include "test.h"
+
+#define BENCH_CALLS     200000
+
+extern int sim_printf(const char *format, ...);    // printf of the firmware
+
+static const double scale[5] = {1.0, 10.0, 100.0, 1000.0, 10000.0};
+
+// Characters put since the last form feed
+static void shown(char text[17]) {
+  int n = 16;
+
+  memcpy(text, dsp_buff_1, 16);
+  while((n > 0) && (text[n - 1] == ' ')) {
+    n--;
+  }
+  text[n] = '\0';
+}
+
+static double seconds(void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main(void) {
+  char text[17], expected[32];
+  unsigned long checked = 0;
+  double start, put_time, printf_time;
+
+  // ----- lcd_put_uint ----- //
+  for(unsigned long v = 0; v <= 65535; v++) {
+    for(unsigned char width = 0; width <= 6; width++) {
+      putchar('\f');
+      lcd_put_uint((unsigned int)v, width);
+      shown(text);
+      snprintf(expected, sizeof(expected), "%0*lu", width, v);
+      CHECK(strcmp(text, expected) == 0);
+      checked++;
+    }
+  }
+
+  // ----- lcd_put_fixed ----- //
+  for(long v = -32767; v <= 32767; v++) {
+    for(unsigned char d = 0; d <= 4; d++) {
+      putchar('\f');
+      lcd_put_fixed((int)v, d);
+      shown(text);
+      snprintf(expected, sizeof(expected), "%.*f", d, v / scale[d]);
+      CHECK(strcmp(text, expected) == 0);
+      checked++;
+    }
+  }
+
+  // ----- lcd_put_2digits ----- //
+  for(unsigned int v = 0; v <= 255; v++) {
+    putchar('\f');
+    lcd_put_2digits((unsigned char)v);
+    shown(text);
+    if(v <= 99) {
+      snprintf(expected, sizeof(expected), "%02u", v);
+    } else {
+      strcpy(expected, "--");
+    }
+    CHECK(strcmp(text, expected) == 0);
+    checked++;
+  }
+  printf("%lu values match printf\n", checked);
+
+  // ----- Host timing of a temperature field ----- //
+  start = seconds();
+  for(int i = 0; i < BENCH_CALLS; i++) {
+    putchar('\f');
+    lcd_put_fixed(2345 + (i & 0xFF), 2);
+  }
+  put_time = seconds() - start;
+  start = seconds();
+  for(int i = 0; i < BENCH_CALLS; i++) {
+    int v = 2345 + (i & 0xFF);
+
+    putchar('\f');
+    sim_printf("%d.%02d", v / 100, v % 100);
+  }
+  printf_time = seconds() - start;
+  printf("host: lcd_put_fixed %.0fns, printf %.0fns per call\n",
+         put_time * 1e9 / BENCH_CALLS, printf_time * 1e9 / BENCH_CALLS);
+  return 0;
+}
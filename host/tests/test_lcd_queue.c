@@ -0,0 +1,189 @@
+/****************************************************************
+  File Name            : "test_lcd_queue.c"
+  Title                : Host Test: Blocking vs Queued LCD
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  CPU time per frame of an hour of idle frames, sent:
+  - blocking, like update_lcd_dog before the queue: each
+    byte of the changed runs, then a 30us delay.
+  - queued: update_lcd_dog plus the lcd_tx_ISR calls that
+    drain the queue.
+  Then two full frames back to back overflow the queue: once
+  it drains, ev_lcd must be posted and the deferred run sent
+  by the next update_lcd_dog (called here like the main loop
+  does), with a single completion callback at the end.
+****************************************************************/
+
+#include <string.h>
+#include "header.h"
+#include "lcd.h"
+#include "spi_bus.h"
+#include "events.h"
+#include "test.h"
+
+#define HOUR            3600UL
+#define LCD_CHARS       48
+
+extern void lcd_spi_transmit_CMD(char command);
+extern void lcd_spi_transmit_DATA(char data);
+
+static char shown[LCD_CHARS];           // DDRAM of the blocking refresh
+static unsigned int callbacks;
+static unsigned int lcd_events;
+
+static void tx_done(void) {
+  callbacks++;
+}
+
+static char *const lines[3] = {dsp_buff_1, dsp_buff_2, dsp_buff_3};
+
+static char cell(int i) {
+  return lines[i >> 4][i & 0x0F];
+}
+
+static void frame(unsigned long second) {
+  lcd_puts("\fTime: 12:");
+  lcd_put_2digits((second / 60) % 60);
+  putchar(':');
+  lcd_put_2digits(second % 60);
+  lcd_puts("\nTemp: ");
+  lcd_put_fixed(2300 + (int)(second % 7) - 3, 2);
+  putchar(0xDF);
+  putchar('C');
+  lcd_puts("\nRH:   ");
+  lcd_put_fixed(5500 + (int)(second % 11) - 5, 2);
+  putchar('%');
+}
+
+// The changed runs, one byte and a 30us delay at a time
+static void blocking_refresh(void) {
+  int i = 0, j, last;
+
+  spi_begin(spi_lcd);
+  while(i < LCD_CHARS) {
+    if(cell(i) == shown[i]) {
+      i++;
+      continue;
+    }
+    last = i;
+    for(j = i + 1; (j < LCD_CHARS) && (j <= last + 2); j++) {
+      if(cell(j) != shown[j]) {
+        last = j;
+      }
+    }
+    lcd_spi_transmit_CMD(0x80 | i);
+    __delay_cycles(16 * 30);
+    for(; i <= last; i++) {
+      shown[i] = cell(i);
+      lcd_spi_transmit_DATA(shown[i]);
+      __delay_cycles(16 * 30);
+    }
+  }
+  spi_end(spi_lcd);
+}
+
+static void drain(void) {
+  event ev;
+
+  while(!lcd_tx_done) {
+    sim_advance(SIM_US(10));
+    while(get_event(&ev)) {
+      if(ev.type == ev_lcd) {
+        lcd_events++;
+        update_lcd_dog();               // Like the main loop
+      }
+    }
+  }
+}
+
+static void check_display(void) {
+  char line[17];
+
+  for(int n = 0; n < 3; n++) {
+    dog163_line(n, line);
+    CHECK(memcmp(line, lines[n], 16) == 0);
+  }
+}
+
+int main(void) {
+  sim_time start, cpu, queued_total = 0, queued_max = 0, blocking_total = 0, blocking_max = 0;
+  sim_time isr;
+
+  sim_run(SIM_SECONDS(1));
+
+  // ----- Queued ----- //
+  for(unsigned long second = 0; second < HOUR; second++) {
+    frame(second);
+    sim_wake();
+    isr = sim_isr_cycles[TIMER0_COMP_vect];
+    start = sim_now();
+    update_lcd_dog();
+    cpu = sim_now() - start;
+    drain();
+    cpu += sim_isr_cycles[TIMER0_COMP_vect] - isr;
+    queued_total += cpu;
+    if(cpu > queued_max) {
+      queued_max = cpu;
+    }
+  }
+  check_display();
+  sim_advance(SIM_US(100));             // The LCD runs the last queued byte
+
+  // ----- Blocking ----- //
+  for(int n = 0; n < 3; n++) {
+    char line[17];
+
+    dog163_line(n, line);
+    memcpy(&shown[n * 16], line, 16);
+  }
+  for(unsigned long second = HOUR; second < 2 * HOUR; second++) {
+    frame(second);
+    sim_wake();
+    start = sim_now();
+    blocking_refresh();
+    cpu = sim_now() - start;
+    blocking_total += cpu;
+    if(cpu > blocking_max) {
+      blocking_max = cpu;
+    }
+  }
+  check_display();
+
+  printf("CPU time per frame, blocking: %.1fus average, %.1fus worst\n",
+         blocking_total / 16.0 / HOUR, blocking_max / 16.0);
+  printf("CPU time per frame, queued:   %.1fus average, %.1fus worst\n",
+         queued_total / 16.0 / HOUR, queued_max / 16.0);
+  CHECK(queued_total * 2 < blocking_total);
+  CHECK(queued_max * 2 < blocking_max);
+
+  // ----- Overflow: a full frame while the previous one is queued ----- //
+  {
+    unsigned int overflows = lcd_queue_overflows;
+
+    set_lcd_tx_callback(tx_done);
+    sim_wake();
+    memset(dsp_buff_1, '#', 16);
+    memset(dsp_buff_2, '#', 16);
+    memset(dsp_buff_3, '#', 16);
+    update_lcd_dog();
+    memset(dsp_buff_1, '*', 16);
+    memset(dsp_buff_2, '*', 16);
+    memset(dsp_buff_3, '*', 16);
+    update_lcd_dog();
+    drain();
+    printf("overflow: %u deferred run(s), %u ev_lcd, %u completion callback(s)\n",
+           lcd_queue_overflows - overflows, lcd_events, callbacks);
+    CHECK(lcd_queue_overflows - overflows == 1);
+    CHECK(lcd_events == 1);
+    CHECK(callbacks == 1);
+    check_display();
+    set_lcd_tx_callback(0);
+  }
+
+  CHECK(dog163_busy_violations == 0);
+  CHECK(sim_spi_conflicts == 0);
+  return 0;
+}
@@ -0,0 +1,79 @@
+/****************************************************************
+  File Name            : "test_lcd_refresh.c"
+  Title                : Host Test: LCD Refresh Cost
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  The DOG163 power-on sequence (about 242ms of __delay_cycles)
+  runs once at boot, where every refresh used to run it. A
+  refresh of the whole screen then costs one DDRAM address set
+  and 48 data bytes, and a refresh without a change nothing.
+****************************************************************/
+
+#include <string.h>
+#include "header.h"
+#include "lcd.h"
+#include "test.h"
+
+#define INIT_DELAY      SIM_US(40000 + 200000 + 2000 + 6 * 30)
+
+// ----- One refresh, from update_lcd_dog() until the queue drains ----- //
+static sim_time update_cycles, bus_cycles, delay_cycles;
+static unsigned long lcd_bytes;
+
+static void refresh(void) {
+  sim_time start, delay = sim_delay_cycles;
+  unsigned long bytes = sim_spi_bytes[sim_spi_lcd];
+
+  sim_wake();
+  start = sim_now();
+
+  update_lcd_dog();
+  update_cycles = sim_now() - start;
+  while(!lcd_tx_done) {
+    sim_advance(SIM_US(10));            // Only lcd_tx_ISR and the peripherals run
+  }
+  bus_cycles = sim_now() - start;
+  delay_cycles = sim_delay_cycles - delay;
+  lcd_bytes = sim_spi_bytes[sim_spi_lcd] - bytes;
+}
+
+int main(void) {
+  char line[17];
+  sim_time boot_delay;
+
+  // ----- Power-on sequence once ----- //
+  sim_run(SIM_SECONDS(1));
+  boot_delay = sim_delay_cycles;
+  sim_run(SIM_SECONDS(10));
+  printf("__delay_cycles: %llu at boot, %llu in the next 10s\n",
+         boot_delay, sim_delay_cycles - boot_delay);
+  CHECK(boot_delay >= INIT_DELAY);
+  CHECK(boot_delay < INIT_DELAY + SIM_MS(1));
+  CHECK(sim_delay_cycles - boot_delay < SIM_MS(1));
+
+  // ----- Every character changed ----- //
+  memset(dsp_buff_1, 'A', 16);
+  memset(dsp_buff_2, 'B', 16);
+  memset(dsp_buff_3, 'C', 16);
+  refresh();
+  printf("full refresh: %lu SPI bytes, update_lcd_dog %llu cycles, on the bus %.2fms, "
+         "__delay_cycles %llu (was %.1fms)\n", lcd_bytes, update_cycles,
+         bus_cycles / 16000.0, delay_cycles, INIT_DELAY / 16000.0);
+  CHECK(lcd_bytes == 1 + 48);
+  CHECK(delay_cycles == 0);
+  CHECK(bus_cycles < SIM_MS(3));
+  dog163_line(1, line);
+  CHECK(strcmp(line, "BBBBBBBBBBBBBBBB") == 0);
+
+  // ----- Nothing changed ----- //
+  refresh();
+  printf("unchanged refresh: %lu SPI bytes, update_lcd_dog %llu cycles\n", lcd_bytes, update_cycles);
+  CHECK(lcd_bytes == 0);
+
+  CHECK(dog163_busy_violations == 0);
+  CHECK(dog163_mode_errors == 0);
+  return 0;
+}
@@ -0,0 +1,127 @@
+/****************************************************************
+  File Name            : "test_nv_stats.c"
+  Title                : Host Test: Statistics in the DS1306 RAM
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Boots the firmware in a child process for each power cycle,
+  with the DS1306 registers and RAM kept between them:
+  1. A new chip: the RAM is not a valid block, so it is reset
+     and written. An hour of samples is run and the unit is
+     changed to Fahrenheit with the keypad.
+  2. A valid block: the unit and the daily statistics of the
+     first hour are restored.
+  3. A bit flipped in the block, then the magic byte cleared:
+     the corruption is detected and the block reset each time.
+  Reports the user RAM bytes written in an hour. The host
+  block has the padding of 32-bit ints and 64-bit longs, but
+  the changed bytes are those of the target layout.
+****************************************************************/
+
+#include "header.h"
+#include "history.h"
+#include "nv_stats.h"
+#include "test.h"
+
+#define NV_RAM          0x20        // First user RAM address
+#define NV_MAGIC        0x5C
+
+// Results of a child, kept in shared memory
+typedef struct {
+  unsigned int recoveries;
+  unsigned int bytes_written;
+  unsigned long ram_writes;
+  unsigned long transactions;
+  int tempCF;
+  int has_daily;
+  unsigned int min, max, avg;
+} boot_result;
+
+static boot_result *result;
+
+static void key(void *arg) {
+  keypad_model_set(3, arg != 0);        // tempChange
+}
+
+static void read_result(void) {
+  sim_wake();
+  result->recoveries = nv_recoveries;
+  result->bytes_written = nv_bytes_written;
+  result->ram_writes = ds1306_ram_writes;
+  result->transactions = ds1306_transactions;
+  result->tempCF = tempCF;
+  result->has_daily = nv_stats_daily(hist_temp, &result->min, &result->max, &result->avg);
+}
+
+// ----- Power cycle 1: an hour on a new chip ----- //
+static void first_hour(void *arg) {
+  unsigned int writes_at_boot;
+
+  (void)arg;
+  humidicon_model_set(0, 0x2000, 0x1800);
+  sim_at(SIM_SECONDS(1800), key, (void *)1);
+  sim_at(SIM_SECONDS(1800) + SIM_MS(120), key, 0);
+  sim_run(SIM_SECONDS(2));
+  writes_at_boot = nv_bytes_written;
+  sim_run(SIM_SECONDS(3600));
+  read_result();
+  result->bytes_written -= writes_at_boot;
+}
+
+// ----- Later power cycles: boot only ----- //
+static void boot(void *arg) {
+  (void)arg;
+  humidicon_model_set(0, 0x2400, 0x1A00);
+  sim_run(SIM_MS(1500));
+  read_result();
+}
+
+int main(void) {
+  unsigned int first_min, first_max;
+
+  result = sim_shared(sizeof(boot_result));
+
+  // ----- New chip ----- //
+  CHECK(ds1306_peek(NV_RAM) != NV_MAGIC);
+  CHECK(sim_fork(first_hour, 0) == 0);
+  CHECK(result->recoveries == 1);
+  CHECK(ds1306_peek(NV_RAM) == NV_MAGIC);
+  CHECK(!result->tempCF);
+  CHECK(result->has_daily);
+  first_min = result->min;
+  first_max = result->max;
+  printf("an hour: %u bytes to the user RAM (%lu data bytes and %lu DS1306 transactions since reset)\n",
+         result->bytes_written, result->ram_writes, result->transactions);
+  CHECK(result->bytes_written <= 60 * 16);      // A minute of samples in at most 16 bytes
+
+  // ----- Valid block ----- //
+  CHECK(sim_fork(boot, 0) == 0);
+  CHECK(result->recoveries == 0);
+  CHECK(!result->tempCF);
+  CHECK(result->has_daily);
+  CHECK(result->min <= first_min);
+  CHECK(result->max >= first_max);
+  printf("restored: Fahrenheit, temperature code %u to %u (average %u)\n",
+         result->min, result->max, result->avg);
+
+  // ----- Bit flipped in a sum ----- //
+  ds1306_poke(NV_RAM + 20, ds1306_peek(NV_RAM + 20) ^ 0x04);
+  CHECK(sim_fork(boot, 0) == 0);
+  CHECK(result->recoveries == 1);
+  CHECK(result->tempCF);                        // Default unit
+  CHECK(ds1306_peek(NV_RAM) == NV_MAGIC);
+
+  // ----- Magic byte cleared ----- //
+  ds1306_poke(NV_RAM, 0);
+  CHECK(sim_fork(boot, 0) == 0);
+  CHECK(result->recoveries == 1);
+  CHECK(ds1306_peek(NV_RAM) == NV_MAGIC);
+
+  // ----- Recovered block is valid ----- //
+  CHECK(sim_fork(boot, 0) == 0);
+  CHECK(result->recoveries == 0);
+  printf("corrupt blocks detected and reset at boot\n");
+  return 0;
+}
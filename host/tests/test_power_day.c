@@ -0,0 +1,68 @@
+/****************************************************************
+  File Name            : "test_power_day.c"
+  Title                : Host Test: Duty Cycle of a Day
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Runs a simulated day and reports the time spent in each CPU
+  mode, the duty cycle, and the average supply current of the
+  ATmega128A estimated from the typical currents of the data
+  sheet at 16MHz and 5V. The awake and idle time recorded by
+  power.c with Timer3 is checked against the simulator's. 
+  power.c counts the interrupts taken in Idle mode as idle
+  time, the simulator as active time.
+****************************************************************/
+
+#include "header.h"
+#include "power.h"
+#include "test.h"
+
+#define DAY             86400UL
+
+// Typical supply current of each mode (mA), 16MHz 5V
+static const double mode_ma[sim_mode_count] = {
+  [sim_active] = 20.0, [sim_idle] = 9.0, [sim_adc_noise] = 2.5, [sim_power_down] = 0.02
+};
+static const char *const mode_names[sim_mode_count] = {
+  "active", "idle", "ADC noise reduction", "power-down"
+};
+
+int main(void) {
+  sim_time total = 0;
+  double charge = 0.0, average_ma, duty;
+
+  humidicon_model_set(0, 0x2000, 0x1800);
+  sim_run(SIM_SECONDS(DAY));
+
+  for(int m = 0; m < sim_mode_count; m++) {
+    total += sim_mode_cycles[m];
+  }
+  printf("%-20s %12s %8s %10s\n", "mode", "seconds", "share", "entries");
+  for(int m = 0; m < sim_mode_count; m++) {
+    printf("%-20s %12.2f %7.3f%% %10lu\n", mode_names[m], sim_mode_cycles[m] / (double)SIM_FOSC,
+           100.0 * sim_mode_cycles[m] / total, sim_mode_entries[m]);
+    charge += mode_ma[m] * sim_mode_cycles[m];
+  }
+  average_ma = charge / total;
+  duty = (double)sim_mode_cycles[sim_active] / total;
+  printf("duty cycle %.3f%%, average current %.3fmA (always active: %.1fmA)\n",
+         100.0 * duty, average_ma, mode_ma[sim_active]);
+  printf("power.c: awake %.2fs, idle %.2fs\n", awake_counts / 2e6, idle_counts / 2e6);
+
+  CHECK(total >= SIM_SECONDS(DAY));
+  CHECK(duty < 0.05);
+  CHECK(average_ma < mode_ma[sim_active] / 4);
+
+  // ----- power.c sees the same time awake or idle (within 5%) ----- //
+  {
+    double recorded = (awake_counts + idle_counts) / 2e6;
+    double simulated = (sim_mode_cycles[sim_active] + sim_mode_cycles[sim_idle]) / (double)SIM_FOSC;
+
+    CHECK(recorded > 0.95 * simulated);
+    CHECK(recorded < 1.05 * simulated);
+    CHECK(awake_counts / 2e6 <= sim_mode_cycles[sim_active] / (double)SIM_FOSC);
+  }
+  return 0;
+}
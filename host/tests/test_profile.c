@@ -0,0 +1,133 @@
+/****************************************************************
+  File Name            : "test_profile.c"
+  Title                : Host Test: Cycle Profiler
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Boots the firmware with a key pressed now and then, then
+  checks the profiler:
+  - The overhead of an empty probe pair, and the cycles a 
+    probe pair adds to the code it times.
+  - Probes around __delay_cycles() of known lengths record
+    them to the Timer3 count (8 cycles).
+  - The min/max/total/count math of prof_record, with the 
+    overhead taken off and never below 0.
+  - The probes of the firmware recorded samples, DEL from the
+    idle screen shows the diagnostics screen, and 1 selects
+    the first probe.
+  The count saturates at 65535 on the target; it is a 32-bit
+  unsigned int on the host, so that is not checked here.
+****************************************************************/
+
+#include <string.h>
+#include "header.h"
+#include "profile.h"
+#include "test.h"
+
+static void key(void *arg) {
+  keypad_model_release_all();
+  if(arg) {
+    keypad_model_set((unsigned char)(unsigned long)arg - 1, 1);
+  }
+}
+
+static void press(sim_time at, unsigned char position) {
+  sim_at(at, key, (void *)(unsigned long)(position + 1));
+  sim_at(at + SIM_MS(120), key, 0);
+}
+
+int main(void) {
+  static const unsigned int delays[] = {800, 8000, 80, 16000, 2400};
+  static const unsigned int samples[] = {50, 3, 700, 3, 0, 65535};
+  prof_stats stats;
+  sim_time start, pair_cycles;
+  unsigned long total = 0;
+  char line[17];
+
+  // ----- Firmware probes ----- //
+  humidicon_model_set(0, 0x2000, 0x1800);
+  press(SIM_SECONDS(3), 1);             // co2 page
+  press(SIM_SECONDS(5), 4);             // back
+  sim_run(SIM_SECONDS(10));
+  sim_wake();
+  for(int p = 0; p < prof_count; p++) {
+    prof_read((prof_probe)p, &stats);
+    printf("%-16s n %5u  min %5.1f  avg %7.1f  max %7.1f us\n", prof_name((prof_probe)p), stats.count,
+           stats.min / 2.0, stats.count ? (double)stats.total / stats.count / 2.0 : 0.0, stats.max / 2.0);
+    if(stats.count != 0) {
+      CHECK(stats.min <= stats.max);
+      CHECK(stats.total >= (unsigned long)stats.min * stats.count);
+      CHECK(stats.total <= (unsigned long)stats.max * stats.count);
+    }
+  }
+  prof_read(prof_tick_ISR, &stats);
+  CHECK(stats.count >= 9);
+  prof_read(prof_update_lcd, &stats);
+  CHECK(stats.count != 0);
+
+  // ----- Overhead ----- //
+  sim_set_irq(0);
+  printf("empty probe pair: %u counts of overhead\n", prof_overhead);
+  CHECK(prof_overhead <= 1);
+  prof_clear();
+  start = sim_now();
+  {
+    PROF_ENTER(prof_key_ISR);
+    PROF_EXIT(prof_key_ISR);
+  }
+  pair_cycles = sim_now() - start;
+  prof_read(prof_key_ISR, &stats);
+  printf("probe pair: %llu cycles of register accesses\n", pair_cycles);
+  CHECK((stats.count == 1) && (stats.max == 0));
+  CHECK(pair_cycles <= 16);
+
+  // ----- Known times ----- //
+  prof_clear();
+  for(unsigned int i = 0; i < sizeof(delays) / sizeof(delays[0]); i++) {
+    PROF_ENTER(prof_key_scan);
+    __delay_cycles(delays[i]);
+    PROF_EXIT(prof_key_scan);
+    total += delays[i] / 8;
+  }
+  prof_read(prof_key_scan, &stats);
+  CHECK(stats.count == 5);
+  printf("delays of 80 to 16000 cycles: %u to %u counts, total %lu for %lu\n",
+         stats.min, stats.max, stats.total, total);
+  CHECK((stats.min + 1 >= 80 / 8) && (stats.min <= 80 / 8 + 1));      // 1 count of phase
+  CHECK((stats.max + 1 >= 16000 / 8) && (stats.max <= 16000 / 8 + 1));
+  CHECK((stats.total + 5 >= total) && (stats.total <= total + 5));
+
+  // ----- Accumulator math ----- //
+  prof_clear();
+  prof_overhead = 3;
+  total = 0;
+  for(unsigned int i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+    prof_record(prof_rtc_block_read, samples[i]);
+    total += (samples[i] > 3) ? samples[i] - 3 : 0;
+  }
+  prof_read(prof_rtc_block_read, &stats);
+  CHECK(stats.count == 6);
+  CHECK(stats.min == 0);
+  CHECK(stats.max == 65535 - 3);
+  CHECK(stats.total == total);
+  prof_clear();
+  prof_read(prof_rtc_block_read, &stats);
+  CHECK((stats.count == 0) && (stats.total == 0) && (stats.max == 0));
+  prof_init();
+  sim_set_irq(1);
+
+  // ----- Diagnostics screen: DEL opens it on the next probe, 1 selects the first ----- //
+  press(sim_now() + SIM_MS(500), 0);    // del
+  sim_run(SIM_SECONDS(1));
+  dog163_line(0, line);
+  printf("diagnostics: [%s]", line);
+  CHECK(strncmp(line, prof_name(prof_key_ISR), strlen(prof_name(prof_key_ISR))) == 0);
+  press(sim_now() + SIM_MS(200), 15);   // one
+  sim_run(SIM_SECONDS(1));
+  dog163_line(0, line);
+  printf(", then [%s]\n", line);
+  CHECK(strncmp(line, prof_name(prof_tick_ISR), strlen(prof_name(prof_tick_ISR))) == 0);
+  return 0;
+}
@@ -0,0 +1,93 @@
+/****************************************************************
+  File Name            : "test_spi_bus.c"
+  Title                : Host Test: SPI Bus Sequencing
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Traces every SPI byte of a minute of operation, with keys
+  pressed, and checks that each one was sent with exactly one
+  device selected, in the mode of that device and at its
+  fastest supported clock:
+   Humidicon  mode 0, 500kHz (at most 800kHz)
+   DS1306     mode 3, 2MHz (CPHA = 1, at most 2MHz)
+   DOG163     mode 3, 2MHz
+  Reports the register reconfigurations per second, which
+  must not exceed the changes of device on the bus.
+****************************************************************/
+
+#include "header.h"
+#include "spi_bus.h"
+#include "test.h"
+
+#define RUN_SECONDS     60
+
+static const unsigned char expected_mode[sim_spi_devices] = {
+  [sim_spi_humidicon] = 0, [sim_spi_rtc] = 3, [sim_spi_lcd] = 3
+};
+static const unsigned long expected_sclk[sim_spi_devices] = {
+  [sim_spi_humidicon] = 500000, [sim_spi_rtc] = 2000000, [sim_spi_lcd] = 2000000
+};
+
+static unsigned long traced, wrong_selects, wrong_modes, device_changes;
+static int last_device = -1;
+
+static void trace(const sim_spi_byte *b) {
+  int device = -1;
+
+  traced++;
+  for(int d = 0; d < sim_spi_devices; d++) {
+    if(b->selected & (1u << d)) {
+      if(device >= 0) {
+        wrong_selects++;
+      }
+      device = d;
+    }
+  }
+  if(device < 0) {
+    wrong_selects++;
+    return;
+  }
+  if(device < SIM_HUMIDICONS) {
+    device = sim_spi_humidicon;         // Every sensor has the same mode
+  }
+  if((b->mode != expected_mode[device]) || (b->sclk != expected_sclk[device])) {
+    wrong_modes++;
+  }
+  if(device != last_device) {
+    device_changes++;
+    last_device = device;
+  }
+}
+
+static void key(void *arg) {
+  keypad_model_set(2, arg != 0);        // zero: sensor page on the idle screen
+}
+
+int main(void) {
+  sim_spi_trace = trace;
+  for(int s = 5; s < RUN_SECONDS; s += 5) {
+    sim_at(SIM_SECONDS(s), key, (void *)1);
+    sim_at(SIM_SECONDS(s) + SIM_MS(120), key, 0);
+  }
+  sim_run(SIM_SECONDS(RUN_SECONDS));
+
+  printf("%lu bytes: humidicon %lu, DS1306 %lu, DOG163 %lu\n", traced,
+         sim_spi_bytes[sim_spi_humidicon], sim_spi_bytes[sim_spi_rtc], sim_spi_bytes[sim_spi_lcd]);
+  printf("device changes %lu, reconfigurations %u (%.2f per second)\n",
+         device_changes, spi_reconfig_count, (double)spi_reconfig_count / RUN_SECONDS);
+
+  CHECK(traced > 0);
+  CHECK(sim_spi_bytes[sim_spi_humidicon] > 0);
+  CHECK(sim_spi_bytes[sim_spi_rtc] > 0);
+  CHECK(sim_spi_bytes[sim_spi_lcd] > 0);
+  CHECK(wrong_selects == 0);
+  CHECK(wrong_modes == 0);
+  CHECK(sim_spi_conflicts == 0);
+  CHECK(ds1306_mode_errors == 0);
+  CHECK(humidicon_model_mode_errors == 0);
+  CHECK(dog163_mode_errors == 0);
+  CHECK(spi_reconfig_count <= device_changes + 1);    // +1: the boot configuration
+  return 0;
+}
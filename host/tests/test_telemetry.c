@@ -0,0 +1,166 @@
+/****************************************************************
+  File Name            : "test_telemetry.c"
+  Title                : Host Test: Telemetry over a Pseudo-Terminal
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  The simulated USART0 writes to the master side of a pseudo-
+  terminal and the frames are decoded from the slave side 
+  (raw mode) with the host decoder:
+  1. A minute of the firmware stream: a frame per second with
+     consecutive sequence numbers and time stamps, and the 
+     Humidicon codes of the sensor model.
+  2. Frames queued faster than the line (every 1ms, a frame
+     takes 1.3ms): the sustained throughput at 115200 baud,
+     and the dropped frames counted by the firmware, seen as
+     gaps in the time stamps, and flagged in the next frame.
+  3. Frames queued every 1.5ms: none dropped.
+  4. A corrupt byte and line noise: the decoder skips the bad
+     frame and finds the next one.
+****************************************************************/
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "header.h"
+#include "telemetry.h"
+#include "telem_decode.h"
+#include "test.h"
+
+#define RH_CODE         0x2000
+#define TEMP_CODE       0x1800
+#define BURST_FRAMES    2000
+#define CAPTURE_SIZE    (TELEM_FRAME_SIZE * 8)
+
+static int slave_fd;
+static telem_decoder decoder;
+static unsigned long stamp_gaps, unflagged_gaps, bad_values;
+static long last_stamp = -1;
+static unsigned char capture[CAPTURE_SIZE];
+static unsigned int captured;
+
+static void capture_byte(unsigned char data) {
+  if(captured < CAPTURE_SIZE) {
+    capture[captured++] = data;
+  }
+}
+
+// Decodes what the slave side of the pty has received
+static void drain(void) {
+  unsigned char bytes[512];
+  telem_frame frame;
+  ssize_t count;
+
+  while((count = read(slave_fd, bytes, sizeof(bytes))) > 0) {
+    for(ssize_t i = 0; i < count; i++) {
+      if(!telem_decode_byte(&decoder, bytes[i], &frame)) {
+        continue;
+      }
+      if((frame.rh_raw != RH_CODE) || (frame.temp_raw != TEMP_CODE)) {
+        bad_values++;
+      }
+      if((last_stamp >= 0) && (frame.stamp != (unsigned int)last_stamp + 1)) {
+        stamp_gaps += frame.stamp - last_stamp - 1;
+        if(!(frame.flags & TELEM_DROPPED)) {
+          unflagged_gaps++;
+        }
+      }
+      last_stamp = frame.stamp;
+    }
+  }
+}
+
+// Queues a frame every interval cycles, returns the frames dropped
+static unsigned int burst(unsigned int first, sim_time interval, double *bytes_per_second) {
+  unsigned int dropped = telemetry_dropped;
+  unsigned long bytes = sim_usart_bytes;
+  sim_time start = sim_now();
+
+  last_stamp = (long)first - 1;
+  for(unsigned int i = 0; i < BURST_FRAMES; i++) {
+    telemetry_tick(first + i, RH_CODE, TEMP_CODE);
+    sim_advance(interval);
+    drain();
+  }
+  *bytes_per_second = (double)(sim_usart_bytes - bytes) * SIM_FOSC / (sim_now() - start);
+  sim_advance(SIM_MS(20));              // Ring empty
+  drain();
+  stamp_gaps += first + BURST_FRAMES - 1 - last_stamp;      // Dropped after the last frame sent
+  return telemetry_dropped - dropped;
+}
+
+int main(void) {
+  static const unsigned char noise[] = {TELEM_SYNC1, 0x00, TELEM_SYNC1, TELEM_SYNC2, 0x11, TELEM_SYNC1};
+  static unsigned char stream[CAPTURE_SIZE + sizeof(noise)];
+  telem_decoder check;
+  telem_frame frame;
+  struct termios tio;
+  double rate, line_rate = 16000000.0 / (8 * (16 + 1)) / 10;    // U2X, UBRR 16, 10 bits
+  unsigned int dropped, found = 0;
+  int master_fd;
+
+  // ----- Pseudo-terminal, raw and non-blocking ----- //
+  master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+  CHECK(master_fd >= 0);
+  CHECK((grantpt(master_fd) == 0) && (unlockpt(master_fd) == 0));
+  slave_fd = open(ptsname(master_fd), O_RDWR | O_NOCTTY | O_NONBLOCK);
+  CHECK(slave_fd >= 0);
+  CHECK(tcgetattr(slave_fd, &tio) == 0);
+  cfmakeraw(&tio);
+  CHECK(tcsetattr(slave_fd, TCSANOW, &tio) == 0);
+  sim_usart_fd = master_fd;
+  sim_usart_tx = capture_byte;
+  telem_decoder_init(&decoder);
+
+  // ----- A minute of the firmware stream ----- //
+  humidicon_model_set(0, RH_CODE, TEMP_CODE);
+  for(int s = 0; s < 60; s++) {
+    sim_run(SIM_SECONDS(1));
+    drain();
+  }
+  printf("firmware stream: %lu frames, %lu bad, %lu missing, %u dropped\n",
+         decoder.frames, decoder.crc_errors, decoder.missing, telemetry_dropped);
+  CHECK((decoder.frames >= 59) && (decoder.frames == telemetry_frames));
+  CHECK((decoder.crc_errors == 0) && (decoder.missing == 0) && (decoder.skipped == 0));
+  CHECK((stamp_gaps == 0) && (bad_values == 0) && (telemetry_dropped == 0));
+
+  // ----- Faster than the line ----- //
+  sim_wake();
+  telemetry_set_period(1);
+  dropped = burst(1000, SIM_MS(1), &rate);
+  printf("a frame every 1ms: %.0f bytes/s (line %.0f bytes/s), %u of %d frames dropped, "
+         "%lu flagged\n", rate, line_rate, dropped, BURST_FRAMES, decoder.flagged);
+  CHECK(rate > 0.98 * line_rate);
+  CHECK(dropped > 0);
+  CHECK(stamp_gaps == dropped);
+  CHECK(unflagged_gaps == 0);
+  CHECK((decoder.crc_errors == 0) && (decoder.missing == 0));
+
+  // ----- Slower than the line ----- //
+  stamp_gaps = 0;
+  dropped = burst(4000, SIM_US(1500), &rate);
+  printf("a frame every 1.5ms: %.0f bytes/s, %u dropped\n", rate, dropped);
+  CHECK((dropped == 0) && (stamp_gaps == 0));
+  CHECK((decoder.crc_errors == 0) && (decoder.missing == 0) && (bad_values == 0));
+
+  // ----- Corrupt byte and noise ----- //
+  CHECK(captured == CAPTURE_SIZE);
+  capture[TELEM_FRAME_SIZE + 7] ^= 0x10;                    // Second frame
+  memcpy(stream, capture, 2 * TELEM_FRAME_SIZE);
+  memcpy(&stream[2 * TELEM_FRAME_SIZE], noise, sizeof(noise));
+  memcpy(&stream[2 * TELEM_FRAME_SIZE + sizeof(noise)], &capture[2 * TELEM_FRAME_SIZE],
+         CAPTURE_SIZE - 2 * TELEM_FRAME_SIZE);
+  telem_decoder_init(&check);
+  for(unsigned int i = 0; i < sizeof(stream); i++) {
+    found += telem_decode_byte(&check, stream[i], &frame);
+  }
+  printf("corrupt frame and noise: %u of %d frames decoded, %lu bad, %lu bytes skipped\n",
+         found, CAPTURE_SIZE / TELEM_FRAME_SIZE, check.crc_errors, check.skipped);
+  CHECK(found == CAPTURE_SIZE / TELEM_FRAME_SIZE - 1);
+  CHECK(check.missing == 1);
+  return 0;
+}
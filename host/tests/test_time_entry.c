@@ -0,0 +1,100 @@
+/****************************************************************
+  File Name            : "test_time_entry.c"
+  Title                : Host Test: Time Entry Prompts
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Types a full date and time entry (10/16/26, Friday, 14:30:00)
+  on the keypad model, some fields quickly so the next key ends
+  the confirmation and some slowly so the prompt timeout does,
+  then checks the DS1306 and the software clock.
+  While the user types, the 1Hz tick, the clock and the 
+  Humidicon sampling must keep running, and the longest time
+  with interrupts disabled is reported and bounded: the 
+  prompts do not wait in __delay_cycles any more.
+****************************************************************/
+
+#include "header.h"
+#include "events.h"
+#include "clock.h"
+#include "test.h"
+
+// setTime, then the month, date, year, weekday, and time digits.
+// A 0 gap is a quick key (300ms), otherwise the pause before the key
+static const struct {
+  unsigned char position;
+  unsigned int pause_ms;
+} entry[] = {
+  {12, 0},                              // setTime
+  {15, 0}, { 2, 0},                     // 10
+  {15, 0}, { 9, 0},                     // 16, the key ends the confirmation
+  {14, 1500}, { 9, 0},                  // 26, after the prompt timed out
+  {10, 1500},                           // 5
+  {15, 0}, {11, 0}, {13, 0}, { 2, 0}, { 2, 0}, { 2, 0}      // 14:30:00
+};
+
+#define KEYS    (sizeof(entry) / sizeof(entry[0]))
+
+static void key(void *arg) {
+  static unsigned int presses;
+  int down = (arg != 0);
+
+  keypad_model_set(entry[presses].position, down);
+  if(!down) {
+    presses++;
+  }
+}
+
+static unsigned char bin(unsigned char bcd) {
+  return (bcd >> 4) * 10 + (bcd & 0x0F);
+}
+
+int main(void) {
+  const clock_time *now = clock_now();
+  sim_time at = SIM_SECONDS(2), start, delays;
+  unsigned int ticks;
+  unsigned long fetches;
+  unsigned char h, m, s;
+
+  humidicon_model_set(0, 0x2000, 0x1800);
+  for(unsigned int i = 0; i < KEYS; i++) {
+    at += entry[i].pause_ms ? SIM_MS(entry[i].pause_ms) : SIM_MS(300);
+    sim_at(at, key, (void *)1);
+    sim_at(at + SIM_MS(80), key, 0);
+  }
+  sim_run(SIM_SECONDS(1));
+  sim_irq_off_max = 0;                  // Interrupts are off during the power-on initialization
+  start = sim_now();
+  delays = sim_delay_cycles;
+  ticks = event_counts[ev_tick];
+  fetches = humidicon_model_fetches[0];
+
+  // ----- Type the entry, the time is written 1s after the last key ----- //
+  sim_run(at + SIM_MS(1500) - start);
+  ds1306_get_time(&h, &m, &s);
+  printf("entry of %u keys in %.1fs: %u ticks, %lu Humidicon reads, %.3fms in __delay_cycles\n",
+         (unsigned int)KEYS, (double)(sim_now() - start) / SIM_FOSC, event_counts[ev_tick] - ticks,
+         humidicon_model_fetches[0] - fetches, (double)(sim_delay_cycles - delays) * 1000 / SIM_FOSC);
+  printf("key ISR at most %llu cycles, key scan %llu, interrupts off at most %llu cycles\n",
+         sim_isr_max[INT0_vect], sim_isr_max[TIMER2_COMP_vect], sim_irq_off_max);
+  printf("DS1306 %02u/%02u/%02u %02u:%02u:%02u, clock %02u/%02u/%02u %02u:%02u:%02u\n",
+         bin(ds1306_peek(0x05)), bin(ds1306_peek(0x04)), bin(ds1306_peek(0x06)), h, m, s,
+         now->month, now->date, now->year, now->hours, now->minutes, now->seconds);
+
+  // ----- The entry was written and the clock follows it ----- //
+  CHECK((bin(ds1306_peek(0x05)) == 10) && (bin(ds1306_peek(0x04)) == 16) && (bin(ds1306_peek(0x06)) == 26));
+  CHECK((ds1306_peek(0x03) == 5) && (h == 14) && (m == 30) && (s <= 1));
+  CHECK((now->month == 10) && (now->date == 16) && (now->year == 26) && (now->day == 5));
+  CHECK((now->hours == 14) && (now->minutes == 30) && (now->seconds == s));
+
+  // ----- Nothing stopped while the user typed ----- //
+  CHECK(event_counts[ev_tick] - ticks >= (sim_now() - start) / SIM_FOSC - 1);
+  CHECK(humidicon_model_fetches[0] - fetches >= (sim_now() - start) / SIM_FOSC - 1);
+  CHECK(sim_delay_cycles - delays < SIM_MS(1));
+  CHECK(sim_isr_max[INT0_vect] < 100);
+  CHECK(sim_irq_off_max < 200);
+  CHECK(events_dropped == 0);
+  return 0;
+}
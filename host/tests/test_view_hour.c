@@ -0,0 +1,101 @@
+/****************************************************************
+  File Name            : "test_view_hour.c"
+  Title                : Host Test: An Hour of Page Rendering
+  Date                 : 10/16/2026
+  Version              : 1.0
+  Target MCU           : Linux host (gcc)
+  Author               : Wilmer Suarez
+  DESCRIPTION
+  Runs an hour in 6 cycles of 8 minutes on the sensor page 
+  and 2 minutes on the CO2 page (co2 and back keys). The 
+  Humidicon values step every 30 seconds and the CO2 sensor
+  voltage is constant. Reports the pages drawn (view_renders)
+  and the characters sent to the LCD on each page.
+  The sensor page must be drawn once a second (the time) and
+  once per Humidicon step, the CO2 page about once per switch,
+  and the last minute on the CO2 page, with an unchanged model,
+  must cost no render and no LCD character.
+****************************************************************/
+
+#include "header.h"
+#include "alarm.h"
+#include "view.h"
+#include "test.h"
+
+#define CYCLES          6
+#define SENSOR_SECONDS  480
+#define CO2_SECONDS     120
+#define CO2_CODE        240             // 600mV (10-bit ADC code)
+#define POS_CO2         1
+#define POS_BACK        4
+
+static unsigned int adc_co2(unsigned char mux) {
+  (void)mux;
+  return CO2_CODE;
+}
+
+// Presses a key (kTable position) for 80ms
+static void key(unsigned char position) {
+  keypad_model_set(position, 1);
+  sim_run(SIM_MS(80));
+  keypad_model_set(position, 0);
+}
+
+int main(void) {
+  unsigned int renders[2] = {0, 0}, step = 0, r, still_renders = 0;
+  unsigned long chars[2] = {0, 0}, d, still_chars = 0;
+  unsigned long seconds[2] = {0, 0};
+  sim_time start;
+
+  sim_adc_input = adc_co2;
+  humidicon_model_set(0, 0x2000, 0x1800);
+  sim_run(SIM_SECONDS(10));             // Boot
+
+  for(int c = 0; c < CYCLES; c++) {
+    // ----- Sensor page, the values step every 30s ----- //
+    r = view_renders;
+    d = dog163_data;
+    start = sim_now();
+    key(POS_BACK);
+    for(int s = 0; s < SENSOR_SECONDS; s += 30) {
+      step++;
+      humidicon_model_set(0, 0x2000 + step * 40, 0x1800 + step * 20);
+      sim_run(SIM_SECONDS(30));
+    }
+    renders[0] += view_renders - r;
+    chars[0] += dog163_data - d;
+    seconds[0] += (sim_now() - start) / SIM_FOSC;
+
+    // ----- CO2 page, constant voltage ----- //
+    r = view_renders;
+    d = dog163_data;
+    start = sim_now();
+    key(POS_CO2);
+    sim_run(SIM_SECONDS(CO2_SECONDS - 60));
+    still_renders = view_renders;
+    still_chars = dog163_data;
+    sim_run(SIM_SECONDS(60));
+    still_renders = view_renders - still_renders;
+    still_chars = dog163_data - still_chars;
+    renders[1] += view_renders - r;
+    chars[1] += dog163_data - d;
+    seconds[1] += (sim_now() - start) / SIM_FOSC;
+  }
+
+  printf("%-7s %8s %8s %8s %12s\n", "page", "seconds", "renders", "chars", "chars/render");
+  printf("%-7s %8lu %8u %8lu %12.1f\n", "sensor", seconds[0], renders[0], chars[0], (double)chars[0] / renders[0]);
+  printf("%-7s %8lu %8u %8lu %12.1f\n", "co2", seconds[1], renders[1], chars[1], (double)chars[1] / renders[1]);
+  printf("last minute of each CO2 page: %u renders, %lu chars; a full refresh is 48 chars\n",
+         still_renders, still_chars);
+
+  // ----- The sensor page follows the clock and the Humidicon steps ----- //
+  CHECK(renders[0] >= seconds[0] - CYCLES);
+  CHECK(renders[0] <= seconds[0] + step + 2 * CYCLES);
+  CHECK(chars[0] < renders[0] * 8);
+
+  // ----- The CO2 page only on a switch or a change ----- //
+  CHECK(renders[1] >= CYCLES);
+  CHECK(renders[1] <= 3 * CYCLES);
+  CHECK((still_renders == 0) && (still_chars == 0));
+  return 0;
+}
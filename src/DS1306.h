@@ -12,6 +12,8 @@
 
 // ------- External Functions for the DS1306 ------- //
 extern void DS1306_RTC_config();
-extern void SPI_rtc_DS1306_config();
+extern void DS1306_alarm_enable(unsigned char alarm, bool on);    // header.h must be included first
+extern void display_time();
 extern unsigned char read_RTC(unsigned char reg_RTC);
-extern void block_write_RTC(volatile unsigned char *array_ptr, unsigned char start_addr, unsigned char count);
\ No newline at end of file
+extern void block_write_RTC(volatile unsigned char *array_ptr, unsigned char start_addr, unsigned char count);
+extern void block_read_RTC(volatile unsigned char *array_ptr, unsigned char start_addr, unsigned char count);
\ No newline at end of file
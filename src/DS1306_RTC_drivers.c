@@ -8,65 +8,79 @@
  DESCRIPTION
  This module defines the driver and configuration functions needed 
  to allow the Microcontroller to communicate with the DS1306
- and display the time, in 24-hour format, on the LCD. 
+ and keep the time, in 24-hour format, shown by view.c. 
+ 
+ Each DS1306 interrupt source has its own MCU interrupt:
+ 1Hz output   INT1, falling edge    System tick (display refresh)
+ /INT0        INT2, low level       Alarm 0, user schedule
+ 1INT         INT3, rising edge     Alarm 1, user schedule
+ The tick does not depend on the alarm registers, so the user can
+ program both alarms without changing the refresh rate.
 ******************************************************************/
 
 // ----- Include Files ----- //
 #include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
 #include "DS1306.h"
-#include "lcd.h"
 #include "humidicon.h"
-#include <stdio.h>
+#include "spi_bus.h"
+#include "events.h"
+#include "profile.h"
+#include "clock.h"
 
 // ------- Static function Prototypes ------- //
 static void write_RTC(unsigned char reg_RTC, unsigned char data_RTC);
-static void block_read_RTC(volatile unsigned char *array_ptr, unsigned char start_addr, unsigned char count);
+
+// ----- Control register ----- //
+#define RTC_CONTROL_1HZ     0x04                // 1 Hz output enable
+#define RTC_CONTROL_AIE0    0x01                // Alarm 0 interrupt enable
+#define RTC_CONTROL_AIE1    0x02                // Alarm 1 interrupt enable
+
+static unsigned char rtc_control = RTC_CONTROL_1HZ;   // Last value written to the control register
 
 // ----- Global variables and arrays ----- //
 volatile unsigned char RTC_time_date_write[3] = {0x00, 0x00, 0x00};  // Holds the initial data to be written to the DS1306 time registers
-volatile unsigned char RTC_time_date_read[3];                        // Holds the data read from the DS1306 time registers
-volatile unsigned char alarm0_config[4] = {0x80, 0x80, 0x80, 0x80};  // Holds data to configure alarm 0 to cause an interrupt each second
 unsigned char data;                                                  // Holds current byte of data read from the DS1306
 volatile unsigned char *arrPtr;                                      // Points to current array
 
 /*************************************************************
- ISR Name             : void display_time_RTC()
+ ISR Name             : void display_time_ISR()
  Target MCU           : ATmega128 @ 16MHz
  Date                 : 04/09/2018
  Author               : Wilmer Suarez
- Version              : 1.0
+ Version              : 3.0
  DESCRIPTION
- This Interrupt Service Routine reads the hours, minutes, and 
- seconds register of the DS1306, converts the BCD value to 
- integer, and displays it on the LCD.
- This interrupt occurs every second.
+ This interrupt occurs every second, on the falling edge of
+ the DS1306 1Hz output. Nothing has to be cleared in the 
+ DS1306. The ISR only posts the tick event.
 *************************************************************/
 #pragma vector=INT1_vect                        // Vector Location for INT1 interrupt
 __interrupt void display_time_ISR() {
-  // Variables
-  unsigned char readAddr = 0x00, count0 = 3;
-  unsigned int hours, minutes, seconds;
-  
-  // ------------------------------ SPI Configuration ------------------------------ //
-  // Configure Microcontroller SPI to communicate with the DS1306 RTC
-  SPI_rtc_DS1306_config();
-  
-  // -------- Read the DS1306's Time and Date registers -------- //
-  arrPtr = RTC_time_date_read;                  // Pointing to start of read Array
-  block_read_RTC(arrPtr, readAddr, count0);     // Read Time registers
+  PROF_ENTER(prof_tick_ISR);
+  post_event(ev_tick, 0);
+  PROF_EXIT(prof_tick_ISR);
+}
+
+/*************************************************************
+ Function             : void display_time()
+ Target MCU           : ATmega128 @ 16MHz
+ Date                 : 10/16/2026
+ Author               : Wilmer Suarez
+ Version              : 3.0
+ DESCRIPTION
+ Called by the main loop on every tick. Advances the 
+ software clock (clock.c resyncs it with the DS1306 when
+ due) and measures the Humidicons. The main loop hands
+ the new values to the display model.
+*************************************************************/
+void display_time() {
+  PROF_ENTER(prof_display_time);
   
-  // ----- Convert Hours, Minutes, and Seconds from BCD to Integer ----- //
-  hours = (((RTC_time_date_read[2] & 0xF0) >> 4) * 10);
-  hours += RTC_time_date_read[2] & 0x0F;
-  minutes = (((RTC_time_date_read[1] & 0xF0) >> 4) * 10);
-  minutes += RTC_time_date_read[1] & 0x0F;
-  seconds = (((RTC_time_date_read[0] & 0xF0) >> 4) * 10);
-  seconds += RTC_time_date_read[0] & 0x0F;
+  // -------- Advance the software clock -------- //
+  clock_tick();
   
-  // -------------------- Display Time, Temp, & Hum -------------------- //
-  printf("\fTime: %02d:%02d:%02d\n", hours, minutes, seconds);
+  measure_rh_temp();                // Reads and calculates Temp and Hum
   
-  meas_display_rh_temp();           // Reads, calculates, and displays Temp and Hum
+  PROF_EXIT(prof_display_time);
 }
 
 /***************************************************************
@@ -77,54 +91,64 @@ __interrupt void display_time_ISR() {
  Author               : Wilmer Suarez
  DESCRIPTION
  This function intializes the DS1306's control register by 
- clearing the write protect bit and enabling the 1hz output, 
- and alarm 0 intterupt. 
- It also sets up the alarm 0 to cause an interrupt every second
+ clearing the write protect bit and enabling the 1hz output,
+ which is the system tick. Both alarm interrupts are left
+ disabled until the user sets an alarm.
 ***************************************************************/
 void DS1306_RTC_config() {
   // Variables
-  unsigned char writeAddr = 0x80, alarm0Addr = 0x87, count0 = 3, count1 = 4;
-  
-  // ------------------------------ SPI Configuration ------------------------------ //
-  // Configure Microcontroller SPI to communicate with the DS1306 RTC
-  SPI_rtc_DS1306_config();
+  unsigned char writeAddr = 0x80, count0 = 3;
   
   // ----------------------- Setup DS1306's Control register ----------------------- //
   // Clear Write Protect bit. It is intially undefined 
   write_RTC(0x8F, 0x00);                        // Two writes needed because if wp is set, writing can't be done to any other bit.
-  write_RTC(0x8F, 0x05);                        // Enable 1Hz output and Enable Alarm 0 (AIE0) to allow /INT0 to be asserted.
+  rtc_control = RTC_CONTROL_1HZ;
+  write_RTC(0x8F, rtc_control);                 // Enable 1Hz output only, /INT0 and /INT1 stay inactive.
 
   // ----------------- Initialize DS1306's Time registers ----------------- //
   arrPtr = RTC_time_date_write;                 // Pointing to start of write Array
   block_write_RTC(arrPtr, writeAddr, count0);
-  
-  // --------------------- Initialize DS1306's Alarm 0 to Interrupt every second --------------------- //
-  arrPtr = alarm0_config;                       // Pointing to start of alarm0_config Array
-  block_write_RTC(arrPtr, alarm0Addr, count1);
 }
 
-/************************************************************
- Function             : void SPI_rtc_ds1306_config()
- Date                 : 04/09/2018
+/***************************************************************
+ Function             : void DS1306_alarm_enable(
+                        unsigned char alarm, bool on)
+ Date                 : 10/16/2026
  Version              : 1.0
  Target MCU           : ATmega128
  Author               : Wilmer Suarez
  DESCRIPTION
- This function configures an ATmega128 operated at 16 MHz to 
- communicate with the DS1306 by SPI.  
- SCLK is operated a the maximum possible frequency for 
- the DS1306 (2MHz).
-************************************************************/
-void SPI_rtc_DS1306_config() {  
-  // --------------------- SPI Configuration --------------------- //
-  // Set SPE, MSTR, CPOL, CPHA, SPR0, and SPI2X //
-  // Pre-scalar = 8 -> SCLK = 2MHz //
-  SPCR = (1 << SPE) | (1 << MSTR) | (1 << CPOL) | (1 << CPHA) | (1 << SPR0);
-  SPSR = (1 << SPI2X);
+ Enables or disables the interrupt of Alarm 0 or Alarm 1
+ (AIE0/AIE1 in the control register). The 1Hz output is
+ left on.
+ 1INT (Alarm 1) is an active high push-pull output that is
+ low while the alarm is off, so INT3 is only unmasked while
+ Alarm 1 is enabled. EIFR and EIMSK are updated with 
+ interrupts disabled.
+***************************************************************/
+void DS1306_alarm_enable(unsigned char alarm, bool on) {
+  unsigned char bit = (alarm == 0) ? RTC_CONTROL_AIE0 : RTC_CONTROL_AIE1;
   
-  // --- Clear SPIF in SPSR --- //
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+  if(on) {
+    rtc_control |= bit;
+  } else {
+    rtc_control &= ~bit;
+  }
+  write_RTC(0x8F, rtc_control);
+  
+  if(alarm != 0) {
+    // EIMSK is shared with the other external interrupts: its
+    // read-modify-write must not be split by an ISR
+    unsigned char sreg = __save_interrupt();
+    __disable_interrupt();
+    if(on) {
+      EIFR = (1 << INTF3);      // Clear an edge seen while Alarm 1 was off
+      SETBIT(EIMSK, INT3);
+    } else {
+      CLEARBIT(EIMSK, INT3);
+    }
+    __restore_interrupt(sreg);
+  }
 }
 
 /*************************************************************************************
@@ -140,37 +164,23 @@ void SPI_rtc_DS1306_config() {
  In the DS1306 data sheet this operation is called an SPI single-byte write.
 *************************************************************************************/
 static void write_RTC(unsigned char reg_RTC, unsigned char data_RTC) {
-  SETBIT(PORTA, 1);             // Select DS1306
+  spi_begin(spi_rtc);           // Select DS1306
 
   /*----- Delay tcc -----*/
      __delay_cycles(16);
   /*---------------------*/
      
   /*----------------------- SEND ADDRESS -----------------------*/
-  SPDR = reg_RTC;               // Send Address
-
-  // --- Wait for Address to be sent --- //
-  while(!(SPSR & (1 << SPIF))) {}           
-
-  // --- Clear SPIF in SPSR --- //
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+  spi_transfer(reg_RTC);        // Send Address
  
   /*----------------------- SEND DATA -----------------------*/
-  SPDR = data_RTC;              // Send Data
-  
-  // --- Wait for Data to be sent --- //
-  while(!(SPSR & (1 << SPIF))) {} 
-
-  // --- Clear SPIF in SPSR --- //
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+  spi_transfer(data_RTC);       // Send Data
   
   /*----- Delay tcch -----*/
      __delay_cycles(1);
   /*---------------------*/
   
-  CLEARBIT(PORTA, 1);           // De-select DS1306
+  spi_end(spi_rtc);             // De-select DS1306
 
   /*----- Delay tcwh -----*/
      __delay_cycles(16);
@@ -192,39 +202,23 @@ static void write_RTC(unsigned char reg_RTC, unsigned char data_RTC) {
  single-byte read.
 *********************************************************************/
 unsigned char read_RTC(unsigned char reg_RTC) {
-  SETBIT(PORTA, 1);             // Select DS1306
+  spi_begin(spi_rtc);           // Select DS1306
 
   /*----- Delay tcc -----*/
      __delay_cycles(16);
   /*---------------------*/
 
   /*----------------------- SEND ADDRESS -----------------------*/
-  SPDR = reg_RTC;               // Send Address
-
-  // --- Wait for Address to be sent --- //
-  while(!(SPSR & (1 << SPIF))) {} 
-
-  // --- Clear SPIF in SPSR --- //
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+  spi_transfer(reg_RTC);        // Send Address
   
  /*----------------------- READ DATA -----------------------*/
-  SPDR = 0xFF;                  // Dummy data to start clock
-  
-  // --- Wait for Data to be read --- //
-  while(!(SPSR & (1 << SPIF))) {}  
-
-  data = SPDR;                  // Read data from SPDR buffer
-  
-  // --- Clear SPIF in SPSR --- //
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+  data = spi_transfer(0xFF);    // Dummy data to start clock, read data
   
   /*----- Delay tcch -----*/
      __delay_cycles(1);
   /*---------------------*/
   
-  CLEARBIT(PORTA, 1);           // De-select DS1306
+  spi_end(spi_rtc);             // De-select DS1306
 
   /*----- Delay tcwh -----*/
      __delay_cycles(16);
@@ -247,39 +241,25 @@ unsigned char read_RTC(unsigned char reg_RTC) {
  the address of the source array.
 *******************************************************************************/
 void block_write_RTC(volatile unsigned char *array_ptr, unsigned char strt_addr, unsigned char count) {
-  SETBIT(PORTA, 1);             // Select DS1306
+  spi_begin(spi_rtc);           // Select DS1306
 
   /*----- Delay tcc -----*/
      __delay_cycles(16);
   /*---------------------*/
      
   /*----------------------- SEND ADDRESS -----------------------*/
-  SPDR = strt_addr;             // Send Address
-  
-  // --- Wait for Address to be sent --- //
-  while(!(SPSR & (1 << SPIF))) {}           
-
-  // --- Clear SPIF in SPSR --- //
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+  spi_transfer(strt_addr);      // Send Address
   
   /*----------------------- SEND DATA -----------------------*/
   for(int i = 0; i < count; i++) {
-    SPDR = *(array_ptr + i);    // Send next byte of Data in array
-    
-    // --- Wait for Data to be sent --- //
-    while(!(SPSR & (1 << SPIF))) {} 
-
-    // --- Clear SPIF in SPSR --- //
-    TESTBIT(SPSR, SPIF);
-    TESTBIT(SPDR, 0);
+    spi_transfer(*(array_ptr + i));     // Send next byte of Data in array
   }
 
   /*----- Delay tcch -----*/
      __delay_cycles(1);
   /*---------------------*/
   
-  CLEARBIT(PORTA, 1);           // De-select DS1306
+  spi_end(spi_rtc);             // De-select DS1306
 
   /*----- Delay tcwh -----*/
      __delay_cycles(16);
@@ -300,45 +280,30 @@ void block_write_RTC(volatile unsigned char *array_ptr, unsigned char strt_addr,
  count is the number of data bytes to be transferred and array_ptr is
  the address of the destination array.
 *******************************************************************************/
-static void block_read_RTC(volatile unsigned char *array_ptr, unsigned char strt_addr, unsigned char count) {
-  SETBIT(PORTA, 1);             // Select DS1306
+void block_read_RTC(volatile unsigned char *array_ptr, unsigned char strt_addr, unsigned char count) {
+  PROF_ENTER(prof_rtc_block_read);
+  spi_begin(spi_rtc);           // Select DS1306
 
   /*----- Delay tcc -----*/
      __delay_cycles(16);
   /*---------------------*/
      
   /*----------------------- SEND ADDRESS -----------------------*/
-  SPDR = strt_addr;             // Send Address
-  
-  // --- Wait for Address to be sent --- //
-  while(!(SPSR & (1 << SPIF))) {}           
-
-  // --- Clear SPIF in SPSR --- //
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+  spi_transfer(strt_addr);      // Send Address
   
   /*----------------------- READ DATA -----------------------*/
   for(int i = 0; i < count; i++) {
-    SPDR = 0xFF;                // Dummy data to start clock
-
-    // --- Wait for Data to be read --- //
-    while(!(SPSR & (1 << SPIF))) {} 
-
-    array_ptr[i] = SPDR;        // Read next byte of data from SPDR buffer
-
-    // --- Clear SPIF in SPSR --- //
-    TESTBIT(SPSR, SPIF);
-    TESTBIT(SPDR, 0);
-    
+    array_ptr[i] = spi_transfer(0xFF);  // Dummy data to start clock, read next byte
   }
 
   /*----- Delay tcch -----*/
      __delay_cycles(1);
   /*---------------------*/
   
-  CLEARBIT(PORTA, 1);           // De-select DS1306
+  spi_end(spi_rtc);             // De-select DS1306
 
   /*----- Delay tcwh -----*/
      __delay_cycles(16);
   /*---------------------*/
+  PROF_EXIT(prof_rtc_block_read);
 }
\ No newline at end of file
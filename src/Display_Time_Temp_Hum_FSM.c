@@ -11,16 +11,34 @@
   - Time, in a 24 hour format 
   - Temperature and Humidity 
   on an the LCD screen. 
-  Display is updated every second.
+  Display is updated every second, on the DS1306 1Hz output.
   The Time and Alarm 0 of the DS1306 can be changed by the user,
   through the 4x4 Keypad.
   This is implemented using a Table Driven FSM.
+  The interrupt service routines only post events. The main loop
+  gets each event and runs the FSM and the sensor reads, updates
+  the display model, and lets view.c draw the page that changed.
 *********************************************************************/
   
 // ----- Include Files ----- //
 #include "header.h"     // Includes the ATmega128 Definitions, Macros, and Intrinsic functions
 #include "DS1306.h"
 #include "FSM.h"
+#include "lcd.h"
+#include "humidicon.h"
+#include "events.h"
+#include "power.h"
+#include "co2.h"
+#include "history.h"
+#include "nv_stats.h"
+#include "eelog.h"
+#include "profile.h"
+#include "telemetry.h"
+#include "clock.h"
+#include "timeout.h"
+#include "keypad.h"
+#include "alarm.h"
+#include "view.h"
 
 // Gloabl varaible that holds the present state of the FSM
 state present_state = idle;
@@ -28,97 +46,231 @@ state present_state = idle;
 // Initially display celcius
 bool tempCF = true;
 
+// Seconds since reset, used to time stamp the sensor history
+static unsigned int tick_count;
+
 // ----- Local Function Prototypes ----- //
-void check_release();
-void init_ADC();
-
-// PortB pin numbers for columns and rows of the keypad
-#define COL1  7   
-#define COL2  6
-#define COL3  5
-#define COL4  4
-#define ROW1  3
-#define ROW2  2
-#define ROW3  1
-#define ROW4  0
-   
+static void key_event(unsigned char key_ev);
+static void tick_event();
+static void alarm0_event();
+static void alarm1_event();
+static void update_view();
+static void render_view();
+static void enable_ext_int(unsigned char intNum);
+
 // Key table
 const key kTable[16] =  {del, co2, zero, tempChange, back, nine, eight, seven, setAlarm0, six, five, four, setTime, three, two, one};
 
 /****************************************************
-  ISR Name             : __interrupt void ISR_INT0()
+  Function             : static void key_event(
+                         unsigned char key_ev)
   Target MCU           : ATmega128A
   Author               : Wilmer Suarez
   Version              : 2.0
   DESCRIPTION
-  Interrupt service routine for INT0.
-  Occurs when a key is pressed.
+  Handles one event of the keypad FIFO. Presses run 
+  the FSM; only DEL (backspace) auto-repeats, and 
+  releases are ignored. A pending prompt step is run
+  first; if it changed the state the key only ends 
+  the prompt.
 ****************************************************/
-#pragma vector=INT0_vect              // Vector Location for INT0 interrupt
-__interrupt void ISR_INT0() {
-  char keycode;                       // Holds key table position
+static void key_event(unsigned char key_ev) {
   key keypressed;                     // Holds key type value
   
-  if(!TESTBIT(PINC,ROW1))             // Find Row of pressed key
-    keycode = 0;
-  else if(!TESTBIT(PINC,ROW2))
-    keycode = 4;
-  else if(!TESTBIT(PINC,ROW3))
-    keycode = 8;
-  else if(!TESTBIT(PINC,ROW4))
-    keycode = 12;
-  
-  DDRC = 0x0F;                        // Reconfigure PORTC for Columns
-  PORTC = 0xF0;
-  
-  __delay_cycles(256);                // Let PORTC settle
-  
-  if(!TESTBIT(PINC,COL1))             // Find Column
-    keycode += 0;
-  else if(!TESTBIT(PINC,COL2))
-    keycode += 1;
-  else if(!TESTBIT(PINC,COL3))
-    keycode += 2;
-  else if(!TESTBIT(PINC,COL4))
-    keycode += 3;
-  
-  DDRC = 0xF0;                        // Reconfigure PORTC for Rows for next keypad press
-  PORTC = 0x0F;
+  keypressed = (kTable[key_ev & KEY_CODE_MASK]);    // Get key value from table 
+  switch(key_ev & KEY_TYPE_MASK) {
+    case KEY_PRESS:
+      break;
+    case KEY_REPEAT:
+      if(keypressed == del) {
+        break;
+      }
+      return;
+    default:
+      return;
+  }
   
-  keypressed = (kTable[keycode]);     // Get key value from table 
-  check_release();                    // Wait for keypad release.
+  humidicon_sample_fast();            // Fresh values while the user is at the keypad
   
   // FSM called 
-  if(keypressed != tempChange) {
+  if(prompt_finish()) {
+    // Key used to end the prompt
+  } else if(keypressed != tempChange) {
     // ---------- FSM Call ---------- //
     fsm(present_state, keypressed);   // Execute function associated with the keypressed variable
                                       // and update the present
   } else {
     tempCF = !tempCF;
+    nv_stats_set_tempCF(tempCF);      // Kept in the DS1306 user RAM
+    view_set_tempCF(tempCF);
   }
 
-  // Disable INT1 when present_state is not idle
-  if(present_state != idle) {
-    EIMSK = 0x05;                 
-  } else {
-    EIMSK = 0x07;             
-  }
 }
 
 /****************************************************
   ISR Name             : __interrupt void ISR_INT2()
   Target MCU           : ATmega128A
   Author               : Wilmer Suarez
-  Version              : 1.0
+  Version              : 2.0
   DESCRIPTION
   Interrupt service routine for INT2.
-  Occurs when the active low interrupt of 
-  the DS1306.
+  Occurs when the active low interrupt /INT0 
+  (Alarm 0) of the DS1306. INT2 stays disabled 
+  until the main loop has cleared IRQF0.
 ****************************************************/
 #pragma vector=INT2_vect        // Vector Location for INT2 interrupt
 __interrupt void ISR_INT2() {
+  CLEARBIT(EIMSK, INT2);        // Re-enabled by the main loop
+  post_event(ev_alarm0, 0);
+}
+
+/****************************************************
+  ISR Name             : __interrupt void ISR_INT3()
+  Target MCU           : ATmega128A
+  Author               : Wilmer Suarez
+  Version              : 2.0
+  DESCRIPTION
+  Interrupt service routine for INT3.
+  Occurs on the rising edge of the active high 
+  output 1INT (Alarm 1) of the DS1306. INT3 is only
+  unmasked while Alarm 1 is enabled 
+  (DS1306_alarm_enable).
+****************************************************/
+#pragma vector=INT3_vect        // Vector Location for INT3 interrupt
+__interrupt void ISR_INT3() {
+  post_event(ev_alarm1, 0);
+}
+
+/****************************************************
+  Function             : static void tick_event()
+  Target MCU           : ATmega128A
+  Author               : Wilmer Suarez
+  Version              : 1.0
+  DESCRIPTION
+  Handles the 1 second tick posted by 
+  display_time_ISR. Checks the alarm limits, adds the
+  readings to the sensor history, and starts the next
+  CO2 burst.
+  The tick keeps running in every state; the time is
+  only drawn on the idle screen (view.c).
+****************************************************/
+static void tick_event() {
+  unsigned int rh, temp, co2;
+  unsigned char ch;
+  
+  display_time();               // Advance the clock, measure Temp & Hum
+  
+  // ----- Add the latest readings to the sensor history ----- //
+  humidicon_raw(&rh, &temp);
+  co2_read(&co2);
+  if(alarm_check(rh, temp, co2)) {
+    for(ch = 0; ch < alarm_channels; ch++) {
+      view_set_alarm((alarm_channel)ch, alarm_get((alarm_channel)ch));
+    }
+  }
+  history_add(tick_count, rh, temp, co2);
+  nv_stats_add(rh, temp, co2);
+  eelog_tick(rh, temp, co2);    // EEPROM log record every 5 minutes
+  telemetry_tick(tick_count, rh, temp);
+  tick_count++;
+  
+  update_view();                // New time for the display model
+  
+  co2_start_burst();            // Next oversampled CO2 value
+}
+
+/****************************************************
+  Function             : static void alarm0_event()
+  Target MCU           : ATmega128A
+  Author               : Wilmer Suarez
+  Version              : 1.0
+  DESCRIPTION
+  Handles the DS1306 Alarm 0 interrupt posted by 
+  ISR_INT2.
+****************************************************/
+static void alarm0_event() {
   CLEARBIT(PORTA, 2);           // Set PORTA test Pin
   read_RTC(0x07);               // Clear IRQF0 (Interrupt 0 Request Flag)
+  enable_ext_int(INT2);
+}
+
+/****************************************************
+  Function             : static void alarm1_event()
+  Target MCU           : ATmega128A
+  Author               : Wilmer Suarez
+  Version              : 1.0
+  DESCRIPTION
+  Handles the DS1306 Alarm 1 interrupt posted by 
+  ISR_INT3. Clearing IRQF1 takes 1INT low again, 
+  ready for the next rising edge.
+****************************************************/
+static void alarm1_event() {
+  read_RTC(0x0B);               // Clear IRQF1 (Interrupt 1 Request Flag)
+}
+
+/****************************************************
+  Function             : static void update_view()
+  Target MCU           : ATmega128A
+  Author               : Wilmer Suarez
+  Version              : 1.0
+  DESCRIPTION
+  Copies the time, the Humidicon readings, and the 
+  CO2 sample into the display model. Only the values
+  that changed mark a page for drawing.
+****************************************************/
+static void update_view() {
+  const clock_time *now = clock_now();
+  unsigned int rh, temp;
+  unsigned char n;
+  
+  view_set_time(now->hours, now->minutes, now->seconds);
+  for(n = 0; n < HUMIDICON_COUNT; n++) {
+    humidicon_sensor_scaled(n, &rh, &temp);
+    view_set_sensor(n, rh, temp);
+  }
+  if(co2_read(&temp)) {
+    view_set_co2(temp);
+  }
+}
+
+/****************************************************
+  Function             : static void render_view()
+  Target MCU           : ATmega128A
+  Author               : Wilmer Suarez
+  Version              : 1.0
+  DESCRIPTION
+  Called after every event. Picks the page for the
+  present state (none while the FSM or a prompt uses
+  the LCD) and draws it if it changed.
+****************************************************/
+static void render_view() {
+  if(prompt_active()) {
+    view_show(page_none);
+  } else if(present_state == idle) {
+    view_show(page_sensor);
+  } else if(present_state == dispCO2) {
+    view_show(page_co2);
+  } else {
+    view_show(page_none);
+  }
+  view_render();
+}
+
+/****************************************************
+  Function             : static void enable_ext_int(
+                         unsigned char intNum)
+  Target MCU           : ATmega128A
+  Author               : Wilmer Suarez
+  Version              : 1.0
+  DESCRIPTION
+  Sets the EIMSK bit of an external interrupt from
+  the main loop. Interrupts are disabled during the
+  read-modify-write since the ISRs also clear bits.
+****************************************************/
+static void enable_ext_int(unsigned char intNum) {
+  __disable_interrupt();
+  SETBIT(EIMSK, intNum);
+  __enable_interrupt();
 }
 
 // -------------------------- Main -------------------------- //
@@ -130,60 +282,100 @@ int main() {
   CLEARBIT(PORTA, 1);               // Initially de-select DS1306 RTC
   
   // Port C Configurations for keypad (initial configuration)
-  DDRC = 0xF0;                      // High nibble outputs, low nibble inputs 
-  PORTC = 0x0F;                     // High nibble outputs 0's initially
+  init_keypad();
 
   // Port B Configurations for SPI
   DDRB = (1 << DDB0) | (1 << DDB1) | (1 << DDB2) | (1 << DDB4);         // SCK, /SS, RS, MOSI: Output, MISO: Input, 
   SETBIT(PORTB, 0);                                                     // Initially de-select LCD 
   
   // -------------------------- PORTD & Interrupt Configuration -------------------------- //
-  DDRD = 0xF8;                      // INT0, INT1, INT2 Input
-  PORTD = 0x01;                     // INT0 pullup enabled
-  MCUCR = 0x30;                     // Sleep enabled for power down mode.
-  EIMSK = 0x03;                     // Enable interrupt INT0, INT1, and INT2.
-                                    // Sense control (@EICRA) is low by default
+  DDRD = 0xF0;                      // INT0, INT1, INT2, INT3 Input
+  PORTD = 0x05;                     // INT0 and INT2 (DS1306 /INT0 is open drain) pullups enabled
+  MCUCR = 0x00;                     // Sleep mode is selected by sleep_until_event()
+  EICRA = (1 << ISC11) | (1 << ISC31) | (1 << ISC30);
+                                    // INT1 (DS1306 1Hz output): falling edge
+                                    // INT3 (DS1306 1INT, active high): rising edge
+                                    // INT0, INT2: low level
+  EIFR = (1 << INTF1) | (1 << INTF3);   // Clear edges seen before the DS1306 was set up
+  EIMSK = 0x07;                     // Enable interrupt INT0, INT1, and INT2. INT3 is 
+                                    // enabled with Alarm 1 (DS1306_alarm_enable)
+  
+  // --------------- Initialize ADC (CO2 sampled in the background) --------------- //
+  init_co2();
+  
+  // --------------- Initialize LCD (power-on sequence runs only once) --------------- //
+  init_lcd_dog();
   
-  // --------------- Initialize ADC --------------- //
-  init_ADC();
+  // --------------- Initialize USART0 for the telemetry stream --------------- //
+  init_telemetry();
   
   // ------------------------------ DS1306 interrupt Configuration ------------------------------ //
-  // Initial Configuration for DS1306's alarm 0 and interrupt 0
+  // 1Hz output on, Alarm 0 and Alarm 1 interrupts off until the user sets them
   DS1306_RTC_config();
+  clock_sync(false);                // Software clock starts from the DS1306 time
+  
+  // --------------- Restore settings and daily stats from the DS1306 user RAM --------------- //
+  nv_stats_init();
+  view_set_tempCF(tempCF);          // Unit restored by nv_stats_init()
+  
+  // --------------- Find the EEPROM log write head --------------- //
+  eelog_init();
+  
+  // --------------- Start the first Humidicon measurement --------------- //
+  init_humidicon();                 // Chip selects of the other sensors
+  start_humidicon();
+  
+  // --------------- Default alarm limits, alarm output off --------------- //
+  init_alarms();
+  
+  // --------------- Start the event time base --------------- //
+  init_events();
+  init_timeouts();
+  prof_init();                      // Probes are timed with Timer3
   
   __enable_interrupt();             // Enable global interrutps
   
+  // -------------------------- Event Loop -------------------------- //
   while(1) {
-    // Continuously wait for interrupt (every 1 second (1Hz))
+    event ev;
+    
+    if(get_event(&ev)) {
+      switch(ev.type) {
+        case ev_key: {
+          unsigned char key_ev;
+          
+          while(keypad_get(&key_ev)) {
+            key_event(key_ev);        // Also picks up keys whose ev_key was dropped
+          }
+          break;
+        }
+        case ev_tick:
+          tick_event();
+          break;
+        case ev_alarm0:
+          alarm0_event();
+          break;
+        case ev_alarm1:
+          alarm1_event();
+          break;
+        case ev_humidicon:
+          if(humidicon_ready()) {
+            fetch_humidicon();      // Conversion done, read it now (unless the tick already did)
+          }
+          update_view();
+          break;
+        case ev_timeout:
+          if((ev.data == to_prompt) && !timeout_running(to_prompt)) {
+            prompt_finish();        // Prompt time is up (a re-armed timeout is not)
+          }
+          break;
+        case ev_lcd:
+          update_lcd_dog();         // Queue the runs a full LCD queue deferred
+          break;
+      }
+      render_view();                // Draws only a page switch or a model change
+    } else {
+      sleep_until_event();          // Idle or Power-down until the next interrupt
+    }
   }
-}
-
-/*******************************************
-  Function             : void init_ADC()
-  Target MCU           : ATmega128 @ 16MHz
-  Author               : Wilmer Suarez
-  Version              : 1.0
-  DESCRIPTION
-  Initialize ADC 
-*******************************************/
-void init_ADC() {
-  ADMUX = 0xC3;         // ADC3, Internal 2.56V as Reference
-  ADCSRA = 0x87;        // Enable ADC, Set Prescaler to 128 (125kHz)
-}
-
-/******************************************************
-  Function             : void DS1306_RTC_config()
-  Target MCU           : ATmega128 @ 16MHz
-  Author               : Wilmer Suarez
-  Version              : 1.0
-  DESCRIPTION
-  This function checks if the keypad has been released 
-  and not bouncing.
-******************************************************/
-void check_release(void) {
-  while(!TESTBIT(PIND,0));     // Check that keypad key is released.
-  
-  __delay_cycles(50000);       // Delay (.05secs) / (1 / 1MHz) cycles.
-  
-  while(!TESTBIT(PIND,0));     // Check that key has stopped bouncing.
-}
+}
\ No newline at end of file
@@ -13,7 +13,7 @@
 *********************************************/
 
 // ---------- FSM States ---------- //
-typedef enum{idle, changeTime, changeAlarm0, dispCO2} state ;
+typedef enum{idle, changeTime, changeAlarm0, dispCO2, diag, state_count} state ;
 
 // ---------- Keys on the keypad ---------- //
 typedef enum {zero, one, two, three, four, five, six, seven, eight, nine, setTime, setAlarm0, back, tempChange, del, co2, eol} key ;
@@ -26,9 +26,13 @@ extern void changeTime_fn(key keyVal);       // Change the time in the DS1306
 extern void changeAlarm0_fn(key keyVal);     // Change the Alarm 0 in the DS1306
 extern void back_fn(key keyVal);             // Backspace
 extern void dispCO2_fn(key keyVal);          // Displays the measuremnt of CO2
-extern void display();                       // Helper function for dispCO2_fn
-extern void int2Hex(unsigned int result);    // Helper function for dispCO2_fn
+extern void sensor_fn(key keyVal);           // Selects the Humidicon shown on the idle screen
 extern void error_fn(key keyVal);            // Error Message
+extern void diag_fn(key keyVal);             // Hidden diagnostics screen (profiler)
+
+// Timed prompts (header.h must be included first)
+extern bool prompt_finish();                 // Run the pending prompt step now
+extern bool prompt_active();                 // A confirmation or message is shown
 
 // --- Present state variable declereation --- //
 extern state present_state;
\ No newline at end of file
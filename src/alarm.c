@@ -0,0 +1,276 @@
+/******************************************************************
+ File Name            : "alarm.c"
+ Title                : Threshold Alarms
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Raises an alarm when the temperature, the humidity, or the CO2
+ stays above a high limit or below a low limit for on_seconds, and
+ clears it once the samples have been back inside the limit by the
+ hysteresis for off_seconds.
+ 
+ alarm_check() runs on every 1 second tick. CO2 has a new sample on
+ every tick, but the Humidicon may be sampled up to every 
+ HUMIDICON_MAX_INTERVAL ticks (adaptive sampling). The Humidicon 
+ channels only look at fresh samples (humidicon_sequence changed), 
+ and a level lasts the seconds between the samples that point to
+ it, so a single cached sample never raises or clears an alarm.
+ 
+ The limits are given in display units and converted once, when 
+ they are configured, into raw 14-bit Humidicon codes and 12-bit 
+ CO2 ADC counts. Checking a sample is then a few unsigned compares,
+ with no scaling and no division. Both conversions are monotonic,
+ so the raw compares match the scaled ones.
+ 
+ Any active alarm drives ALARM_PIN high. The levels are shown on 
+ the LCD by view.c. CO2 samples are ignored while the sensor is
+ preheating (or has no sample yet).
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "humidicon.h"
+#include "co2.h"
+#include "alarm.h"
+
+// ----- Alarm output ----- //
+#define ALARM_PORT      PORTD
+#define ALARM_DDR       DDRD
+#define ALARM_PIN       7               // Active high
+
+// A structure alarm_rule holds the raw limits and the state of one channel.
+typedef struct {
+  unsigned int low_on;                  // Below: alarm_low (0: no low limit)
+  unsigned int low_off;                 // At or above: alarm_low is cleared
+  unsigned int high_on;                 // Above: alarm_high (0xFFFF: no high limit)
+  unsigned int high_off;                // At or below: alarm_high is cleared
+  unsigned char on_seconds;
+  unsigned char off_seconds;
+  unsigned char count;                  // Seconds the pending level has lasted
+  alarm_level pending;                  // Level the samples point to
+  alarm_level level;                    // Reported level
+} alarm_rule;
+
+static alarm_rule alarm_rules[alarm_channels];
+static unsigned char alarm_hum_sequence;    // Last Humidicon sample checked
+static unsigned char alarm_hum_seconds;     // Seconds since then
+unsigned int alarm_raised_count;
+
+// Default limits, in display units
+static const alarm_limits alarm_defaults[alarm_channels] = {
+//   LOW        HIGH       HYST  ON  OFF
+    {500,       3500,      50,   10, 10},   // Temperature: 5.00C -> 35.00C
+    {3000,      9000,      200,  10, 10},   // Humidity: 30.00% -> 90.00% RH
+    {ALARM_OFF, 2000,      100,  10, 10}    // CO2: above 2000ppm
+};
+
+// ----- Local Function Prototypes ----- //
+static unsigned int alarm_to_raw(alarm_channel ch, int value);
+static bool alarm_run(alarm_rule *r, unsigned int raw, unsigned char seconds);
+
+/*************************************************************
+ Function             : void init_alarms()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Configures every channel with its default limits and
+ turns the alarm output off.
+*************************************************************/
+void init_alarms() {
+  unsigned char ch;
+  
+  CLEARBIT(ALARM_PORT, ALARM_PIN);
+  SETBIT(ALARM_DDR, ALARM_PIN);
+  
+  for(ch = 0; ch < alarm_channels; ch++) {
+    alarm_configure((alarm_channel)ch, &alarm_defaults[ch]);
+  }
+}
+
+/*************************************************************
+ Function             : void alarm_configure(
+                        alarm_channel ch, 
+                        const alarm_limits *limits)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Converts the limits of channel ch to raw values and 
+ clears its alarm.
+*************************************************************/
+void alarm_configure(alarm_channel ch, const alarm_limits *limits) {
+  alarm_rule *r = &alarm_rules[ch];
+  
+  if(limits->low == ALARM_OFF) {
+    r->low_on = 0;                      // No sample is below 0
+    r->low_off = 0;
+  } else {
+    r->low_on = alarm_to_raw(ch, limits->low);
+    r->low_off = alarm_to_raw(ch, limits->low + (int)limits->hysteresis);
+  }
+  
+  if(limits->high == ALARM_OFF) {
+    r->high_on = 0xFFFF;                // No sample is above 0xFFFF
+    r->high_off = 0xFFFF;
+  } else {
+    r->high_on = alarm_to_raw(ch, limits->high);
+    r->high_off = alarm_to_raw(ch, limits->high - (int)limits->hysteresis);
+  }
+  
+  r->on_seconds = limits->on_seconds;
+  r->off_seconds = limits->off_seconds;
+  r->count = 0;
+  r->pending = alarm_ok;
+  r->level = alarm_ok;
+}
+
+/*************************************************************
+ Function             : bool alarm_check(unsigned int rh,
+                        unsigned int temp, unsigned int co2)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Called on every 1 second tick with the latest sample 
+ of each channel: the raw 14-bit humidity and 
+ temperature codes and the filtered 12-bit CO2 counts.
+ The humidity and temperature are only checked if the
+ Humidicon has a fresh sample. Sets the alarm output 
+ and returns true if the level of a channel changed.
+*************************************************************/
+bool alarm_check(unsigned int rh, unsigned int temp, unsigned int co2) {
+  bool changed = false;
+  unsigned char ch;
+  
+  // ----- Humidicon: fresh samples only ----- //
+  if(alarm_hum_seconds < 0xFF) {
+    alarm_hum_seconds++;
+  }
+  if(humidicon_sequence != alarm_hum_sequence) {
+    alarm_hum_sequence = humidicon_sequence;
+    if(alarm_run(&alarm_rules[alarm_temp], temp, alarm_hum_seconds)) {
+      changed = true;
+    }
+    if(alarm_run(&alarm_rules[alarm_rh], rh, alarm_hum_seconds)) {
+      changed = true;
+    }
+    alarm_hum_seconds = 0;
+  }
+  
+  // ----- CO2: a new sample every tick ----- //
+  if((co2 >= CO2_PREHEAT_COUNTS) && alarm_run(&alarm_rules[alarm_co2], co2, 1)) {
+    changed = true;
+  }
+  
+  if(changed) {
+    CLEARBIT(ALARM_PORT, ALARM_PIN);
+    for(ch = 0; ch < alarm_channels; ch++) {
+      if(alarm_rules[ch].level != alarm_ok) {
+        SETBIT(ALARM_PORT, ALARM_PIN);
+      }
+    }
+  }
+  return changed;
+}
+
+/*************************************************************
+ Function             : alarm_level alarm_get(
+                        alarm_channel ch)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the alarm level of channel ch.
+*************************************************************/
+alarm_level alarm_get(alarm_channel ch) {
+  return alarm_rules[ch].level;
+}
+
+/*************************************************************
+ Function             : static unsigned int alarm_to_raw(
+                        alarm_channel ch, int value)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Converts a limit of channel ch from display units to 
+ the raw value of its samples.
+*************************************************************/
+static unsigned int alarm_to_raw(alarm_channel ch, int value) {
+  if(ch == alarm_temp) {
+    return humidicon_temp_to_raw(value);
+  }
+  if(value < 0) {
+    value = 0;
+  }
+  if(ch == alarm_rh) {
+    return humidicon_rh_to_raw((unsigned int)value);
+  }
+  return co2_ppm_to_counts((unsigned int)value);
+}
+
+/*************************************************************
+ Function             : static bool alarm_run(
+                        alarm_rule *r, unsigned int raw,
+                        unsigned char seconds)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Compares one raw sample with the limits of a rule. 
+ seconds is the time since the previous sample of the
+ channel. A new level is only reported once the samples
+ in a row that point to it span on_seconds (alarm) or
+ off_seconds (clear); the first one counts as 1 second.
+ An active alarm is compared with its hysteresis limit.
+ Returns true if the reported level changed.
+*************************************************************/
+static bool alarm_run(alarm_rule *r, unsigned int raw, unsigned char seconds) {
+  alarm_level seen;
+  
+  // ----- Level this sample points to ----- //
+  if(r->level == alarm_high) {
+    seen = (raw > r->high_off) ? alarm_high : alarm_ok;
+  } else if(r->level == alarm_low) {
+    seen = (raw < r->low_off) ? alarm_low : alarm_ok;
+  } else if(raw > r->high_on) {
+    seen = alarm_high;
+  } else if(raw < r->low_on) {
+    seen = alarm_low;
+  } else {
+    seen = alarm_ok;
+  }
+  
+  if(seen == r->level) {
+    r->pending = seen;
+    r->count = 0;
+    return false;
+  }
+  
+  // ----- Time the pending level has lasted ----- //
+  if(seen != r->pending) {
+    r->pending = seen;
+    r->count = 1;
+  } else {
+    r->count = (r->count > 0xFF - seconds) ? 0xFF : (r->count + seconds);
+  }
+  if(r->count < ((seen == alarm_ok) ? r->off_seconds : r->on_seconds)) {
+    return false;
+  }
+  
+  r->level = seen;
+  r->count = 0;
+  if(seen != alarm_ok) {
+    alarm_raised_count++;
+  }
+  return true;
+}
@@ -0,0 +1,37 @@
+/****************************************************************
+  File Name            : "alarm.h" 
+  Title                : Threshold Alarm Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the alarm channels, their limits,
+  and the external functions used to configure the limits and
+  check each sample against them.
+  header.h must be included first.
+****************************************************************/ 
+
+#define ALARM_OFF       (-32767 - 1)    // Low or high limit not used
+
+// ------- Channels and alarm levels ------- //
+typedef enum {alarm_temp, alarm_rh, alarm_co2, alarm_channels} alarm_channel;
+typedef enum {alarm_ok, alarm_low, alarm_high} alarm_level;
+
+// Limits of one channel in display units: 0.01 degrees C, 0.01% RH, or ppm
+typedef struct {
+  int low;                          // Alarm below this, or ALARM_OFF
+  int high;                         // Alarm above this, or ALARM_OFF
+  unsigned int hysteresis;          // Cleared once back inside by this much
+  unsigned char on_seconds;         // Beyond a limit this long before the alarm is raised
+  unsigned char off_seconds;        // Back inside this long before the alarm is cleared
+} alarm_limits;
+
+// ------- External Functions for the Alarms ------- //
+extern void init_alarms();                                              // Default limits, output off
+extern void alarm_configure(alarm_channel ch, const alarm_limits *limits);
+extern bool alarm_check(unsigned int rh, unsigned int temp, unsigned int co2);   // Raw samples, true if a level changed
+extern alarm_level alarm_get(alarm_channel ch);
+
+// Number of alarms raised since reset
+extern unsigned int alarm_raised_count;
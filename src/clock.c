@@ -0,0 +1,206 @@
+/******************************************************************
+ File Name            : "clock.c"
+ Title                : Software Calendar Clock
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The MCU keeps the date and time itself and advances it by one 
+ second on every tick, so the display does not need a DS1306 read
+ and a BCD conversion every second.
+ 
+ The time is read back from the DS1306 (all 7 time and date 
+ registers in one burst) at boot, every CLOCK_SYNC_SECONDS, and
+ after the user sets the time. If a resync finds a different time
+ (a lost tick, or a tick that came twice) the difference is kept
+ in clock_last_drift and clock_drift_count is incremented.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "DS1306.h"
+#include "clock.h"
+
+static clock_time sw_clock;                      // Current time
+static bool clock_valid;                        // False until the first sync
+static unsigned int clock_sync_countdown;       // Seconds until the next resync
+unsigned int clock_syncs;
+unsigned int clock_drift_count;
+long clock_last_drift;
+
+// Days in each month of a common year
+static const unsigned char month_days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+// ----- Local Function Prototypes ----- //
+static void clock_advance();
+static unsigned char bcd_to_bin(unsigned char bcd);
+static unsigned char days_in_month(unsigned char month, unsigned char year);
+static unsigned long clock_seconds(const clock_time *t);
+
+/*************************************************************
+ Function             : void clock_sync(bool check_drift)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Reads the seconds->year registers of the DS1306 in one 
+ burst and sets the software clock. If check_drift is
+ true the time found is compared with the software time
+ first. It is false after the user sets the time.
+*************************************************************/
+void clock_sync(bool check_drift) {
+  unsigned char regs[7];
+  clock_time rtc;
+  long drift;
+  
+  block_read_RTC(regs, 0x00, 7);
+  rtc.seconds = bcd_to_bin(regs[0] & 0x7F);
+  rtc.minutes = bcd_to_bin(regs[1] & 0x7F);
+  rtc.hours = bcd_to_bin(regs[2] & 0x3F);       // 24 hour mode
+  rtc.day = regs[3] & 0x07;
+  rtc.date = bcd_to_bin(regs[4] & 0x3F);
+  rtc.month = bcd_to_bin(regs[5] & 0x1F);
+  rtc.year = bcd_to_bin(regs[6]);
+  
+  // ----- Check the software time ----- //
+  if(clock_valid && check_drift) {
+    drift = (long)(clock_seconds(&rtc) - clock_seconds(&sw_clock));
+    if(drift != 0) {
+      clock_drift_count++;
+      clock_last_drift = drift;
+    }
+  }
+  
+  sw_clock = rtc;
+  clock_valid = true;
+  clock_sync_countdown = CLOCK_SYNC_SECONDS;
+  clock_syncs++;
+}
+
+/*************************************************************
+ Function             : void clock_tick()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Advances the clock by one second. Resyncs with the 
+ DS1306 every CLOCK_SYNC_SECONDS, after the second has
+ been added so both times should agree.
+*************************************************************/
+void clock_tick() {
+  clock_advance();
+  if(!clock_valid || (--clock_sync_countdown == 0)) {
+    clock_sync(true);
+  }
+}
+
+/*************************************************************
+ Function             : static void clock_advance()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Adds one second with the minute, hour, day, month, leap
+ year, and year rollovers.
+*************************************************************/
+static void clock_advance() {
+  if(++sw_clock.seconds < 60) {
+    return;
+  }
+  sw_clock.seconds = 0;
+  if(++sw_clock.minutes < 60) {
+    return;
+  }
+  sw_clock.minutes = 0;
+  if(++sw_clock.hours < 24) {
+    return;
+  }
+  sw_clock.hours = 0;
+  
+  // ----- New day ----- //
+  sw_clock.day = (sw_clock.day >= 7) ? 1 : (sw_clock.day + 1);
+  if(++sw_clock.date <= days_in_month(sw_clock.month, sw_clock.year)) {
+    return;
+  }
+  sw_clock.date = 1;
+  if(++sw_clock.month <= 12) {
+    return;
+  }
+  sw_clock.month = 1;
+  sw_clock.year = (sw_clock.year >= 99) ? 0 : (sw_clock.year + 1);
+}
+
+/*************************************************************
+ Function             : const clock_time *clock_now()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the current software time. Only the main loop
+ advances the clock, so no copy is needed.
+*************************************************************/
+const clock_time *clock_now() {
+  return &sw_clock;
+}
+
+/*************************************************************
+ Function             : static unsigned char days_in_month(
+                        unsigned char month, 
+                        unsigned char year)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Every year divisible by 4 is a leap year from 2000 to 
+ 2099, like in the DS1306.
+*************************************************************/
+static unsigned char days_in_month(unsigned char month, unsigned char year) {
+  if((month < 1) || (month > 12)) {
+    return 31;
+  }
+  if((month == 2) && ((year & 0x03) == 0)) {
+    return 29;
+  }
+  return month_days[month - 1];
+}
+
+/*************************************************************
+ Function             : static unsigned long clock_seconds(
+                        const clock_time *t)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Seconds since 01/01/2000, used to measure the drift.
+*************************************************************/
+static unsigned long clock_seconds(const clock_time *t) {
+  unsigned int days = t->year * 365U + ((t->year + 3) >> 2);   // Leap days of the years before
+  
+  for(unsigned char m = 1; m < t->month; m++) {
+    days += days_in_month(m, t->year);
+  }
+  days += t->date - 1;
+  
+  return ((unsigned long)days * 24 + t->hours) * 3600 + t->minutes * 60U + t->seconds;
+}
+
+/*************************************************************
+ Function             : static unsigned char bcd_to_bin(
+                        unsigned char bcd)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Converts a DS1306 BCD register value to binary.
+*************************************************************/
+static unsigned char bcd_to_bin(unsigned char bcd) {
+  return (((bcd & 0xF0) >> 4) * 10) + (bcd & 0x0F);
+}
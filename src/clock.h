@@ -0,0 +1,36 @@
+/****************************************************************
+  File Name            : "clock.h" 
+  Title                : Software Clock Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the calendar time kept by the MCU
+  and the external functions used to advance it on the 1 second
+  tick and to resynchronize it with the DS1306.
+  header.h must be included first.
+****************************************************************/ 
+
+#define CLOCK_SYNC_SECONDS  3600    // Seconds between resyncs with the DS1306
+
+// ---------- Calendar time (binary, 24 hour) ---------- //
+typedef struct {
+  unsigned char seconds;            // 0->59
+  unsigned char minutes;            // 0->59
+  unsigned char hours;              // 0->23
+  unsigned char day;                // Day of the week 1->7
+  unsigned char date;               // Day of the month 1->31
+  unsigned char month;              // 1->12
+  unsigned char year;               // 0->99 (2000->2099)
+} clock_time;
+
+// ------- External Functions for the Software Clock ------- //
+extern void clock_sync(bool check_drift);       // 7 register burst read of the DS1306
+extern void clock_tick();                       // Advance 1 second, resync when due
+extern const clock_time *clock_now();
+
+// ------- Counters ------- //
+extern unsigned int clock_syncs;                // Resyncs done
+extern unsigned int clock_drift_count;          // Resyncs that found a different time
+extern long clock_last_drift;                   // DS1306 minus software time of the last drift, in seconds
@@ -0,0 +1,286 @@
+/******************************************************************
+ File Name            : "co2.c"
+ Title                : CO2 Conversion
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Converts the 10-bit ADC3 result of the CO2 sensor (2.56V reference,
+ 2.5mV per count) to ppm without floating point.
+ 
+ The sensor curve is a piecewise-linear table of calibration points
+ sorted by ADC counts. The slope of each segment is computed once, 
+ in ppm per count with 8 fraction bits, when the table is set, so a
+ conversion is one subtraction, one multiply, and a shift.
+ Counts past the last point use the slope of the last segment.
+ Points that do not rise in both counts and ppm are skipped, a 
+ slope steeper than 255.99ppm per count is clamped, and a result
+ past 65535ppm is clamped to 65535ppm.
+ 
+ Classification (same as the voltage checks it replaces):
+ - Fault:      0V (0 counts)
+ - Preheating: below 400mV (160 counts)
+ 
+ Acquisition runs in the background. co2_start_burst() (called on 
+ every tick) enables the ADC, and the ADC Complete interrupt chains
+ CO2_OVERSAMPLE conversions of ADC3. Their sum is decimated to a 
+ 12-bit sample (2 extra bits for 4^2 samples) and fed to a first
+ order low pass filter. The main loop sleeps in ADC Noise Reduction
+ mode while the burst runs. co2_read() returns the filtered value at
+ once, so the display never waits for a conversion.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "co2.h"
+
+#define CO2_MAX_POINTS          8
+#define CO2_MAX_SLOPE           0xFFFFUL        // 255.99ppm per count
+
+// ----- Acquisition ----- //
+#define CO2_OVERSAMPLE          16      // 4^2 samples for 2 extra bits
+#define CO2_DECIMATE_SHIFT      2       // Sum of 16 10-bit samples -> 12 bits
+#define CO2_FILTER_SHIFT        2       // Low pass filter weight of a new sample: 1/4
+#define CO2_ADMUX               ((1 << REFS1) | (1 << REFS0) | 0x03)    // ADC3, internal 2.56V reference
+#define CO2_ADCSRA              ((1 << ADEN) | (1 << ADIE) | (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0))  // fosc/128 (125kHz)
+
+// A segment holds a calibration point and the slope to the next point
+typedef struct {
+  unsigned int counts;
+  unsigned int ppm;
+  unsigned int slope;           // ppm per count, 8 fraction bits (at most CO2_MAX_SLOPE)
+} co2_segment;
+
+// Default curve: 400mV -> 0ppm, 2000mV -> 5000ppm (3.125ppm per mV)
+static const co2_point co2_default_cal[2] = {
+  {160, 0},
+  {800, 5000}
+};
+
+static co2_segment co2_segments[CO2_MAX_POINTS];
+static unsigned char co2_segment_count;
+
+// ----- Acquisition state ----- //
+static unsigned int co2_sum;                    // Sum of the conversions of the burst
+static signed char co2_count;                   // Conversions in the burst, -1 for the discarded one
+static unsigned int co2_filter;                 // Filter state, 12-bit sample << CO2_FILTER_SHIFT
+static volatile unsigned int co2_filtered;      // Filtered 12-bit value
+static volatile bool co2_has_sample;            // False until the first burst is done
+
+/*************************************************************
+ Function             : bool co2_set_calibration(
+                        const co2_point *points, 
+                        unsigned char count)
+ Date                 : 10/16/2026
+ Version              : 1.1
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the calibration curve. points must be sorted by 
+ increasing counts and ppm. A point that is not above 
+ the last point kept in both counts and ppm is skipped,
+ and points past CO2_MAX_POINTS are ignored. Returns 
+ false, and sets the default curve, if fewer than 2 
+ points are left.
+*************************************************************/
+bool co2_set_calibration(const co2_point *points, unsigned char count) {
+  co2_segment *last;
+  unsigned long slope;
+  unsigned char n = 0;
+  
+  for(unsigned char i = 0; (i < count) && (n < CO2_MAX_POINTS); i++) {
+    if(n != 0) {
+      last = &co2_segments[n - 1];
+      if((points[i].counts <= last->counts) || (points[i].ppm <= last->ppm)) {
+        continue;               // Equal counts divide by zero, falling values wrap
+      }
+      slope = (((unsigned long)(points[i].ppm - last->ppm)) << 8) / (points[i].counts - last->counts);
+      last->slope = (slope > CO2_MAX_SLOPE) ? CO2_MAX_SLOPE : (unsigned int)slope;
+    }
+    co2_segments[n].counts = points[i].counts;
+    co2_segments[n].ppm = points[i].ppm;
+    co2_segments[n].slope = 0;
+    n++;
+  }
+  
+  if(n < 2) {
+    co2_set_calibration(co2_default_cal, 2);    // Not a curve
+    return false;
+  }
+  
+  // The last point extends the last segment
+  co2_segments[n - 1].slope = co2_segments[n - 2].slope;
+  co2_segment_count = n;
+  return true;
+}
+
+/*************************************************************
+ Function             : co2_status co2_convert(
+                        unsigned int counts, unsigned int *ppm)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Classifies an oversampled 12-bit ADC result (4 counts per
+ 10-bit count) and, if it is valid, writes the CO2 
+ concentration in ppm to *ppm. The default curve is 
+ loaded on the first call if none was set.
+*************************************************************/
+co2_status co2_convert(unsigned int counts, unsigned int *ppm) {
+  const co2_segment *seg;
+  unsigned long result;
+  unsigned char i;
+  
+  if(counts == 0) {
+    return co2_fault;
+  } else if(counts < CO2_PREHEAT_COUNTS) {
+    return co2_preheating;
+  }
+  
+  if(co2_segment_count == 0) {
+    co2_set_calibration(co2_default_cal, 2);
+  }
+  
+  // ----- Below the first point: clamp ----- //
+  if(counts <= (co2_segments[0].counts << 2)) {
+    *ppm = co2_segments[0].ppm;
+    return co2_valid;
+  }
+  
+  // ----- Find the segment and interpolate ----- //
+  // Calibration points are in 10-bit counts, the 2 extra bits join the 8 fraction bits of the slope
+  for(i = 1; (i < co2_segment_count) && (counts >= (co2_segments[i].counts << 2)); i++);
+  seg = &co2_segments[i - 1];
+  result = seg->ppm + (((unsigned long)(counts - (seg->counts << 2)) * seg->slope) >> 10);
+  *ppm = (result > 0xFFFF) ? 0xFFFF : (unsigned int)result;
+  
+  return co2_valid;
+}
+
+/*************************************************************
+ Function             : unsigned int co2_ppm_to_counts(
+                        unsigned int ppm)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Inverse of co2_convert(): returns the lowest 12-bit ADC
+ result converted to ppm or more. Used to convert a limit
+ once, so samples are compared in counts. The default 
+ curve is loaded on the first call if none was set.
+*************************************************************/
+unsigned int co2_ppm_to_counts(unsigned int ppm) {
+  const co2_segment *seg;
+  unsigned char i;
+  unsigned long counts;
+  
+  if(co2_segment_count == 0) {
+    co2_set_calibration(co2_default_cal, 2);
+  }
+  
+  // ----- Find the segment: the last point at or below ppm ----- //
+  for(i = 1; (i < co2_segment_count) && (ppm >= co2_segments[i].ppm); i++);
+  seg = &co2_segments[i - 1];
+  if((ppm <= seg->ppm) || (seg->slope == 0)) {
+    return seg->counts << 2;
+  }
+  
+  // Rounded up, so co2_convert() of the result is not below ppm
+  counts = (seg->counts << 2) + ((((unsigned long)(ppm - seg->ppm) << 10) + seg->slope - 1) / seg->slope);
+  return (counts > 0xFFFF) ? 0xFFFF : (unsigned int)counts;
+}
+
+/*************************************************************
+ Function             : void init_co2()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Selects ADC3 with the internal 2.56V reference and starts
+ the first burst. The ADC is only enabled during a burst.
+*************************************************************/
+void init_co2() {
+  ADMUX = CO2_ADMUX;
+  ADCSRA = 0;
+  co2_start_burst();
+}
+
+/*************************************************************
+ Function             : void co2_start_burst()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Enables the ADC and starts a burst of conversions. The 
+ first conversion after enabling lets the reference settle
+ and is discarded. Does nothing if a burst is running.
+*************************************************************/
+void co2_start_burst() {
+  if(TESTBIT(ADCSRA, ADEN)) {
+    return;                     // Burst in progress
+  }
+  
+  co2_sum = 0;
+  co2_count = -1;
+  ADCSRA = CO2_ADCSRA | (1 << ADIF) | (1 << ADSC);   // Writing ADIF clears a stale flag
+}
+
+/*************************************************************
+ ISR Name             : __interrupt void co2_ADC_ISR()
+ Target MCU           : ATmega128 @ 16MHz
+ Date                 : 10/16/2026
+ Author               : Wilmer Suarez
+ Version              : 1.0
+ DESCRIPTION
+ ADC Complete interrupt. Adds the result to the burst and
+ starts the next conversion. After CO2_OVERSAMPLE results
+ the sum is decimated, filtered, and the ADC is disabled.
+*************************************************************/
+#pragma vector=ADC_vect                         // Vector Location for ADC Complete interrupt
+__interrupt void co2_ADC_ISR() {
+  unsigned int sample;
+  
+  if(co2_count >= 0) {
+    co2_sum += ADC;
+  }
+  
+  if(++co2_count < CO2_OVERSAMPLE) {
+    SETBIT(ADCSRA, ADSC);       // Next conversion of the burst
+    return;
+  }
+  
+  ADCSRA = 0;                   // Disable the ADC until the next burst
+  
+  // ----- Decimate and filter ----- //
+  sample = co2_sum >> CO2_DECIMATE_SHIFT;
+  if(!co2_has_sample) {
+    co2_filter = sample << CO2_FILTER_SHIFT;
+    co2_has_sample = true;
+  } else {
+    co2_filter += sample - (co2_filter >> CO2_FILTER_SHIFT);
+  }
+  co2_filtered = co2_filter >> CO2_FILTER_SHIFT;
+}
+
+/*************************************************************
+ Function             : bool co2_read(unsigned int *counts)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Writes the latest filtered 12-bit value to *counts. 
+ Returns false if no burst has finished yet.
+*************************************************************/
+bool co2_read(unsigned int *counts) {
+  __disable_interrupt();        // 16-bit value written by co2_ADC_ISR
+  *counts = co2_filtered;
+  __enable_interrupt();
+  
+  return co2_has_sample;
+}
@@ -0,0 +1,34 @@
+/****************************************************************
+  File Name            : "co2.h" 
+  Title                : CO2 Conversion Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the calibration points and the
+  external functions used to sample ADC3 in the background and
+  convert the CO2 sensor counts to ppm with integer math only.
+  header.h must be included first.
+****************************************************************/ 
+
+#define CO2_PREHEAT_COUNTS      (160 << 2)      // 400mV, in 12-bit counts (0.625mV each)
+
+// ------- Result of a conversion ------- //
+typedef enum {co2_fault, co2_preheating, co2_valid} co2_status;
+
+// One point of the sensor's voltage/ppm curve, in 10-bit ADC counts (2.5mV each)
+typedef struct {
+  unsigned int counts;
+  unsigned int ppm;
+} co2_point;
+
+// ------- External Functions for the CO2 Conversion ------- //
+extern bool co2_set_calibration(const co2_point *points, unsigned char count);    // False: default curve set
+extern co2_status co2_convert(unsigned int counts, unsigned int *ppm);   // 12-bit counts
+extern unsigned int co2_ppm_to_counts(unsigned int ppm);                  // Lowest 12-bit counts for ppm
+
+// ------- Background acquisition ------- //
+extern void init_co2();
+extern void co2_start_burst();                  // Oversampled burst, called every tick
+extern bool co2_read(unsigned int *counts);     // Filtered 12-bit value (0.625mV each)
@@ -0,0 +1,342 @@
+/******************************************************************
+ File Name            : "eelog.c"
+ Title                : Wear-Leveled EEPROM Sample Log
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Append-only log of the sensor readings in the 4KB internal EEPROM.
+ The EEPROM is a ring of 409 records of 10 bytes, written in
+ order, so every cell is written once per pass around the ring 
+ (the commit byte twice). A record every 5 minutes wears the worst
+ cell 2 times every 34 hours, so the 100k cycle endurance lasts 
+ over 190 years.
+ 
+ Record layout:
+ byte 0    : commit byte, the pass (lap) number 0->0xFD
+             0xFE = record being written, 0xFF = erased
+ byte 1-4  : year[26:20] month[19:16] date[15:11] hours[10:6] 
+             minutes[5:0] of the software clock (binary)
+ byte 5-9  : RH[7:0] Temp[7:0] CO2[7:0]
+             CO2[9:8]:RH[13:8]  CO2[11:10]:Temp[13:8]
+ 
+ A record is committed by writing 0xFE to its commit byte, then the
+ data bytes, then the lap number. A power failure leaves either the
+ old record, a record marked 0xFE (or erased, if the power failed
+ during the mark or the commit), or the new record, never a mix.
+ 
+ The records before the write head carry the current lap and the
+ ones after it the previous lap (or 0xFF on the first pass), so the
+ head is found at boot with a binary search of the commit bytes
+ (9 reads) instead of a scan of the whole EEPROM.
+ 
+ The bytes are written by the EE_READY interrupt, one per 8.5ms, so
+ a record never blocks the main loop. Only one record is written at
+ a time.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "clock.h"
+#include "eelog.h"
+
+#define EELOG_RECORD_SIZE   10
+#define EELOG_TICKS         300     // A record every 5 minutes
+#define EELOG_LAPS          0xFE    // Lap numbers 0->0xFD
+#define EELOG_WRITING       0xFE    // Commit byte while the record is written
+#define EELOG_ERASED        0xFF
+
+#define EELOG_ADDR(slot)    ((unsigned int)(slot) * EELOG_RECORD_SIZE)
+
+// ----- Write head ----- //
+static unsigned int eelog_head;             // Slot of the next record
+static unsigned char eelog_lap;             // Lap number of the next record
+static unsigned int eelog_ticks;            // Ticks since the last record
+
+// ----- Record being written by the EE_READY interrupt ----- //
+static unsigned char eelog_buffer[EELOG_RECORD_SIZE];
+static unsigned int eelog_write_addr;
+static volatile unsigned char eelog_step;   // Next byte to write, 0 = idle
+
+unsigned int eelog_count;
+unsigned int eelog_dropped;
+unsigned int eelog_torn;
+
+// ----- Local Function Prototypes ----- //
+static unsigned char eeprom_read(unsigned int addr);
+static void eeprom_start_write(unsigned int addr, unsigned char data);
+static unsigned char next_lap(unsigned char lap);
+
+/*************************************************************
+ Function             : void eelog_init()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Finds the write head and the lap number from the commit
+ bytes with a binary search. The first slot whose commit
+ byte differs from the one of slot 0 is the head. A slot
+ marked as being written, or left erased by a power
+ failure, is reused.
+*************************************************************/
+void eelog_init() {
+  unsigned char lap0 = eeprom_read(EELOG_ADDR(0));
+  unsigned char last = eeprom_read(EELOG_ADDR(EELOG_RECORDS - 1));
+  unsigned int low = 1, high = EELOG_RECORDS;
+  unsigned int mid;
+  
+  // ----- Empty log ----- //
+  if((lap0 == EELOG_ERASED) && (last == EELOG_ERASED)) {
+    eelog_head = 0;
+    eelog_lap = 0;
+    eelog_count = 0;
+    return;
+  }
+  
+  // ----- Power failed while slot 0 was written ----- //
+  if((lap0 == EELOG_WRITING) || (lap0 == EELOG_ERASED)) {
+    eelog_torn++;
+    eelog_head = 0;
+    eelog_lap = (last < EELOG_LAPS) ? next_lap(last) : 0;
+    eelog_count = (last < EELOG_LAPS) ? EELOG_RECORDS : 0;
+    return;
+  }
+  
+  // ----- First slot in [1, EELOG_RECORDS) not in lap0 ----- //
+  while(low < high) {
+    mid = (low + high) >> 1;
+    if(eeprom_read(EELOG_ADDR(mid)) == lap0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  
+  if(low == EELOG_RECORDS) {
+    eelog_head = 0;                 // Lap complete
+    eelog_lap = next_lap(lap0);
+    eelog_count = EELOG_RECORDS;
+    return;
+  }
+  
+  eelog_head = low;
+  eelog_lap = lap0;
+  if(eeprom_read(EELOG_ADDR(low)) == EELOG_WRITING) {
+    eelog_torn++;
+  }
+  eelog_count = (last == EELOG_ERASED) ? low : EELOG_RECORDS;
+}
+
+/*************************************************************
+ Function             : void eelog_tick(unsigned int rh_raw,
+                        unsigned int temp_raw, 
+                        unsigned int co2_counts)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Called on every tick. Appends a record every EELOG_TICKS
+ ticks.
+*************************************************************/
+void eelog_tick(unsigned int rh_raw, unsigned int temp_raw, unsigned int co2_counts) {
+  if(++eelog_ticks >= EELOG_TICKS) {
+    eelog_ticks = 0;
+    eelog_append(rh_raw, temp_raw, co2_counts);
+  }
+}
+
+/*************************************************************
+ Function             : bool eelog_append(unsigned int rh_raw,
+                        unsigned int temp_raw, 
+                        unsigned int co2_counts)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Takes the date and time of the software clock, packs the record,
+ and starts writing it. The first byte (0xFE mark) is 
+ written here and the EE_READY interrupt writes the rest.
+ Returns false if a record is still being written.
+*************************************************************/
+bool eelog_append(unsigned int rh_raw, unsigned int temp_raw, unsigned int co2_counts) {
+  const clock_time *now = clock_now();
+  unsigned long stamp;
+  
+  if(eelog_step != 0) {
+    eelog_dropped++;
+    return false;
+  }
+  
+  stamp = ((unsigned long)now->year << 20) | ((unsigned long)now->month << 16) |
+          ((unsigned int)now->date << 11) | ((unsigned int)now->hours << 6) | now->minutes;
+  
+  // ----- Pack the record ----- //
+  eelog_buffer[0] = eelog_lap;
+  eelog_buffer[1] = stamp;
+  eelog_buffer[2] = stamp >> 8;
+  eelog_buffer[3] = stamp >> 16;
+  eelog_buffer[4] = stamp >> 24;
+  eelog_buffer[5] = rh_raw;
+  eelog_buffer[6] = temp_raw;
+  eelog_buffer[7] = co2_counts;
+  eelog_buffer[8] = ((rh_raw >> 8) & 0x3F) | ((co2_counts >> 2) & 0xC0);
+  eelog_buffer[9] = ((temp_raw >> 8) & 0x3F) | ((co2_counts >> 4) & 0xC0);
+  
+  eelog_write_addr = EELOG_ADDR(eelog_head);
+  eelog_step = 1;
+  eeprom_start_write(eelog_write_addr, EELOG_WRITING);
+  SETBIT(EECR, EERIE);              // Rest of the record by interrupt
+  
+  // ----- Advance the head ----- //
+  if(eelog_count < EELOG_RECORDS) {
+    eelog_count++;
+  }
+  if(++eelog_head == EELOG_RECORDS) {
+    eelog_head = 0;
+    eelog_lap = next_lap(eelog_lap);
+  }
+  
+  return true;
+}
+
+/*************************************************************
+ Function             : void eelog_ISR()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ EEPROM ready interrupt. Writes the data bytes 1->9 
+ (EELOG_RECORD_SIZE - 1) and then the commit byte. The
+ interrupt is disabled when the commit byte has been 
+ written.
+*************************************************************/
+#pragma vector=EE_READY_vect                    // Vector Location for EEPROM Ready interrupt
+__interrupt void eelog_ISR() {
+  unsigned char step = eelog_step;
+  
+  if(step < EELOG_RECORD_SIZE) {
+    eeprom_start_write(eelog_write_addr + step, eelog_buffer[step]);
+    eelog_step = step + 1;
+  } else if(step == EELOG_RECORD_SIZE) {
+    eeprom_start_write(eelog_write_addr, eelog_buffer[0]);   // Commit
+    eelog_step = step + 1;
+  } else {
+    CLEARBIT(EECR, EERIE);
+    eelog_step = 0;
+  }
+}
+
+/*************************************************************
+ Function             : bool eelog_read(unsigned int age,
+                        eelog_record *rec)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Reads and unpacks a record, 0 being the newest. Returns
+ false if there is no such record, if it is not committed,
+ or if a record is being written.
+*************************************************************/
+bool eelog_read(unsigned int age, eelog_record *rec) {
+  unsigned char bytes[EELOG_RECORD_SIZE];
+  unsigned int slot;
+  unsigned long stamp;
+  
+  if((age >= eelog_count) || (eelog_step != 0)) {
+    return false;
+  }
+  
+  slot = (eelog_head + EELOG_RECORDS - 1 - age) % EELOG_RECORDS;
+  for(unsigned char i = 0; i < EELOG_RECORD_SIZE; i++) {
+    bytes[i] = eeprom_read(EELOG_ADDR(slot) + i);
+  }
+  if(bytes[0] >= EELOG_LAPS) {
+    return false;
+  }
+  
+  stamp = bytes[1] | ((unsigned int)bytes[2] << 8) | 
+          ((unsigned long)bytes[3] << 16) | ((unsigned long)bytes[4] << 24);
+  rec->year = (stamp >> 20) & 0x7F;
+  rec->month = (stamp >> 16) & 0x0F;
+  rec->date = (stamp >> 11) & 0x1F;
+  rec->hours = (stamp >> 6) & 0x1F;
+  rec->minutes = stamp & 0x3F;
+  rec->rh_raw = bytes[5] | ((unsigned int)(bytes[8] & 0x3F) << 8);
+  rec->temp_raw = bytes[6] | ((unsigned int)(bytes[9] & 0x3F) << 8);
+  rec->co2_counts = bytes[7] | ((unsigned int)(bytes[8] & 0xC0) << 2) | 
+                    ((unsigned int)(bytes[9] & 0xC0) << 4);
+  return true;
+}
+
+/*************************************************************
+ Function             : bool eelog_busy()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ True while a record is being written.
+*************************************************************/
+bool eelog_busy() {
+  return eelog_step != 0;
+}
+
+/*************************************************************
+ Function             : static unsigned char eeprom_read(
+                        unsigned int addr)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Reads one EEPROM byte. Only called when no write is in
+ progress.
+*************************************************************/
+static unsigned char eeprom_read(unsigned int addr) {
+  while(TESTBIT(EECR, EEWE));
+  EEAR = addr;
+  SETBIT(EECR, EERE);
+  return EEDR;
+}
+
+/*************************************************************
+ Function             : static void eeprom_start_write(
+                        unsigned int addr, unsigned char data)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Starts an EEPROM byte write. EEWE must be set within four
+ cycles of EEMWE, so interrupts are disabled around them.
+*************************************************************/
+static void eeprom_start_write(unsigned int addr, unsigned char data) {
+  unsigned char sreg = __save_interrupt();
+  
+  __disable_interrupt();
+  EEAR = addr;
+  EEDR = data;
+  SETBIT(EECR, EEMWE);
+  SETBIT(EECR, EEWE);
+  __restore_interrupt(sreg);
+}
+
+/*************************************************************
+ Function             : static unsigned char next_lap(
+                        unsigned char lap)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Lap numbers count 0->0xFD and wrap around.
+*************************************************************/
+static unsigned char next_lap(unsigned char lap) {
+  return (lap + 1 < EELOG_LAPS) ? (lap + 1) : 0;
+}
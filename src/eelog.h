@@ -0,0 +1,38 @@
+/****************************************************************
+  File Name            : "eelog.h" 
+  Title                : EEPROM Sample Log Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the log record and the external
+  functions used to append samples to the internal EEPROM and
+  to read them back. header.h must be included first.
+****************************************************************/ 
+
+#define EELOG_RECORDS   409         // 4KB EEPROM / 10 byte records
+
+// ---------- One logged sample ---------- //
+typedef struct {
+  unsigned char year;               // Date and time of the software clock (clock_now())
+  unsigned char month;
+  unsigned char date;
+  unsigned char hours;
+  unsigned char minutes;
+  unsigned int rh_raw;              // Raw Humidicon codes
+  unsigned int temp_raw;
+  unsigned int co2_counts;          // 12-bit CO2 counts
+} eelog_record;
+
+// ------- External Functions for the EEPROM Log ------- //
+extern void eelog_init();                       // Finds the write head, called once at boot
+extern void eelog_tick(unsigned int rh_raw, unsigned int temp_raw, unsigned int co2_counts);
+extern bool eelog_append(unsigned int rh_raw, unsigned int temp_raw, unsigned int co2_counts);
+extern bool eelog_read(unsigned int age, eelog_record *rec);   // age 0 = newest
+extern bool eelog_busy();
+
+// ------- Counters ------- //
+extern unsigned int eelog_count;                // Valid records in the log
+extern unsigned int eelog_dropped;              // Records lost because a write was in progress
+extern unsigned int eelog_torn;                 // Interrupted records found at boot
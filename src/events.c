@@ -0,0 +1,132 @@
+/******************************************************************
+ File Name            : "events.c"
+ Title                : Event Queue
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The interrupt service routines only post compact events to this
+ queue. The main loop gets them and runs the FSM, the sensor reads,
+ and the display updates, so a key press is never lost while the
+ clock is being refreshed, and the reverse.
+ 
+ Timer3 runs free at fosc/8 (0.5us per count). Each event is 
+ stamped when it is posted so the worst case latency from post to
+ get can be kept for every event type. Latencies longer than
+ 32.7ms wrap around.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "events.h"
+
+#define EVENT_QUEUE_SIZE    16      // Must be a power of 2
+#define EVENT_QUEUE_MASK    (EVENT_QUEUE_SIZE - 1)
+
+// ----- Event queue ----- //
+static event event_queue[EVENT_QUEUE_SIZE];
+static volatile unsigned char event_head;     // Next free entry
+static volatile unsigned char event_tail;     // Next event to get
+
+// ----- Latency counters ----- //
+unsigned int event_latency_max[ev_count];     // Worst case latency of each event type
+unsigned int event_counts[ev_count];          // Events handled of each event type
+unsigned int events_dropped;                  // Events lost because the queue was full
+
+/*************************************************************
+ Function             : void init_events()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Starts Timer3 in normal mode at fosc/8. It is used as the
+ time base for the event stamps.
+*************************************************************/
+void init_events() {
+  TCCR3A = 0;
+  TCCR3B = (1 << CS31);         // Normal mode, fosc/8
+}
+
+/*************************************************************
+ Function             : bool post_event(event_type type, 
+                        unsigned char data)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Adds an event to the queue. Interrupts are disabled while
+ the queue is updated so it can be called from an ISR or
+ from the main loop. Returns false (and counts the event as
+ dropped) if the queue is full.
+*************************************************************/
+bool post_event(event_type type, unsigned char data) {
+  unsigned char sreg = __save_interrupt();
+  unsigned char next;
+  
+  __disable_interrupt();
+  next = (event_head + 1) & EVENT_QUEUE_MASK;
+  if(next == event_tail) {
+    events_dropped++;
+    __restore_interrupt(sreg);
+    return false;
+  }
+  
+  event_queue[event_head].type = type;
+  event_queue[event_head].data = data;
+  event_queue[event_head].stamp = TCNT3;
+  event_head = next;
+  __restore_interrupt(sreg);
+  
+  return true;
+}
+
+/*************************************************************
+ Function             : bool get_event(event *ev)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Removes the oldest event from the queue and copies it to 
+ ev. Updates the latency counters of its type. Returns 
+ false if the queue is empty.
+*************************************************************/
+bool get_event(event *ev) {
+  unsigned int latency;
+  
+  __disable_interrupt();          // Called from the main loop only
+  if(event_head == event_tail) {
+    __enable_interrupt();
+    return false;
+  }
+  
+  *ev = event_queue[event_tail];
+  event_tail = (event_tail + 1) & EVENT_QUEUE_MASK;
+  latency = TCNT3 - ev->stamp;    // TCNT3 is read with interrupts off (shared TEMP register)
+  __enable_interrupt();
+  
+  // ----- Update the latency counters ----- //
+  if(latency > event_latency_max[ev->type]) {
+    event_latency_max[ev->type] = latency;
+  }
+  event_counts[ev->type]++;
+  
+  return true;
+}
+
+/*************************************************************
+ Function             : bool events_pending()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns true if the queue holds an event. Used by the 
+ sleep manager with interrupts disabled.
+*************************************************************/
+bool events_pending() {
+  return event_head != event_tail;
+}
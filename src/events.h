@@ -0,0 +1,34 @@
+/****************************************************************
+  File Name            : "events.h" 
+  Title                : Event Queue Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the events posted by the interrupt
+  service routines and the external functions used to post
+  them and to get them in the main loop.
+  header.h must be included first.
+****************************************************************/ 
+
+// ---------- Event types ---------- //
+typedef enum {ev_key, ev_tick, ev_alarm0, ev_alarm1, ev_humidicon, ev_timeout, ev_lcd, ev_count} event_type;
+
+// One queued event. stamp is the Timer3 count (0.5us per count) when it was posted.
+typedef struct {
+  unsigned char type;
+  unsigned char data;
+  unsigned int stamp;
+} event;
+
+// ------- External Functions for the Event Queue ------- //
+extern void init_events();                                 // Start the Timer3 time base
+extern bool post_event(event_type type, unsigned char data);    // Safe to call from an ISR
+extern bool get_event(event *ev);                          // Main loop, false if the queue is empty
+extern bool events_pending();                              // Call with interrupts disabled
+
+// ------- Latency counters (Timer3 counts from post to get) ------- //
+extern unsigned int event_latency_max[ev_count];
+extern unsigned int event_counts[ev_count];
+extern unsigned int events_dropped;
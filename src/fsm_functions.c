@@ -16,15 +16,26 @@
 #include "DS1306.h"
 #include "FSM.h"                // FSM State Function declerations
 #include "lcd.h"
-int result;            // Holds the result of the ADC conversion for CO2 measurements
-long decimalnum, quotient, remainder;   // Used when converting int to Hex
-char hex[3];                    // Holds the Hex values
+#include "profile.h"
+#include "clock.h"
+#include "timeout.h"
+#include "alarm.h"
+#include "view.h"
 static int positionT = 0;       // Keeps track of the LCD position for changeTime_fn
 static int positionA = 0;       // Keeps track of the LCD position for changeAlarm0_fin
 static int time = 0;            // timeValues array index
 static int indexM = 0;          // monthVal array index
 static int indexD = 0;          // dateVal array index
 static int indexY = 0;          // yearVal array index
+static unsigned char diagPage = 0;  // Profiler probe shown by diag_fn
+
+// ----- Timed prompts ----- //
+#define PROMPT_MS   1000        // A completed field is shown this long before the next prompt
+#define MESSAGE_MS  2000        // Error messages are shown this long
+
+typedef enum {prompt_none, prompt_text, prompt_set_time, prompt_set_alarm0, prompt_message} prompt_action;
+static prompt_action promptPending = prompt_none;   // Step run when the prompt time is up
+static const char *promptText;                      // Next prompt for prompt_text
 unsigned char RTC_write_time[7];// Holds the values to be written to the DS1306 registers
 unsigned char RTC_write_alarm[4];
 unsigned char timeValues[6];    // Holds the time
@@ -36,16 +47,25 @@ unsigned char alarmVal;         // Holds the type of alarm
 unsigned char *aPtr;  
 unsigned char hours, minutes, seconds, day, month, year;
 
+// ----- Local Function Prototypes ----- //
+static void set_time();
+static void set_alarm0();
+static void prompt_after(prompt_action action, const char *text, unsigned int ms);
+
 /******************************************************
  Function             : void changeTime_fn(key keyVal)
  Date                 : 04/09/2018
- Version              : 1.0
+ Version              : 2.0
  Target MCU           : ATmega128
  Author               : Wilmer Suarez
  DESCRIPTION
  Receives input form the keypad to update the value of 
  the time registers and the date registers
  (Hours, Minutes, Seconds, ect...) of the DS1306.
+ When a field is complete it stays on the LCD for 
+ PROMPT_MS (or until the next key) before the next 
+ prompt is shown. Nothing waits, so the clock and the
+ sensors keep running while the user types.
 ******************************************************/
 void changeTime_fn(key keyVal) {
   // --- INPUT MONTH --- //
@@ -56,11 +76,8 @@ void changeTime_fn(key keyVal) {
     monthVal[indexM++] = keyVal;
     printf("%d", keyVal);
     positionT++;
-    init_lcd_dog();                   // Initialize the Display
-    update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
     if(positionT == 3) {
-      __delay_cycles(16000000);        // Delay for 1 seconds
-      printf("\f   Enter Day:\n     01->31\n       dd\b\b");
+      prompt_after(prompt_text, "\f   Enter Day:\n     01->31\n       dd\b\b", PROMPT_MS);
       positionT++; 
     }  
   // --- INPUT DAY OF THE MONTH --- //
@@ -68,11 +85,8 @@ void changeTime_fn(key keyVal) {
     dateVal[indexD++] = keyVal;
     printf("%d", keyVal);                
     positionT++;
-    init_lcd_dog();                   // Initialize the Display
-    update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
     if(positionT == 6) {
-      __delay_cycles(16000000);         // Delay for 1 seconds
-      printf("\f   Enter Year:\n     00->99\n       YY\b\b");
+      prompt_after(prompt_text, "\f   Enter Year:\n     00->99\n       YY\b\b", PROMPT_MS);
       positionT++; 
     }
   // --- INPUT YEAR --- //
@@ -80,23 +94,17 @@ void changeTime_fn(key keyVal) {
     yearVal[indexY++] = keyVal;
     printf("%d", keyVal);               
     positionT++;
-    init_lcd_dog();                   // Initialize the Display
-    update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
     if(positionT == 9) {
-      __delay_cycles(16000000);         // Delay for 1 seconds
-       printf("\f Enter Weekday:\nMon->Sun (1->7)        d\b");
-       positionT++; 
+      prompt_after(prompt_text, "\f Enter Weekday:\nMon->Sun (1->7)        d\b", PROMPT_MS);
+      positionT++; 
     }
   // --- INPUT DAY OF WEEK --- // 
   } else if(positionT == 10){
     dayVal = keyVal;
     printf("%d", keyVal);
-    init_lcd_dog();                   // Initialize the Display
-    update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
     positionT++;
-    __delay_cycles(16000000);         // Delay for 2 seconds        
   // --- INPUT TIME --- // 
-    printf("\fChange the Time:    HH:mm:ss\b\b\b\b\b\b\b\b"); 
+    prompt_after(prompt_text, "\fChange the Time:    HH:mm:ss\b\b\b\b\b\b\b\b", PROMPT_MS);
   } else {
     if(positionT <= 18) {
       if(positionT == 13 || positionT == 16) {       // Skip the colons
@@ -106,67 +114,73 @@ void changeTime_fn(key keyVal) {
       timeValues[time++] = keyVal;              
       printf("%d", keyVal);
       positionT++;
-      init_lcd_dog();                   // Initialize the Display
-      update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
     } 
     if(positionT == 19) {
-      __delay_cycles(16000000);               
-      // Setup the time and day registers in the format required for the DS1306
-      hours = (timeValues[0] << 4) | timeValues[1];
-      minutes = (timeValues[2] << 4) | timeValues[3];
-      seconds = (timeValues[4] << 4) | timeValues[5];
-      day = (dateVal[0] << 4) | dateVal[1];
-      month = (monthVal[0] << 4) | monthVal[1];
-      year = (yearVal[0] << 4) | yearVal[1];
-      RTC_write_time[0] = seconds;
-      RTC_write_time[1] = minutes;
-      RTC_write_time[2] = hours;
-      RTC_write_time[3] = dayVal;
-      RTC_write_time[4] = day;
-      RTC_write_time[5] = month;
-      RTC_write_time[6] = year;
-      
-      if((hours <= 0x23) && (minutes <= 0x59) && (seconds <= 0x59) && (dayVal <= 0x07)
-         && (day <= 0x31) && (month <= 0x12) && (year <= 0x99)) {
-        // Configure Microcontroller SPI to communicate with the DS1306 RTC
-        SPI_rtc_DS1306_config();
-        aPtr = RTC_write_time;                 // Pointing to start of write Array
-        block_write_RTC(aPtr, 0x80, 7);
-        printf("\f");
-        positionT = 0;                     // Reset start position
-        time = 0;                         // Reset timeValues array start index
-        indexM = 0;                       // Reset index
-        indexD = 0;                       // Reset index
-        indexY = 0;                       // Reset index
-        present_state = idle;
-      } else {
-        positionT = 0;                     
-        time = 0;                         
-        indexM = 0;                       
-        indexD = 0;                    
-        indexY = 0;                       
-        printf("\f  Invalid Time\n       or\n  Invalid Date");
-        init_lcd_dog();                   // Initialize the Display
-        update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
-        __delay_cycles(32000000);
-        present_state = idle;
-      }
+      prompt_after(prompt_set_time, 0, PROMPT_MS);   // Written by set_time()
     }
   }
-  init_lcd_dog();                   // Initialize the Display
   update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
 } 
 
+/******************************************************
+ Function             : static void set_time()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Called when the time entered by changeTime_fn has 
+ been shown for PROMPT_MS. Writes the time and date to
+ the DS1306 if they are valid, or shows an error 
+ message for MESSAGE_MS. Returns to the idle state.
+******************************************************/
+static void set_time() {
+  // Setup the time and day registers in the format required for the DS1306
+  hours = (timeValues[0] << 4) | timeValues[1];
+  minutes = (timeValues[2] << 4) | timeValues[3];
+  seconds = (timeValues[4] << 4) | timeValues[5];
+  day = (dateVal[0] << 4) | dateVal[1];
+  month = (monthVal[0] << 4) | monthVal[1];
+  year = (yearVal[0] << 4) | yearVal[1];
+  RTC_write_time[0] = seconds;
+  RTC_write_time[1] = minutes;
+  RTC_write_time[2] = hours;
+  RTC_write_time[3] = dayVal;
+  RTC_write_time[4] = day;
+  RTC_write_time[5] = month;
+  RTC_write_time[6] = year;
+  
+  positionT = 0;                    // Reset start position
+  time = 0;                         // Reset timeValues array start index
+  indexM = 0;                       // Reset index
+  indexD = 0;                       // Reset index
+  indexY = 0;                       // Reset index
+  present_state = idle;
+  
+  if((hours <= 0x23) && (minutes <= 0x59) && (seconds <= 0x59) && (dayVal <= 0x07)
+     && (day <= 0x31) && (month <= 0x12) && (year <= 0x99)) {
+    aPtr = RTC_write_time;          // Pointing to start of write Array
+    block_write_RTC(aPtr, 0x80, 7);
+    clock_sync(false);              // Software clock follows the new time
+    printf("\f");
+  } else {
+    printf("\f  Invalid Time\n       or\n  Invalid Date");
+    prompt_after(prompt_message, 0, MESSAGE_MS);
+  }
+  update_lcd_dog();
+}
+
 /********************************************************
  Function             : void changeAlarm0_fn(key keyVal)
  Date                 : 04/09/2018
- Version              : 1.0
+ Version              : 2.0
  Target MCU           : ATmega128
  Author               : Wilmer Suarez
  DESCRIPTION
  Receives input form the keypad to update the value of 
  the Alarm0 registers (Hours, Minutes, Seconds, and Day) 
- of the DS1306.
+ of the DS1306. Fields are confirmed like in
+ changeTime_fn.
 ********************************************************/
 void changeAlarm0_fn(key keyVal) {
   // --- INPUT ALARM TYPE --- //
@@ -176,21 +190,15 @@ void changeAlarm0_fn(key keyVal) {
   } else if(positionA == 1) {
     alarmVal = keyVal;
     printf("%d", keyVal);
-    init_lcd_dog();                   // Initialize the Display
-    update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
     positionA++;
-    __delay_cycles(16000000);                    // Delay for 2 seconds
    // --- INPUT DAY OF THE WEEK --- //
-    printf("\f Enter Weekday:\nMon->Sun (1->7)        d\b");
+    prompt_after(prompt_text, "\f Enter Weekday:\nMon->Sun (1->7)        d\b", PROMPT_MS);
   } else if(positionA == 2){
     dayVal = keyVal;
     printf("%d", keyVal);
-    init_lcd_dog();                   // Initialize the Display
-    update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
     positionA++;
-    __delay_cycles(16000000);  
    // --- INPUT ALARM TIME --- //
-    printf("\f Change Alarm0:\n    HH:mm:ss\b\b\b\b\b\b\b\b");  
+    prompt_after(prompt_text, "\f Change Alarm0:\n    HH:mm:ss\b\b\b\b\b\b\b\b", PROMPT_MS);  
   } else {
     if(positionA <= 10) {
       if(positionA == 5 || positionA == 8) {       // Skip the colons
@@ -200,80 +208,166 @@ void changeAlarm0_fn(key keyVal) {
       timeValues[time++] = keyVal;               // Update the array holding the input key values
       printf("%d", keyVal);
       positionA++;
-      init_lcd_dog();                   // Initialize the Display
-      update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
     } 
     if(positionA == 11) {
-      __delay_cycles(16000000);                  
-      // Setup the Alarm0 values in the format required for the DS1306
-      switch(alarmVal) {
-        case 1: // Alarm every second
-          hours = ((timeValues[0] << 4) | timeValues[1]) | 0x80;    
-          minutes = ((timeValues[2] << 4) | timeValues[3]) | 0x80;
-          seconds = ((timeValues[4] << 4) | timeValues[5]) | 0x80;
-          dayVal = dayVal | 0x80;
-          RTC_write_alarm[0] = seconds;
-          RTC_write_alarm[1] = minutes;
-          RTC_write_alarm[2] = hours;
-          RTC_write_alarm[3] = dayVal;
-          break;
-        case 2: // Alarm every minute
-          hours = ((timeValues[0] << 4) | timeValues[1]) | 0x80;    
-          minutes = ((timeValues[2] << 4) | timeValues[3]) | 0x80;
-          seconds = (timeValues[4] << 4) | timeValues[5];
-          dayVal = dayVal | 0x80;
-          RTC_write_alarm[0] = seconds;
-          RTC_write_alarm[1] = minutes;
-          RTC_write_alarm[2] = hours;
-          RTC_write_alarm[3] = dayVal;
-          break;
-        case 3: // Alarm every hour
-          hours = ((timeValues[0] << 4) | timeValues[1]) | 0x80;    
-          minutes = (timeValues[2] << 4) | timeValues[3];
-          seconds = (timeValues[4] << 4) | timeValues[5];
-          dayVal = dayVal | 0x80;
-          RTC_write_alarm[0] = seconds;
-          RTC_write_alarm[1] = minutes;
-          RTC_write_alarm[2] = hours;
-          RTC_write_alarm[3] = dayVal;
-          break;
-        case 4: // Alarm every day
-          hours = (timeValues[0] << 4) | timeValues[1];    
-          minutes = (timeValues[2] << 4) | timeValues[3];
-          seconds = (timeValues[4] << 4) | timeValues[5];
-          dayVal = dayVal | 0x80;
-          RTC_write_alarm[0] = seconds;
-          RTC_write_alarm[1] = minutes;
-          RTC_write_alarm[2] = hours;
-          RTC_write_alarm[3] = dayVal;
-          break;
-        case 5: // Alarm every week
-          hours = (timeValues[0] << 4) | timeValues[1];    
-          minutes = (timeValues[2] << 4) | timeValues[3];
-          seconds = (timeValues[4] << 4) | timeValues[5];
-          dayVal = dayVal;
-          RTC_write_alarm[0] = seconds;
-          RTC_write_alarm[1] = minutes;
-          RTC_write_alarm[2] = hours;
-          RTC_write_alarm[3] = dayVal;
-          break;
-      }
-      
-      // Configure Microcontroller SPI to communicate with the DS1306 RTC
-      SPI_rtc_DS1306_config();
-      aPtr = RTC_write_alarm;                 // Pointing to start of write Array
-      block_write_RTC(aPtr, 0x87, 4);
-      printf("\f");
-      positionA = 0;                     // Reset start position
-      time = 0;                         // Reset timeValues array start index
-      present_state = idle;
-
+      prompt_after(prompt_set_alarm0, 0, PROMPT_MS);   // Written by set_alarm0()
     }
   }
-  init_lcd_dog();                   // Initialize the Display
   update_lcd_dog();                 // Updates the LCD to display the key value entered by the user
 }
 
+/********************************************************
+ Function             : static void set_alarm0()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Called when the alarm entered by changeAlarm0_fn has 
+ been shown for PROMPT_MS. Writes Alarm 0 to the DS1306,
+ enables its interrupt, and returns to the idle state.
+ The system tick comes from the 1Hz output, so any alarm
+ type leaves the refresh rate unchanged.
+********************************************************/
+static void set_alarm0() {
+  // Setup the Alarm0 values in the format required for the DS1306
+  switch(alarmVal) {
+    case 1: // Alarm every second
+      hours = ((timeValues[0] << 4) | timeValues[1]) | 0x80;    
+      minutes = ((timeValues[2] << 4) | timeValues[3]) | 0x80;
+      seconds = ((timeValues[4] << 4) | timeValues[5]) | 0x80;
+      dayVal = dayVal | 0x80;
+      RTC_write_alarm[0] = seconds;
+      RTC_write_alarm[1] = minutes;
+      RTC_write_alarm[2] = hours;
+      RTC_write_alarm[3] = dayVal;
+      break;
+    case 2: // Alarm every minute
+      hours = ((timeValues[0] << 4) | timeValues[1]) | 0x80;    
+      minutes = ((timeValues[2] << 4) | timeValues[3]) | 0x80;
+      seconds = (timeValues[4] << 4) | timeValues[5];
+      dayVal = dayVal | 0x80;
+      RTC_write_alarm[0] = seconds;
+      RTC_write_alarm[1] = minutes;
+      RTC_write_alarm[2] = hours;
+      RTC_write_alarm[3] = dayVal;
+      break;
+    case 3: // Alarm every hour
+      hours = ((timeValues[0] << 4) | timeValues[1]) | 0x80;    
+      minutes = (timeValues[2] << 4) | timeValues[3];
+      seconds = (timeValues[4] << 4) | timeValues[5];
+      dayVal = dayVal | 0x80;
+      RTC_write_alarm[0] = seconds;
+      RTC_write_alarm[1] = minutes;
+      RTC_write_alarm[2] = hours;
+      RTC_write_alarm[3] = dayVal;
+      break;
+    case 4: // Alarm every day
+      hours = (timeValues[0] << 4) | timeValues[1];    
+      minutes = (timeValues[2] << 4) | timeValues[3];
+      seconds = (timeValues[4] << 4) | timeValues[5];
+      dayVal = dayVal | 0x80;
+      RTC_write_alarm[0] = seconds;
+      RTC_write_alarm[1] = minutes;
+      RTC_write_alarm[2] = hours;
+      RTC_write_alarm[3] = dayVal;
+      break;
+    case 5: // Alarm every week
+      hours = (timeValues[0] << 4) | timeValues[1];    
+      minutes = (timeValues[2] << 4) | timeValues[3];
+      seconds = (timeValues[4] << 4) | timeValues[5];
+      dayVal = dayVal;
+      RTC_write_alarm[0] = seconds;
+      RTC_write_alarm[1] = minutes;
+      RTC_write_alarm[2] = hours;
+      RTC_write_alarm[3] = dayVal;
+      break;
+  }
+  
+  aPtr = RTC_write_alarm;           // Pointing to start of write Array
+  block_write_RTC(aPtr, 0x87, 4);
+  DS1306_alarm_enable(0, true);     // /INT0 asserted on a match
+  printf("\f");
+  positionA = 0;                    // Reset start position
+  time = 0;                         // Reset timeValues array start index
+  present_state = idle;
+  update_lcd_dog();
+}
+
+/****************************************************
+ Function             : static void prompt_after(
+                        prompt_action action,
+                        const char *text, 
+                        unsigned int ms)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Schedules the next step of a prompt. It runs when
+ the to_prompt timeout expires or when the next key
+ is pressed, whichever comes first.
+****************************************************/
+static void prompt_after(prompt_action action, const char *text, unsigned int ms) {
+  promptPending = action;
+  promptText = text;
+  timeout_start(to_prompt, ms);
+}
+
+/****************************************************
+ Function             : bool prompt_finish()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Runs the scheduled prompt step now. Called by the 
+ main loop on the to_prompt timeout and before each
+ key is given to the FSM. Returns true if the step 
+ changed the present state; the key that finished it
+ is then not passed on.
+****************************************************/
+bool prompt_finish() {
+  prompt_action action = promptPending;
+  state ps = present_state;
+  
+  if(action == prompt_none) {
+    return false;
+  }
+  promptPending = prompt_none;
+  timeout_cancel(to_prompt);
+  
+  switch(action) {
+    case prompt_text:               // Show the next prompt
+      lcd_puts(promptText);
+      update_lcd_dog();
+      break;
+    case prompt_set_time:
+      set_time();
+      break;
+    case prompt_set_alarm0:
+      set_alarm0();
+      break;
+    default:                        // Message shown long enough, the view redraws
+      break;
+  }
+  return present_state != ps;
+}
+
+/****************************************************
+ Function             : bool prompt_active()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ True while a confirmation or a message is shown. 
+ The view does not draw its pages meanwhile.
+****************************************************/
+bool prompt_active() {
+  return promptPending != prompt_none;
+}
+
 /****************************************************
  Function             : void idle_fn(key keyVal)
  Date                 : 04/11/2018
@@ -341,76 +435,104 @@ extern void back_fn(key keyVal) {
 }
 
 /****************************************************
- Function             : void dispCO2_fn(key keyVal)
- Date                 : 04/22/2018
+ Function             : void sensor_fn(key keyVal)
+ Date                 : 10/16/2026
  Version              : 1.0
- Target MCU           : ATmega128 @ 16MHz
+ Target MCU           : ATmega128
  Author               : Wilmer Suarez
  DESCRIPTION
- Displays the CO2 measurement.
+ Number keys 0-7 on the idle screen select the 
+ Humidicon shown. A sensor that is not fitted
+ is an invalid input.
 ****************************************************/
-void dispCO2_fn(key keyVal) {
-  // Start ADC Conversion
-  SETBIT(ADCSRA, ADSC);
-
-  // Wait for ADC converion is complete
-  while(!(ADCSRA & (1 << ADIF)));
-
-  // Clearn  ADC Interrupt Flag
-  SETBIT(ADCSRA, ADIF);
-
-  // Display the Conversion
-  display();
+void sensor_fn(key keyVal) {
+  if(!view_select_sensor((unsigned char)keyVal)) {
+    error_fn(keyVal);
+  }
 }
 
 /****************************************************
- Function             : void display()
+ Function             : void dispCO2_fn(key keyVal)
  Date                 : 04/22/2018
- Version              : 1.0
+ Version              : 2.0
  Target MCU           : ATmega128 @ 16MHz
  Author               : Wilmer Suarez
  DESCRIPTION
- Reads and converts the ADC result to Hex.
- The result is printed to the LCD.
+ Entered to display the CO2 measurement. The CO2 
+ page is drawn by view.c from the latest filtered
+ sample (the ADC is sampled in the background by
+ co2.c) and redrawn whenever the sample changes.
 ****************************************************/
-void display() {
-  result = ADCL;                // Get Low 8-bits of ADC Result
-  result |= (ADCH << 8);        // Get High 2-bits of ADC Result 
-  float voltage = result * (2560/1024.0);
-  if(voltage == 0) {
-    printf("\f      CO2:\n");    
-    printf("      Fault");
-  } else if(voltage < 400) {
-    printf("\f      CO2:\n");    
-    printf("   Preheating");
-  } else {
-    int voltage_difference = (int) voltage - 400;
-    float concentration = voltage_difference * (50.0/16.0);
-    printf("\fV: %.2fmv\n", voltage);   
-    printf("CO2: %.2fppm\n", concentration);    
-  }
-  init_lcd_dog();               // Initialize the LCD
-  update_lcd_dog();             // Update the LCD with the contents of the display buffers
+void dispCO2_fn(key keyVal) {
+  // The main loop shows page_co2 in the dispCO2 state
 }
 
 /****************************************************
  Function             : void error_fn(key keyVal)
  Date                 : 04/09/2018
- Version              : 1.0
+ Version              : 2.0
  Target MCU           : ATmega128 @ 16MHz
  Author               : Wilmer Suarez
  DESCRIPTION
  Temporarily Displays an error message on the third 
  line of the LCD screen when an incorrect key is 
- pressed.
+ pressed. The message stays until MESSAGE_MS has
+ passed or the next key is pressed.
 ****************************************************/
 void error_fn(key keyVal) {
   if(present_state == idle) {
     printf("\f Invalid Input!");
-    init_lcd_dog();                     // Initialize the Display
     update_lcd_dog();                   // Updates the LCD to display the error message
-    __delay_cycles(32000000);           // Delay for 2 seconds
+    prompt_after(prompt_message, 0, MESSAGE_MS);   // Kept on the LCD for 2 seconds
   } else {
     
   }
 }
+
+
+/****************************************************
+ Function             : void diag_fn(key keyVal)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128 @ 16MHz
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Hidden diagnostics screen, entered with DEL from
+ the idle state. Shows the profiler results of one
+ probe in microseconds:
+ line 1: probe name
+ line 2: minimum-maximum
+ line 3: average and sample count
+ DEL shows the next probe, 1->7 selects a probe,
+ and 0 clears the results.
+****************************************************/
+void diag_fn(key keyVal) {
+#if PROFILE_ENABLE
+  prof_stats stats;
+#endif
+  
+  if(keyVal == del) {
+    diagPage = (diagPage + 1) % prof_count;
+  } else if((keyVal >= one) && ((int)keyVal <= (int)prof_count)) {
+    diagPage = keyVal - one;
+  } else if(keyVal == zero) {
+    prof_clear();
+  }
+  
+#if PROFILE_ENABLE
+  prof_read((prof_probe)diagPage, &stats);
+  lcd_puts("\f");
+  lcd_puts(prof_name((prof_probe)diagPage));
+  lcd_puts("\n");
+  lcd_put_uint(stats.min >> 1, 1);            // Timer3 counts are 0.5us
+  putchar('-');
+  lcd_put_uint(stats.max >> 1, 1);
+  lcd_puts("us\navg ");
+  lcd_put_uint(stats.count ? (unsigned int)((stats.total / stats.count) >> 1) : 0, 1);
+  lcd_puts("us n");
+  lcd_put_uint(stats.count, 1);
+#else
+  lcd_puts("\fProfiling off");
+#endif
+  update_lcd_dog();
+}
\ No newline at end of file
@@ -7,7 +7,7 @@
  Author               : Wilmer Suarez 
  DESCRIPTION 
  This file contains the definition of the fsm function and the 
- transistion arrays that are traversed whenever their is a 
+ transistion table that is indexed whenever their is a 
  keypad press.
 ****************************************************************/    
 
@@ -19,114 +19,165 @@
 // Declare type task_fn_ptr as a pointer to a task function
 typedef void (* task_fn_ptr) (key keyVal);
 
-// A structure transition represents one row of a state transition table
-// it has a field for the input key value, the next state, and a pointer
-// to the task function.
+// A structure transition represents one cell of the state transition table:
+// the next state and a pointer to the task function for one present state
+// and one input key value.
 typedef struct {
-  key keyval;
   state next_state;
   task_fn_ptr tf_ptr;
 } transition;
 
-// The state transition table consists of an array of arrays of structures.
-// Each array of structures corresponds to a particular present state value.
-// Each structure in such an array corresponds to a transition from the
-// state for a given input value and the task function associated with the
-// transition. Accordingly, each structure in an array has fields
-// corresponding to an input value, the next state for this input value,
-// and a pointer to the function task for this input value.
-// The last transition structure in each array has a keyval field value
-// of eol. This is a default value meaning any key value that has not
-// been explcitly listed in a previous transition structure in the array.
-
-const transition idle_transitions [] = {           // subtable for idle state
-//  KEY INPUT   NEXT_STATE    FUNCTION
-    {setTime,   changeTime,   changeTime_fn},
-    {setAlarm0, changeAlarm0, changeAlarm0_fn},
-    {co2,       dispCO2,      dispCO2_fn},
-    {eol,       idle,         error_fn}
-};
-    
-const transition changeTime_transitions [] = {     // subtable for setTime state
-//  KEY INPUT   NEXT_STATE    FUNCTION
-    {zero,      changeTime,  changeTime_fn},
-    {one,       changeTime,  changeTime_fn},
-    {two,       changeTime,  changeTime_fn},
-    {three,     changeTime,  changeTime_fn},
-    {four,      changeTime,  changeTime_fn},
-    {five,      changeTime,  changeTime_fn},
-    {six,       changeTime,  changeTime_fn},
-    {seven,     changeTime,  changeTime_fn},
-    {eight,     changeTime,  changeTime_fn},
-    {nine,      changeTime,  changeTime_fn},
-    {back,      idle,        idle_fn},
-    {del,       changeTime,  back_fn},
-    {eol,       changeTime,  error_fn}
-};
-    
-const transition changeAlarm0_transitions [] = {   // subtable for set_temp state
-//  KEY INPUT   NEXT_STATE     FUNCTION
-    {zero,      changeAlarm0,  changeAlarm0_fn},
-    {one,       changeAlarm0,  changeAlarm0_fn},
-    {two,       changeAlarm0,  changeAlarm0_fn},
-    {three,     changeAlarm0,  changeAlarm0_fn},
-    {four,      changeAlarm0,  changeAlarm0_fn},
-    {five,      changeAlarm0,  changeAlarm0_fn},
-    {six,       changeAlarm0,  changeAlarm0_fn},
-    {seven,     changeAlarm0,  changeAlarm0_fn},
-    {eight,     changeAlarm0,  changeAlarm0_fn},
-    {nine,      changeAlarm0,  changeAlarm0_fn}, 
-    {back,      idle,          idle_fn},
-    {del,       changeAlarm0,  back_fn},
-    {eol,       changeAlarm0,  error_fn}
-};   
-
-const transition dispCO2_transitions [] = {        // subtable for dispCO2 state
-//  KEY INPUT   NEXT_STATE     FUNCTION
-    {back,      idle,          idle_fn},
-    {eol,       dispCO2,       error_fn}
-}; 
-    
-// The outer array is an array of pointers to an array of transition
-// structures for each present state.
-const transition * ps_transitions_ptr[4] = {
-  idle_transitions,    
-  changeTime_transitions,
-  changeAlarm0_transitions, 
-  dispCO2_transitions
+// The transitions are written below as readable rows, one list per state.
+// Each state has a default transition, used for any key value that has
+// not been listed explicitly in its rows (the eol entry of the old 
+// per-state arrays).
+//
+// The rows are expanded at compile time into a dense table indexed by
+// [present state][key], kept in flash, so fsm() finds a transition with
+// one index instead of a search. Each cell is written once: for every
+// key, the selection macros run through the rows of the state and give
+// the listed transition, or the default if the key has no row (a chain
+// of constant conditional expressions). A key listed twice in the rows
+// of a state, or a row for eol, does not compile (see the checks below
+// the table).
+
+//                ROW(k, KEY INPUT, NEXT_STATE,   FUNCTION)
+// Idle: DEL opens the hidden diagnostics screen, 0-7 select the Humidicon page
+#define IDLE_ROWS(ROW, k)                                           \
+                  ROW(k, setTime,   changeTime,   changeTime_fn)    \
+                  ROW(k, setAlarm0, changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, co2,       dispCO2,      dispCO2_fn)       \
+                  ROW(k, del,       diag,         diag_fn)          \
+                  ROW(k, zero,      idle,         sensor_fn)        \
+                  ROW(k, one,       idle,         sensor_fn)        \
+                  ROW(k, two,       idle,         sensor_fn)        \
+                  ROW(k, three,     idle,         sensor_fn)        \
+                  ROW(k, four,      idle,         sensor_fn)        \
+                  ROW(k, five,      idle,         sensor_fn)        \
+                  ROW(k, six,       idle,         sensor_fn)        \
+                  ROW(k, seven,     idle,         sensor_fn)
+
+#define CHANGE_TIME_ROWS(ROW, k)                                    \
+                  ROW(k, zero,      changeTime,   changeTime_fn)    \
+                  ROW(k, one,       changeTime,   changeTime_fn)    \
+                  ROW(k, two,       changeTime,   changeTime_fn)    \
+                  ROW(k, three,     changeTime,   changeTime_fn)    \
+                  ROW(k, four,      changeTime,   changeTime_fn)    \
+                  ROW(k, five,      changeTime,   changeTime_fn)    \
+                  ROW(k, six,       changeTime,   changeTime_fn)    \
+                  ROW(k, seven,     changeTime,   changeTime_fn)    \
+                  ROW(k, eight,     changeTime,   changeTime_fn)    \
+                  ROW(k, nine,      changeTime,   changeTime_fn)    \
+                  ROW(k, back,      idle,         idle_fn)          \
+                  ROW(k, del,       changeTime,   back_fn)
+
+#define CHANGE_ALARM0_ROWS(ROW, k)                                  \
+                  ROW(k, zero,      changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, one,       changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, two,       changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, three,     changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, four,      changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, five,      changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, six,       changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, seven,     changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, eight,     changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, nine,      changeAlarm0, changeAlarm0_fn)  \
+                  ROW(k, back,      idle,         idle_fn)          \
+                  ROW(k, del,       changeAlarm0, back_fn)
+
+#define DISP_CO2_ROWS(ROW, k)                                       \
+                  ROW(k, back,      idle,         idle_fn)
+
+#define DIAG_ROWS(ROW, k)                                           \
+                  ROW(k, back,      idle,         idle_fn)
+
+// Every state: STATE(PRESENT_STATE, DEFAULT NEXT_STATE, DEFAULT FUNCTION, ROWS)
+// A state without a default transition does not compile.
+#define FSM_STATES(STATE)                                                 \
+  STATE(idle,         idle,         error_fn, IDLE_ROWS)                  \
+  STATE(changeTime,   changeTime,   error_fn, CHANGE_TIME_ROWS)           \
+  STATE(changeAlarm0, changeAlarm0, error_fn, CHANGE_ALARM0_ROWS)         \
+  STATE(dispCO2,      dispCO2,      error_fn, DISP_CO2_ROWS)              \
+  STATE(diag,         diag,         diag_fn,  DIAG_ROWS)
+
+// Every key value, eol included, in the order of the key enum
+#define FSM_KEYS(CELL, next, fn, rows)                                    \
+  CELL(zero, next, fn, rows) CELL(one, next, fn, rows)                    \
+  CELL(two, next, fn, rows) CELL(three, next, fn, rows)                   \
+  CELL(four, next, fn, rows) CELL(five, next, fn, rows)                   \
+  CELL(six, next, fn, rows) CELL(seven, next, fn, rows)                   \
+  CELL(eight, next, fn, rows) CELL(nine, next, fn, rows)                  \
+  CELL(setTime, next, fn, rows) CELL(setAlarm0, next, fn, rows)           \
+  CELL(back, next, fn, rows) CELL(tempChange, next, fn, rows)             \
+  CELL(del, next, fn, rows) CELL(co2, next, fn, rows)                     \
+  CELL(eol, next, fn, rows)
+
+// ----- Table generation ----- //
+// The cell of key k: the row listing k, else the default of the state
+#define FSM_SELECT_NEXT(k, rk, next, fn)    ((k) == (rk)) ? (next) :
+#define FSM_SELECT_FN(k, rk, next, fn)      ((k) == (rk)) ? (fn) :
+#define FSM_CELL(k, next, fn, rows)         [k] = {rows(FSM_SELECT_NEXT, k) (next), rows(FSM_SELECT_FN, k) (fn)},
+#define FSM_STATE_ROW(ps, next, fn, rows)   [ps] = { FSM_KEYS(FSM_CELL, next, fn, rows) },
+
+const __flash transition fsm_table[state_count][eol + 1] = {
+  FSM_STATES(FSM_STATE_ROW)
 };
 
+// ----- Compile time checks ----- //
+// A set of states or keys is summed and or-ed as bits: the two only match
+// if no value is listed twice.
+#define FSM_BIT_SUM(v)                  + (1UL << (v))
+#define FSM_BIT_OR(v)                   | (1UL << (v))
+#define FSM_STATE_SUM(ps, next, fn, rows)   FSM_BIT_SUM(ps)
+#define FSM_STATE_OR(ps, next, fn, rows)    FSM_BIT_OR(ps)
+#define FSM_KEY_SUM(k, next, fn, rows)  FSM_BIT_SUM(k)
+#define FSM_KEY_OR(k, next, fn, rows)   FSM_BIT_OR(k)
+#define FSM_ROW_SUM(k, rk, next, fn)    FSM_BIT_SUM(rk)
+#define FSM_ROW_OR(k, rk, next, fn)     FSM_BIT_OR(rk)
+
+// Every state is listed once in FSM_STATES and every key once in FSM_KEYS
+typedef char fsm_all_states_listed[(((0UL FSM_STATES(FSM_STATE_SUM)) == (1UL << state_count) - 1) &&
+                                    ((0UL FSM_STATES(FSM_STATE_OR)) == (1UL << state_count) - 1)) ? 1 : -1];
+typedef char fsm_all_keys_listed[(((0UL FSM_KEYS(FSM_KEY_SUM, 0, 0, 0)) == (1UL << (eol + 1)) - 1) &&
+                                  ((0UL FSM_KEYS(FSM_KEY_OR, 0, 0, 0)) == (1UL << (eol + 1)) - 1)) ? 1 : -1];
+
+// The rows of each state list a key at most once, and never eol (the default)
+#define FSM_ROW_VALID(k, rk, next, fn)  && ((rk) < eol)
+#define FSM_STATE_CHECK(ps, next, fn, rows)                                                 \
+  typedef char fsm_rows_of_##ps[(((0UL rows(FSM_ROW_SUM, 0)) == (0UL rows(FSM_ROW_OR, 0))) && \
+                                 (1 rows(FSM_ROW_VALID, 0))) ? 1 : -1];
+FSM_STATES(FSM_STATE_CHECK)
+
 
 /***********************************************************
  Function             : void fsm (state ps, key keyval)
  Date                 : 04/09/2018
- Version              : 1.0
+ Version              : 2.0
  Target MCU           : ATmega128
  Author               : Wilmer Suarez
  DESCRIPTION
- This function searches an array of 'transistion' structures
- of the present state passed in for the keyvalue the user
- entered. 
- If the keyvalue is found, the associated function is 
- called. If it is not found or if an invalid key (eol) was
- pressed (respective of the present state) the assocaited
- error function is called. In both cases the present state
- is updated with the next state in the 'transition' struct.
+ This function looks up the transition of the present 
+ state passed in and the keyvalue the user entered in the
+ dense transition table. Key values that are not listed 
+ for the present state hold the state's default 
+ transition (the error function in most states).
+ The present state is updated with the next state of 
+ the transition and the associated function is called.
 ***********************************************************/
 void fsm (state ps, key keyval) {
-  // Search for the transition struct array for the key value.
-  int i = 0;
-  for (i = 0; (ps_transitions_ptr[ps][i].keyval != keyval)
-       && (ps_transitions_ptr[ps][i].keyval != eol); i++);
-
-  // i now has the value of the index of the transition structure
-  // corresponding to the current intput key value.
+  const __flash transition *t;
+  
+  // Out of range key values use the default transition
+  if(keyval > eol) {
+    keyval = eol;
+  }
+  t = &fsm_table[ps][keyval];
   
   // Make the present state equal to the next state value of the current
   // transition structure.
-  present_state = ps_transitions_ptr[ps][i].next_state;
+  present_state = t->next_state;
   
   // Call the task function pointed to by the task function pointer
   // of the current transition structure.
-  ps_transitions_ptr[ps][i].tf_ptr(keyval);
-}
+  t->tf_ptr(keyval);
+}
\ No newline at end of file
@@ -0,0 +1,248 @@
+/******************************************************************
+ File Name            : "history.c"
+ Title                : Sensor History
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Fixed capacity ring buffer of the last HISTORY_SIZE time stamped
+ samples: the raw 14-bit humidity and temperature codes of the 
+ Humidicon and the 12-bit CO2 ADC counts. The 40 bits of sensor 
+ data are packed in 5 bytes, so a sample takes 7 bytes.
+ 
+ The sum, minimum, and maximum of each channel are kept up to date
+ as samples are added and evicted, so the window average and 
+ extremes are read in constant time:
+ - The sum adds the new value and subtracts the evicted one.
+ - The minimum and maximum use a monotonic queue of sample numbers
+   per channel. A new value removes the queued samples it beats 
+   (they can never be an extreme again), and the front is removed
+   when its sample leaves the window. The front is always the 
+   extreme, and each sample is queued and removed once.
+ 
+ SRAM: 7 * HISTORY_SIZE for the samples, 6 * (HISTORY_SIZE + 2) for
+ the queues, 27 bytes of running statistics, and 2 bytes of sample
+ number and count (873 bytes for 64 samples).
+ 
+ The count and the queue counts are unsigned chars, so the window
+ holds at most 128 samples.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "history.h"
+
+#define HISTORY_MASK    (HISTORY_SIZE - 1)
+
+// The counts are unsigned chars and the sample numbers wrap at 256
+typedef char history_size_check[((HISTORY_SIZE <= 128) && !(HISTORY_SIZE & HISTORY_MASK)) ? 1 : -1];
+
+// A packed sample
+typedef struct {
+  unsigned int stamp;
+  unsigned char data[5];            // RH[13:0], Temperature[13:0], CO2[11:0]
+} hist_sample;
+
+// Monotonic queue of sample numbers (mod 256) for the minimum or maximum of a channel
+typedef struct {
+  unsigned char seq[HISTORY_SIZE];
+  unsigned char head;               // Position of the front
+  unsigned char count;
+} hist_queue;
+
+// ----- History state ----- //
+static hist_sample history[HISTORY_SIZE];
+static unsigned char history_next;  // Sample number of the next sample (mod 256)
+static unsigned char history_count; // Samples in the window
+static hist_queue min_queue[hist_channels];
+static hist_queue max_queue[hist_channels];
+static hist_snapshot history_stats; // Running statistics
+
+// ----- Local Function Prototypes ----- //
+static unsigned int unpack(unsigned char seq, hist_channel ch);
+static void queue_push(hist_queue *q, unsigned char seq, hist_channel ch, bool is_max);
+static void queue_evict(hist_queue *q, unsigned char seq);
+
+/*************************************************************
+ Function             : void history_add(unsigned int stamp,
+                        unsigned int rh_raw, unsigned int temp_raw,
+                        unsigned int co2_counts)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Adds a sample, evicting the oldest one if the window is
+ full, and updates the running statistics. Interrupts are
+ disabled while the statistics change so a snapshot taken
+ from an interrupt is always consistent.
+*************************************************************/
+void history_add(unsigned int stamp, unsigned int rh_raw, unsigned int temp_raw, unsigned int co2_counts) {
+  unsigned char sreg = __save_interrupt();
+  unsigned char seq = history_next;
+  unsigned char oldest = seq - HISTORY_SIZE;
+  hist_sample *s = &history[seq & HISTORY_MASK];
+  unsigned int values[hist_channels];
+  hist_channel ch;
+  
+  values[hist_rh] = rh_raw & 0x3FFF;
+  values[hist_temp] = temp_raw & 0x3FFF;
+  values[hist_co2] = co2_counts & 0x0FFF;
+  
+  __disable_interrupt();
+  
+  // ----- Evict the oldest sample (it shares the slot of the new one) ----- //
+  if(history_count == HISTORY_SIZE) {
+    for(ch = hist_rh; ch < hist_channels; ch++) {
+      history_stats.channel[ch].sum -= unpack(oldest, ch);
+      queue_evict(&min_queue[ch], oldest);
+      queue_evict(&max_queue[ch], oldest);
+    }
+  } else {
+    history_count++;
+  }
+  
+  // ----- Pack the new sample ----- //
+  s->stamp = stamp;
+  s->data[0] = values[hist_rh];
+  s->data[1] = (values[hist_rh] >> 8) | (values[hist_temp] << 6);
+  s->data[2] = values[hist_temp] >> 2;
+  s->data[3] = (values[hist_temp] >> 10) | (values[hist_co2] << 4);
+  s->data[4] = values[hist_co2] >> 4;
+  history_next = seq + 1;
+  
+  // ----- Update the statistics ----- //
+  for(ch = hist_rh; ch < hist_channels; ch++) {
+    history_stats.channel[ch].sum += values[ch];
+    queue_push(&min_queue[ch], seq, ch, false);
+    queue_push(&max_queue[ch], seq, ch, true);
+    history_stats.channel[ch].min = unpack(min_queue[ch].seq[min_queue[ch].head], ch);
+    history_stats.channel[ch].max = unpack(max_queue[ch].seq[max_queue[ch].head], ch);
+  }
+  history_stats.count = history_count;
+  history_stats.newest_stamp = stamp;
+  
+  __restore_interrupt(sreg);
+}
+
+/*************************************************************
+ Function             : void history_snapshot(hist_snapshot *snap)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Copies the window statistics to snap. Interrupts are 
+ disabled during the copy (about 30 bytes), so it is safe 
+ to call from the main loop while an interrupt adds 
+ samples. The average of a channel is sum / count.
+*************************************************************/
+void history_snapshot(hist_snapshot *snap) {
+  unsigned char sreg = __save_interrupt();
+  
+  __disable_interrupt();
+  *snap = history_stats;
+  __restore_interrupt(sreg);
+}
+
+/*************************************************************
+ Function             : bool history_sample(unsigned char age,
+                        unsigned int *stamp, unsigned int values[])
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Unpacks the sample added age samples ago (0 = newest).
+ Returns false if the window holds fewer samples.
+*************************************************************/
+bool history_sample(unsigned char age, unsigned int *stamp, unsigned int values[hist_channels]) {
+  unsigned char sreg = __save_interrupt();
+  unsigned char seq;
+  
+  __disable_interrupt();
+  if(age >= history_count) {
+    __restore_interrupt(sreg);
+    return false;
+  }
+  
+  seq = history_next - 1 - age;
+  *stamp = history[seq & HISTORY_MASK].stamp;
+  values[hist_rh] = unpack(seq, hist_rh);
+  values[hist_temp] = unpack(seq, hist_temp);
+  values[hist_co2] = unpack(seq, hist_co2);
+  __restore_interrupt(sreg);
+  
+  return true;
+}
+
+/*************************************************************
+ Function             : static unsigned int unpack(
+                        unsigned char seq, hist_channel ch)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns one channel of a packed sample.
+*************************************************************/
+static unsigned int unpack(unsigned char seq, hist_channel ch) {
+  const unsigned char *d = history[seq & HISTORY_MASK].data;
+  
+  switch(ch) {
+    case hist_rh:
+      return d[0] | ((unsigned int)(d[1] & 0x3F) << 8);
+    case hist_temp:
+      return (d[1] >> 6) | ((unsigned int)d[2] << 2) | ((unsigned int)(d[3] & 0x0F) << 10);
+    default:
+      return (d[3] >> 4) | ((unsigned int)d[4] << 4);
+  }
+}
+
+/*************************************************************
+ Function             : static void queue_push(hist_queue *q,
+                        unsigned char seq, hist_channel ch, 
+                        bool is_max)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Removes the queued samples that the new sample beats (not
+ larger for a maximum queue, not smaller for a minimum 
+ queue) from the back, then queues the new sample.
+*************************************************************/
+static void queue_push(hist_queue *q, unsigned char seq, hist_channel ch, bool is_max) {
+  unsigned int value = unpack(seq, ch);
+  unsigned int back;
+  
+  while(q->count != 0) {
+    back = unpack(q->seq[(q->head + q->count - 1) & HISTORY_MASK], ch);
+    if(is_max ? (back > value) : (back < value)) {
+      break;
+    }
+    q->count--;
+  }
+  
+  q->seq[(q->head + q->count) & HISTORY_MASK] = seq;
+  q->count++;
+}
+
+/*************************************************************
+ Function             : static void queue_evict(hist_queue *q,
+                        unsigned char seq)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Removes the front of the queue if it is the sample 
+ leaving the window.
+*************************************************************/
+static void queue_evict(hist_queue *q, unsigned char seq) {
+  if((q->count != 0) && (q->seq[q->head] == seq)) {
+    q->head = (q->head + 1) & HISTORY_MASK;
+    q->count--;
+  }
+}
@@ -0,0 +1,36 @@
+/****************************************************************
+  File Name            : "history.h" 
+  Title                : Sensor History Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the channels and statistics of the
+  sensor history and the external functions used to add 
+  samples and take a snapshot of the window statistics.
+****************************************************************/ 
+
+#define HISTORY_SIZE    64          // Samples in the window. Must be a power of 2, 128 or less
+
+// ---------- History channels ---------- //
+typedef enum {hist_rh, hist_temp, hist_co2, hist_channels} hist_channel;
+
+// Statistics of one channel over the samples in the window (raw sensor codes)
+typedef struct {
+  unsigned long sum;
+  unsigned int min;
+  unsigned int max;
+} hist_stats;
+
+// A consistent copy of the window statistics
+typedef struct {
+  unsigned char count;              // Samples in the window
+  unsigned int newest_stamp;        // Time stamp of the last sample
+  hist_stats channel[hist_channels];
+} hist_snapshot;
+
+// ------- External Functions for the Sensor History ------- //
+extern void history_add(unsigned int stamp, unsigned int rh_raw, unsigned int temp_raw, unsigned int co2_counts);
+extern void history_snapshot(hist_snapshot *snap);
+extern bool history_sample(unsigned char age, unsigned int *stamp, unsigned int values[hist_channels]);   // age 0 = newest
@@ -8,129 +8,305 @@
  DESCRIPTION
  This file contains the functions needed to get 
  the temperature and humidity from the humidicon.
- The values are then printed on the LCD. 
+ The values are shown on the LCD by view.c. 
+ 
+ A measurement is split in two phases so the CPU 
+ never waits for the 36.65ms conversion: 
+ start_humidicon() sends the measurement request 
+ and arms Timer1, whose compare interrupt marks 
+ the conversion as done. fetch_humidicon() then 
+ reads the 4 bytes. measure_rh_temp() is 
+ pipelined: each tick fetches the conversion 
+ started by the previous tick and starts the next.
+ 
+ Up to 8 Humidicons share the SPI bus, each with its
+ own chip select. The measurement request is sent to
+ every sensor back to back and a single Timer1 
+ conversion time covers all of them, then the sensors
+ are read in order. N sensors cost one conversion
+ time plus N 4-byte reads (about 70us each at 500kHz)
+ instead of N conversions.
+ 
+ The sampling interval adapts to the signal. After 
+ HUMIDICON_WINDOW samples in a row that stay within the
+ band of the reference sample (on every sensor), the 
+ interval doubles, up to HUMIDICON_MAX_INTERVAL ticks. 
+ A sample outside the band, a stale fetch, or a key 
+ press brings it back to every tick. Between samples 
+ the cached values are used.
 *************************************************/
 
 // ----- Include Files ----- //
 #include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
-#include "lcd.h"
-#include <stdio.h>
-
-// ---------- Global static Variables ---------- //
-static unsigned int humidicon_byte1;        // First byte of Humidicon data
-static unsigned int humidicon_byte2;        // Second byte of Humidicon data
-static unsigned int humidicon_byte3;        // Third byte of Humidicon data
-static unsigned int humidicon_byte4;        // Fourth byte of Humidicon data
-static unsigned int humidity_raw;           // Raw data for humidity 
-static unsigned int temperature_raw;        // Raw data for temperature
-static unsigned int humidity;               // Computed scaled Humidity
-static unsigned int temperatureC;           // Computed scaled Temperature in Celcius
-static unsigned int temperatureF;           // Temperature in Fahrenheit
+#include "humidicon.h"
+#include "spi_bus.h"
+#include "events.h"
+#include "profile.h"
+
+// ---------- Sensor instances ---------- //
+// A structure humidicon_cs holds the chip select (active low) of one sensor.
+typedef struct {
+  volatile unsigned char *port;
+  volatile unsigned char *ddr;
+  unsigned char pin;
+} humidicon_cs;
+
+// Chip select of each sensor, the first HUMIDICON_COUNT are used
+static const humidicon_cs humidicon_cs_pins[] = {
+//   PORT    DDR    PIN
+    {&PORTA, &DDRA, 0},     // Sensor 0
+    {&PORTA, &DDRA, 3},     // Sensor 1
+    {&PORTA, &DDRA, 4},     // Sensor 2
+    {&PORTA, &DDRA, 5},     // Sensor 3
+    {&PORTA, &DDRA, 6},     // Sensor 4
+    {&PORTA, &DDRA, 7},     // Sensor 5
+    {&PORTG, &DDRG, 0},     // Sensor 6
+    {&PORTG, &DDRG, 1}      // Sensor 7
+};
+
+// Compile time check: every sensor has a chip select
+typedef char humidicon_cs_check[((HUMIDICON_COUNT >= 1) && 
+  (HUMIDICON_COUNT <= sizeof(humidicon_cs_pins) / sizeof(humidicon_cs_pins[0]))) ? 1 : -1];
+
+// A structure humidicon_sensor holds the last valid reading of one sensor.
+typedef struct {
+  unsigned int humidity_raw;                // Raw data for humidity 
+  unsigned int temperature_raw;             // Raw data for temperature
+  unsigned int humidity;                    // Computed scaled Humidity
+  unsigned int temperatureC;                // Computed scaled Temperature in Celcius
+  unsigned char status;                     // Status bits of the last fetch
+  unsigned int ref_rh;                      // Raw humidity the band is centered on
+  unsigned int ref_temp;                    // Raw temperature the band is centered on
+} humidicon_sensor;
+
+static humidicon_sensor humidicons[HUMIDICON_COUNT];
+
+// ---------- Measurement cycle ---------- //
+// Timer1 runs in CTC mode at fosc/1024 (15.625kHz) while a conversion is in progress
+#define HUMIDICON_CONV_TICKS    578         // 37ms, measurement cycle is 36.65ms
+
+// Status bits (2 MSBs of the first byte)
+#define HUMIDICON_STATUS_OK     0x00        // Normal operation, new data
+#define HUMIDICON_STATUS_STALE  0x01        // Data already fetched since the last measurement
+
+typedef enum {hum_idle, hum_converting, hum_done} hum_state;
+static volatile hum_state humidicon_state = hum_idle;
+unsigned char humidicon_status;             // Status bits of the last fetch of sensor 0
+unsigned int humidicon_stale_count;         // Fetches rejected because of the status bits
+unsigned char humidicon_sequence;           // Fresh samples of sensor 0 (mod 256)
+
+// ---------- Adaptive sampling ---------- //
+static unsigned char sample_interval = 1;   // Ticks between measurements
+static unsigned char sample_ticks;          // Ticks since the last measurement
+static unsigned char stable_samples;        // Samples in a row within the band
+unsigned int humidicon_samples;             // Measurements started
 
 // ---------- Static Function Prototypes ---------- //
-static void SPI_humidicon_config();
+static void select_humidicon(unsigned char n);
+static void deselect_humidicon(unsigned char n);
+static bool fetch_one_humidicon(unsigned char n);
+static bool humidicon_in_band(humidicon_sensor *s);
+static void humidicon_adapt(bool stable);
 static unsigned char read_humidicon_byte();
-static void read_humidicon();
 static unsigned int compute_scaled_rh(unsigned int rh);
 static unsigned int compute_scaled_temp(unsigned int temp);
 
-/***********************************************************************
- Function             : void meas_display_rh_temp()
- Date                 : 04/09/2018
+/**************************************************************
+ Function             : void measure_rh_temp()
+ Date                 : 10/16/2026
  Version              : 1.0
  Target MCU           : ATmega128
  Author               : Wilmer Suarez
  DESCRIPTION
- This function configures the Humidicon for SPI and gets the calculated
- temperature and humidity values from the Humidicon. The function then
- displays the results on a DOG 3 x 16 LCD in the following format:
- Time: hh:mm:ss - other file
- Temp: tempC
- RH:   rh%
-***********************************************************************/
-void meas_display_rh_temp() {
-  // ---------- Configure MCU for Humidicon SPI ---------- //
-  SPI_humidicon_config();
+ Fetches the conversion started earlier, if it was not
+ fetched yet, then starts the next one when the sampling
+ interval is up. Called every tick, with or without the
+ display.
+**************************************************************/
+void measure_rh_temp() {
+  if(humidicon_state == hum_done) {
+    fetch_humidicon();
+  }
+  if(++sample_ticks < sample_interval) {
+    return;                       // Signal is stable, keep the cached values
+  }
+  sample_ticks = 0;
+  start_humidicon();
+}
+/**************************************************************
+ Function             : void humidicon_sample_fast()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Called on user interaction. Returns to sampling every
+ tick and starts a measurement now, so the values shown
+ are fresh.
+**************************************************************/
+void humidicon_sample_fast() {
+  sample_interval = 1;
+  sample_ticks = 0;
+  stable_samples = 0;
+  if(humidicon_state == hum_done) {
+    fetch_humidicon();
+  }
+  start_humidicon();
+}
+
+/**************************************************************
+ Function             : void start_humidicon()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ This function sends a measurement request to every Humidicon
+ and starts Timer1 to interrupt when the measurement cycle
+ is complete. The sensors convert at the same time, so one
+ Timer1 period covers all of them. It does nothing if a 
+ conversion is already in progress.
+**************************************************************/
+void start_humidicon() {
+  unsigned char sreg, n;
   
-  // --------- Get Scaled temperature and Humidity values ---------- //
-  read_humidicon();
+  if(humidicon_state == hum_converting) {
+    return;
+  }
   
-  // ------------ Print Temperature and Humidity ------------ //
-  if(tempCF == true) {  // Display temperature in degrees Celcius
-    printf("Temp: %d.%d%cC\nRH:   %d.%d%%", 
-           (temperatureC / 100), (temperatureC % 100), 0xDF, (humidity / 100), (humidity % 100));
-  } else {      // Display temperature in degrees Fahrenheit
-    float c = 9/5;
-    temperatureF = (int) ((temperatureC / 100) * c) + 32;
-    printf("Temp: %d.%d%cF\nRH:   %d.%d%%", 
-           temperatureF, (temperatureF % 100), 0xDF, (humidity / 100), (humidity % 100));
+  // --------------- Measurement Request to every sensor --------------- //
+  spi_begin(spi_humidicon);
+  for(n = 0; n < HUMIDICON_COUNT; n++) {
+    select_humidicon(n);          // Select Humidicon n as Slave
+    spi_transfer(0xFF);           // Measurement request Command
+    deselect_humidicon(n);        // De-select Humidicon n as Slave
   }
+  spi_end(spi_humidicon);
+  
+  humidicon_state = hum_converting;
+  humidicon_samples++;
   
-  init_lcd_dog();                   // Initialize the Display
-  update_lcd_dog();                 // Updates the LCD to display the current time, temperature, and humidity stored in the display buffers
+  // --------------- Interrupt when the conversion is done --------------- //
+  sreg = __save_interrupt();
+  __disable_interrupt();
+  OCR1A = HUMIDICON_CONV_TICKS - 1;
+  TCNT1 = 0;
+  TIFR = (1 << OCF1A);                                // Clear a stale compare match
+  TCCR1A = 0;
+  TCCR1B = (1 << WGM12) | (1 << CS12) | (1 << CS10);  // CTC, fosc/1024
+  SETBIT(TIMSK, OCIE1A);
+  __restore_interrupt(sreg);
 }
 
-/***************************************************
- Function             : void SPI_humidicon_config()
- Date                 : 04/09/2018
+/**************************************************************
+ ISR Name             : __interrupt void humidicon_ISR()
+ Target MCU           : ATmega128 @ 16MHz
+ Date                 : 10/16/2026
+ Author               : Wilmer Suarez
+ Version              : 1.0
+ DESCRIPTION
+ Timer1 compare A interrupt. Occurs when the Humidicon 
+ measurement cycle is complete. Stops Timer1, marks
+ the conversion as done, and lets the main loop fetch it.
+**************************************************************/
+#pragma vector=TIMER1_COMPA_vect              // Vector Location for Timer1 compare A interrupt
+__interrupt void humidicon_ISR() {
+  TCCR1B = 0;                                 // Stop Timer1
+  CLEARBIT(TIMSK, OCIE1A);
+  humidicon_state = hum_done;
+  post_event(ev_humidicon, 0);
+}
+
+/**************************************************************
+ Function             : bool humidicon_ready()
+ Date                 : 10/16/2026
  Version              : 1.0
  Target MCU           : ATmega128
  Author               : Wilmer Suarez
  DESCRIPTION
- This function unselects the HumidIcon and 
- configures it for operation with
- an ATmega128A operated a 16 MHz. Pin PA0 of the 
- ATmega128A is used to select the HumidIcon
-***************************************************/
-void SPI_humidicon_config() {
-  // ---------------- PORT Configuration ---------------- //
-  SETBIT(PORTA, 0); // Initially de-select HumidIcon
-  
-  // ---------------- SPI Configuration ---------------- //
-    
-  // Set SPE, MSTR, and SPR1 (fosc/64) //
-  SPCR = (1 << SPE) | (1 << MSTR) | (1 << SPR1); 
-
-  // Clear SPIF in SPSR //
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+ Returns true when the conversion started by 
+ start_humidicon() is complete and can be fetched.
+**************************************************************/
+bool humidicon_ready() {
+  return humidicon_state == hum_done;
 }
 
 /**************************************************************
- Function             : void read_humidicon()
+ Function             : bool fetch_humidicon()
+ Date                 : 10/16/2026
+ Version              : 3.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Reads the conversion of every sensor, in order, and 
+ adapts the sampling interval. Returns false if the data
+ of any sensor was stale.
+**************************************************************/
+bool fetch_humidicon() {
+  unsigned char n;
+  bool fresh = true, changed = false;
+  PROF_ENTER(prof_fetch_humidicon);
+  humidicon_state = hum_idle;
+  
+  for(n = 0; n < HUMIDICON_COUNT; n++) {
+    if(!fetch_one_humidicon(n)) {
+      fresh = false;
+    } else if(!humidicon_in_band(&humidicons[n])) {
+      changed = true;
+    }
+  }
+  humidicon_status = humidicons[0].status;
+  if(humidicon_status == HUMIDICON_STATUS_OK) {
+    humidicon_sequence++;                 // Consumers skip samples they have seen
+  }
+  humidicon_adapt(fresh && !changed);   // Stale data is retried on the next tick
+  
+  PROF_EXIT(prof_fetch_humidicon);
+  return fresh;
+}
+/**************************************************************
+ Function             : static bool fetch_one_humidicon(
+                        unsigned char n)
  Date                 : 04/09/2018
- Version              : 1.0
+ Version              : 2.0
  Target MCU           : ATmega128
  Author               : Wilmer Suarez
  DESCRIPTION
- This function selects the Humidicon by asserting PA0. 
- It then calls read_humidicon_byte() four times to read 
- the temperature and humidity information. Is assigns 
- the values read to the global unsigned ints 
+ This function selects Humidicon n by asserting its chip
+ select. It then calls read_humidicon_byte() four times to 
+ read the temperature and humidity information into 
  humidicon_byte1, humidion_byte2, humidion_byte3, and 
  humidion_byte4, respectively. The function then 
- deselects the HumidIcon. 
+ deselects the HumidIcon. Each sensor is its own bus
+ transaction, so the LCD can use the bus in between.
+ 
+ The two status bits are checked. If the data is stale
+ (or the sensor is in command/diagnostic mode) the last
+ values are kept and false is returned.
  
  The function then extracts the fourteen bits 
  corresponding to the humidity information and stores 
- them right justified in the global unsigned int humidity_raw.
+ them right justified in humidity_raw of the sensor.
  Next it extracts the fourteen bits corresponding to 
- the temperature information and stores them in the global 
- unsigned int temperature_raw. The function then returns
+ the temperature information and stores them in 
+ temperature_raw. The function then returns true.
 **************************************************************/
-void read_humidicon() {
-  // Select Humidicon as Slave //
-  CLEARBIT(PORTA, 0);
-    
-  SPDR = 0xFF;  // Measurement request Command
+static bool fetch_one_humidicon(unsigned char n) {
+  humidicon_sensor *s = &humidicons[n];
+  unsigned int humidicon_byte1;           // First byte of Humidicon data
+  unsigned int humidicon_byte2;           // Second byte of Humidicon data
+  unsigned int humidicon_byte3;           // Third byte of Humidicon data
+  unsigned int humidicon_byte4;           // Fourth byte of Humidicon data
   
-  // Wait for measuremnt cycle to complete (36.65 ms) // 
-  __delay_cycles(16 * 36650);
+  // Select Humidicon as Slave //
+  spi_begin(spi_humidicon);
+  select_humidicon(n);
    
   // --------------- Read the 4 bytes of valid data from the Humidicon --------------- // 
   // Read the first byte of Humidicon Data //  
   humidicon_byte1 = read_humidicon_byte();
   
+  s->status = humidicon_byte1 >> 6;       // First two bits of data (status bits)
   humidicon_byte1 &= 0x3F;      // Mask first two bits of data (status bits) 
   
   // Read the second byte of Humidicon Data //
@@ -143,16 +319,166 @@ void read_humidicon() {
   humidicon_byte4 = read_humidicon_byte(); 
   
   // De-select Humidicon as Slave //
-  SETBIT(PORTA, 0);
+  deselect_humidicon(n);
+  spi_end(spi_humidicon);
+  
+  // ----- Keep the last values if the data is not new ----- //
+  if(s->status != HUMIDICON_STATUS_OK) {
+    humidicon_stale_count++;
+    return false;
+  }
   
   // ----- Get 14 bits of Humidity and 14 bits of Temperature and store ----- //
   // ----- them in respective Varaibles ----- //
-  humidity_raw = (humidicon_byte1 << 8) | (humidicon_byte2);   
-  temperature_raw = (humidicon_byte3 << 6) | (humidicon_byte4 >> 2);
+  s->humidity_raw = (humidicon_byte1 << 8) | (humidicon_byte2);   
+  s->temperature_raw = (humidicon_byte3 << 6) | (humidicon_byte4 >> 2);
   
   // ---------- Compute scaled value of Humidity and Temperature ---------- //
-  humidity = compute_scaled_rh(humidity_raw);
-  temperatureC = compute_scaled_temp(temperature_raw);  
+  s->humidity = compute_scaled_rh(s->humidity_raw);
+  s->temperatureC = compute_scaled_temp(s->temperature_raw);  
+  return true;
+}
+
+/**************************************************************
+ Function             : static bool humidicon_in_band(
+                        humidicon_sensor *s)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns true if the last reading of s is within the 
+ band of its reference reading. Otherwise the reading 
+ becomes the new reference and false is returned.
+**************************************************************/
+static bool humidicon_in_band(humidicon_sensor *s) {
+  unsigned int drh, dtemp;
+  
+  drh = (s->humidity_raw > s->ref_rh) ? s->humidity_raw - s->ref_rh : s->ref_rh - s->humidity_raw;
+  dtemp = (s->temperature_raw > s->ref_temp) ? s->temperature_raw - s->ref_temp : s->ref_temp - s->temperature_raw;
+  if((drh <= HUMIDICON_BAND_RH) && (dtemp <= HUMIDICON_BAND_TEMP)) {
+    return true;
+  }
+  
+  s->ref_rh = s->humidity_raw;
+  s->ref_temp = s->temperature_raw;
+  return false;
+}
+/**************************************************************
+ Function             : static void humidicon_adapt(
+                        bool stable)
+ Date                 : 10/16/2026
+ Version              : 1.1
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the sampling interval after a fetch. stable is 
+ true if every sensor was fresh and within its band.
+ A change or a stale fetch brings the interval back to
+ every tick. HUMIDICON_WINDOW stable samples in a row 
+ double it, up to HUMIDICON_MAX_INTERVAL.
+**************************************************************/
+static void humidicon_adapt(bool stable) {
+  if(!stable) {
+    sample_interval = 1;
+    stable_samples = 0;
+  } else if(++stable_samples >= HUMIDICON_WINDOW) {
+    stable_samples = 0;
+    if(sample_interval < HUMIDICON_MAX_INTERVAL) {
+      sample_interval <<= 1;
+    }
+  }
+}
+/**************************************************************
+ Function             : void humidicon_raw(unsigned int *rh, 
+                        unsigned int *temp)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the raw 14-bit humidity and temperature codes of 
+ the last valid fetch of sensor 0.
+**************************************************************/
+void humidicon_raw(unsigned int *rh, unsigned int *temp) {
+  humidicon_sensor_raw(0, rh, temp);
+}
+/**************************************************************
+ Function             : void humidicon_sensor_raw(
+                        unsigned char n, unsigned int *rh, 
+                        unsigned int *temp)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the raw 14-bit humidity and temperature codes of 
+ the last valid fetch of sensor n.
+**************************************************************/
+void humidicon_sensor_raw(unsigned char n, unsigned int *rh, unsigned int *temp) {
+  *rh = humidicons[n].humidity_raw;
+  *temp = humidicons[n].temperature_raw;
+}
+/**************************************************************
+ Function             : void humidicon_sensor_scaled(
+                        unsigned char n, unsigned int *rh, 
+                        unsigned int *tempC)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the humidity (0.01% RH) and temperature (0.01 
+ degrees C) of the last valid fetch of sensor n.
+**************************************************************/
+void humidicon_sensor_scaled(unsigned char n, unsigned int *rh, unsigned int *tempC) {
+  *rh = humidicons[n].humidity;
+  *tempC = humidicons[n].temperatureC;
+}
+/**************************************************************
+ Function             : void init_humidicon()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Makes the chip select of every sensor an output and 
+ de-selects the sensor.
+**************************************************************/
+void init_humidicon() {
+  unsigned char n;
+  
+  for(n = 0; n < HUMIDICON_COUNT; n++) {
+    deselect_humidicon(n);
+    SETBIT(*humidicon_cs_pins[n].ddr, humidicon_cs_pins[n].pin);
+  }
+}
+/**************************************************************
+ Function             : static void select_humidicon(
+                        unsigned char n)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Asserts (low) the chip select of sensor n. The caller 
+ owns the bus.
+**************************************************************/
+static void select_humidicon(unsigned char n) {
+  CLEARBIT(*humidicon_cs_pins[n].port, humidicon_cs_pins[n].pin);
+}
+/**************************************************************
+ Function             : static void deselect_humidicon(
+                        unsigned char n)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ De-asserts (high) the chip select of sensor n.
+**************************************************************/
+static void deselect_humidicon(unsigned char n) {
+  SETBIT(*humidicon_cs_pins[n].port, humidicon_cs_pins[n].pin);
 }
 
 /****************************************************************
@@ -169,23 +495,45 @@ void read_humidicon() {
  SPI status flag.
 ****************************************************************/
 unsigned char read_humidicon_byte() {
-  // Write dummy data to SPDR (To initiate Clock) //
-  SPDR = 0xFF; 
-  
-  // Wait until humidicon sends first byte of data // 
-  while(!(SPSR & (1 << SPIF)));
-  
-  // Read byte from Humidicon // 
-  unsigned char dataByte = SPDR;   
-  
-  // Clear SPIF //
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+  // Write dummy data to SPDR (To initiate Clock) and read the byte sent by the Humidicon //
+  unsigned char dataByte = spi_transfer(0xFF);   
 
   // Return the byte of data read from the Humidicon // 
   return dataByte;
 }
 
+/****************************************************************************
+ Function             : unsigned int humidicon_rh_to_raw(unsigned int rh)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Inverse of compute_scaled_rh(): converts a relative humidity in units of 
+ 0.01% RH to the nearest raw 14-bit Humidicon code. Used to convert a limit
+ once, so samples are compared as raw codes.
+****************************************************************************/
+unsigned int humidicon_rh_to_raw(unsigned int rh) {
+  unsigned long raw = ((unsigned long)rh * 16380 + 5000) / 10000;
+  return (raw > 0x3FFF) ? 0x3FFF : (unsigned int)raw;
+}
+/****************************************************************************
+ Function             : unsigned int humidicon_temp_to_raw(int temp)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Inverse of compute_scaled_temp(): converts a temperature in units of 0.01
+ degrees C (-40.00 to 125.00) to the nearest raw 14-bit Humidicon code.
+****************************************************************************/
+unsigned int humidicon_temp_to_raw(int temp) {
+  long raw = ((long)(temp + 4000) * 16380 + 8250) / 16500;
+  if(raw < 0) {
+    return 0;
+  }
+  return (raw > 0x3FFF) ? 0x3FFF : (unsigned int)raw;
+}
 /****************************************************************************
  Function             : unsigned int compute_scaled_rh(unsigned int rh)
  Date                 : 04/09/2018
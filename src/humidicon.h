@@ -10,5 +10,34 @@
 // the Humidicon and the ATmega128A.
 //************************************************* 
 
-// ------- External functoin to measure and display Humidity and Temperature ------- //
-extern void meas_display_rh_temp();
+// Number of Humidicons on the SPI bus (1 to 8), can be set by the
+// build. The chip select of each sensor is listed in 
+// humidicon_cs_pins in humidicon.c.
+#ifndef HUMIDICON_COUNT
+#define HUMIDICON_COUNT     1
+#endif
+
+// Adaptive sampling: the interval doubles after HUMIDICON_WINDOW samples
+// in a row within the band (raw 14-bit codes), up to HUMIDICON_MAX_INTERVAL
+// ticks, and goes back to every tick on a change or a key press.
+#define HUMIDICON_BAND_RH       33      // About 0.2% RH
+#define HUMIDICON_BAND_TEMP     20      // About 0.2 degrees C
+#define HUMIDICON_WINDOW        8
+#define HUMIDICON_MAX_INTERVAL  16      // Power of 2, at most 128
+
+// ------- Split-phase measurement (header.h must be included first) ------- //
+extern void init_humidicon();               // Chip selects of every sensor as de-selected outputs
+extern void measure_rh_temp();              // Fetch the last conversion, start the next one when due
+extern void humidicon_sample_fast();        // User interaction: sample every tick, measure now
+extern void start_humidicon();              // Send measurement request to every sensor, Timer1 marks it done
+extern bool humidicon_ready();              // True when the conversion can be fetched
+extern bool fetch_humidicon();              // Read every sensor, false if any data is stale
+extern void humidicon_raw(unsigned int *rh, unsigned int *temp);   // Raw 14-bit codes of sensor 0
+extern void humidicon_sensor_raw(unsigned char n, unsigned int *rh, unsigned int *temp);   // Raw codes of sensor n
+extern void humidicon_sensor_scaled(unsigned char n, unsigned int *rh, unsigned int *tempC);   // 0.01% RH, 0.01 degrees C
+extern unsigned int humidicon_rh_to_raw(unsigned int rh);   // 0.01% RH -> raw 14-bit code
+extern unsigned int humidicon_temp_to_raw(int temp);        // 0.01 degrees C -> raw 14-bit code
+extern unsigned char humidicon_status;      // Status bits of the last fetch of sensor 0
+extern unsigned int humidicon_stale_count;  // Fetches rejected because of the status bits (all sensors)
+extern unsigned char humidicon_sequence;    // Fresh samples of sensor 0 (mod 256)
+extern unsigned int humidicon_samples;      // Measurements started
@@ -0,0 +1,280 @@
+/******************************************************************
+ File Name            : "keypad.c"
+ Title                : Timer Driven Keypad Scanner
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The 4x4 keypad is on PORTC (rows PC3->PC0, columns PC7->PC4). 
+ While no key is down the columns drive 0, the rows have pull-ups,
+ and a pressed key pulls /INT0 low.
+ 
+ INT0 only starts the scan and masks itself. The scan then runs 
+ from the Timer2 interrupt (timeout.c) every 10ms, in two phases
+ so it never waits for the port to settle:
+ - phase 1 reads the rows, then turns the port around,
+ - phase 2 reads the columns, then turns it back.
+ Each two ticks give one sample: the key table position (the same
+ as before, so kTable is unchanged) or no key.
+ 
+ A key is pressed or released after DEBOUNCE_SAMPLES equal samples
+ (40ms). A key held down repeats after REPEAT_DELAY samples, then
+ every REPEAT_RATE samples. Press, release, and repeat events are
+ put in a FIFO, and an ev_key event tells the main loop to empty 
+ it, so keys typed while the main loop is busy are kept. The scan
+ stops and INT0 is enabled again once no key is down.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "events.h"
+#include "timeout.h"
+#include "profile.h"
+#include "keypad.h"
+
+// PortC pin numbers for columns and rows of the keypad
+#define COL1  7   
+#define COL2  6
+#define COL3  5
+#define COL4  4
+#define ROW1  3
+#define ROW2  2
+#define ROW3  1
+#define ROW4  0
+
+#define KEY_NONE            0xFF    // No key in a sample
+#define DEBOUNCE_SAMPLES    2       // 20ms samples
+#define REPEAT_DELAY        25      // 500ms before the first repeat
+#define REPEAT_RATE         5       // 100ms between repeats
+
+#define KEY_FIFO_SIZE       16      // Must be a power of 2
+#define KEY_FIFO_MASK       (KEY_FIFO_SIZE - 1)
+
+// ----- Scanner state (Timer2 ISR) ----- //
+static volatile bool kp_scanning;   // INT0 is masked and Timer2 scans
+static bool kp_column_phase;        // Next tick reads the columns
+static unsigned char kp_row;        // Row code read in phase 1
+static unsigned char kp_candidate;  // Last sample
+static unsigned char kp_stable;     // Number of equal samples in a row
+static unsigned char kp_down = KEY_NONE;    // Debounced key that is down
+static unsigned char kp_hold;       // Samples until the next repeat
+
+// ----- Key FIFO ----- //
+static unsigned char key_fifo[KEY_FIFO_SIZE];
+static volatile unsigned char key_head;     // Written by the ISR
+static volatile unsigned char key_tail;     // Written by the main loop
+unsigned int keypad_dropped;
+
+// ----- Local Function Prototypes ----- //
+static void key_put(unsigned char key_ev);
+static unsigned char read_rows();
+static unsigned char read_columns();
+
+/*************************************************************
+ Function             : void init_keypad()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Configures PORTC to wait for a key press: rows are 
+ inputs with pull-ups and columns drive 0.
+*************************************************************/
+void init_keypad() {
+  DDRC = 0xF0;                      // High nibble outputs, low nibble inputs 
+  PORTC = 0x0F;                     // High nibble outputs 0's initially
+}
+
+/****************************************************
+  ISR Name             : __interrupt void ISR_INT0()
+  Target MCU           : ATmega128A
+  Author               : Wilmer Suarez
+  Version              : 4.0
+  DESCRIPTION
+  Interrupt service routine for INT0.
+  Occurs when a key is pressed. INT0 is level 
+  sensitive, so it is masked and the Timer2 scan 
+  takes over until all the keys are released.
+****************************************************/
+#pragma vector=INT0_vect              // Vector Location for INT0 interrupt
+__interrupt void ISR_INT0() {
+  PROF_ENTER(prof_key_ISR);
+  CLEARBIT(EIMSK, INT0);              // Re-enabled by keypad_tick when no key is down
+  kp_scanning = true;
+  kp_column_phase = false;
+  kp_candidate = KEY_NONE;
+  kp_stable = 0;
+  timeout_run_timer();
+  PROF_EXIT(prof_key_ISR);
+}
+
+/*************************************************************
+ Function             : bool keypad_tick()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Called by the Timer2 interrupt every 10ms while the 
+ keypad is scanned (INT0 masked). Runs one phase of the
+ scan and, after phase 2, the debounce state machine.
+ Returns false when the scan is finished.
+*************************************************************/
+bool keypad_tick() {
+  unsigned char sample;
+  
+  if(!kp_scanning) {
+    return false;
+  }
+  PROF_ENTER(prof_key_scan);
+  
+  // ----- Phase 1: rows ----- //
+  if(!kp_column_phase) {
+    kp_row = read_rows();
+    DDRC = 0x0F;                      // Reconfigure PORTC for Columns
+    PORTC = 0xF0;
+    kp_column_phase = true;
+    PROF_EXIT(prof_key_scan);
+    return true;
+  }
+  
+  // ----- Phase 2: columns ----- //
+  sample = read_columns();
+  DDRC = 0xF0;                        // Reconfigure PORTC for Rows for next keypad press
+  PORTC = 0x0F;
+  kp_column_phase = false;
+  if((kp_row == KEY_NONE) || (sample == KEY_NONE)) {
+    sample = KEY_NONE;
+  } else {
+    sample += kp_row;
+  }
+  
+  // ----- Debounce ----- //
+  if(sample == kp_candidate) {
+    if(kp_stable < 0xFF) {
+      kp_stable++;
+    }
+  } else {
+    kp_candidate = sample;
+    kp_stable = 1;
+  }
+  
+  if(kp_down != KEY_NONE) {
+    if(kp_candidate == kp_down) {
+      if(--kp_hold == 0) {            // Held down
+        key_put(KEY_REPEAT | kp_down);
+        kp_hold = REPEAT_RATE;
+      }
+    } else if(kp_stable >= DEBOUNCE_SAMPLES) {
+      key_put(KEY_RELEASE | kp_down);
+      kp_down = KEY_NONE;
+    }
+  }
+  
+  if((kp_down == KEY_NONE) && (kp_stable >= DEBOUNCE_SAMPLES)) {
+    if(kp_candidate != KEY_NONE) {
+      key_put(KEY_PRESS | kp_candidate);
+      kp_down = kp_candidate;
+      kp_hold = REPEAT_DELAY;
+    } else {
+      kp_scanning = false;
+      SETBIT(EIMSK, INT0);            // All keys released, wait for the next press
+      PROF_EXIT(prof_key_scan);
+      return false;
+    }
+  }
+  
+  PROF_EXIT(prof_key_scan);
+  return true;
+}
+
+/*************************************************************
+ Function             : bool keypad_get(unsigned char *key_ev)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Removes the oldest key event from the FIFO. Returns 
+ false if it is empty. Only the ISR moves the head and
+ only the main loop moves the tail, so no lock is 
+ needed.
+*************************************************************/
+bool keypad_get(unsigned char *key_ev) {
+  unsigned char tail = key_tail;
+  
+  if(tail == key_head) {
+    return false;
+  }
+  *key_ev = key_fifo[tail];
+  key_tail = (tail + 1) & KEY_FIFO_MASK;
+  return true;
+}
+
+/*************************************************************
+ Function             : static void key_put(
+                        unsigned char key_ev)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Adds a key event to the FIFO and posts ev_key. Called 
+ from the Timer2 ISR.
+*************************************************************/
+static void key_put(unsigned char key_ev) {
+  unsigned char next = (key_head + 1) & KEY_FIFO_MASK;
+  
+  if(next == key_tail) {
+    keypad_dropped++;
+    return;
+  }
+  key_fifo[key_head] = key_ev;
+  key_head = next;
+  post_event(ev_key, 0);
+}
+
+/*************************************************************
+ Function             : static unsigned char read_rows()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the key table offset of the row that is low, or
+ KEY_NONE.
+*************************************************************/
+static unsigned char read_rows() {
+  if(!TESTBIT(PINC,ROW1))             // Find Row of pressed key
+    return 0;
+  else if(!TESTBIT(PINC,ROW2))
+    return 4;
+  else if(!TESTBIT(PINC,ROW3))
+    return 8;
+  else if(!TESTBIT(PINC,ROW4))
+    return 12;
+  return KEY_NONE;
+}
+
+/*************************************************************
+ Function             : static unsigned char read_columns()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the key table offset of the column that is low,
+ or KEY_NONE.
+*************************************************************/
+static unsigned char read_columns() {
+  if(!TESTBIT(PINC,COL1))             // Find Column
+    return 0;
+  else if(!TESTBIT(PINC,COL2))
+    return 1;
+  else if(!TESTBIT(PINC,COL3))
+    return 2;
+  else if(!TESTBIT(PINC,COL4))
+    return 3;
+  return KEY_NONE;
+}
@@ -0,0 +1,27 @@
+/****************************************************************
+  File Name            : "keypad.h" 
+  Title                : Keypad Scanner Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the key event encoding and the
+  external functions of the timer driven keypad scanner.
+  header.h must be included first.
+****************************************************************/ 
+
+// ---------- Key events (one byte) ---------- //
+#define KEY_CODE_MASK   0x0F        // Key table position 0->15 (kTable)
+#define KEY_TYPE_MASK   0xC0
+#define KEY_PRESS       0x00
+#define KEY_RELEASE     0x40
+#define KEY_REPEAT      0x80        // Key held down
+
+// ------- External Functions for the Keypad ------- //
+extern void init_keypad();                      // PORTC rows/columns, idle until INT0
+extern bool keypad_tick();                      // Timer2 ISR, every 10ms while scanning
+extern bool keypad_get(unsigned char *key_ev);  // Main loop, false if the FIFO is empty
+
+// ------- Counters ------- //
+extern unsigned int keypad_dropped;             // Key events lost because the FIFO was full
@@ -24,11 +24,29 @@ extern char dsp_buff_3[16];
 /**
  *  Declaratios of low level lcd functions located in lcd_dog_iar_driver.c
  *  Note that these are external.
+ *  init_lcd_dog() runs the power-on sequence only once; update_lcd_dog()
+ *  brings the display up itself if it was never initialized.
+ *  update_lcd_dog() only sends characters that differ from the shadow copy
+ *  of the DDRAM; invalidate_lcd_dog() forces the next update to resend.
+ *  The bytes are queued and sent by the Timer0 compare interrupt, so 
+ *  update_lcd_dog() returns at once. lcd_tx_done is set (and the callback
+ *  is called from the interrupt) when the queue has been drained. If a 
+ *  full queue deferred some runs, ev_lcd is posted instead and the main
+ *  loop calls update_lcd_dog() again.
  */
 extern void init_lcd_dog();
 extern void update_lcd_dog();
+extern void invalidate_lcd_dog();
+extern void set_lcd_tx_callback(void (*callback)(void));
+extern volatile char lcd_tx_done;
+extern volatile unsigned int lcd_queue_overflows;
 
 /**
  *  These functions are located in lcd_ext.c
+ *  The lcd_put functions replace printf on the refresh path.
  */
 extern int putchar(int);
+extern void lcd_puts(const char *str);
+extern void lcd_put_uint(unsigned int value, unsigned char width);    // Zero-padded to width digits
+extern void lcd_put_fixed(int value, unsigned char decimals);         // value / 10^decimals
+extern void lcd_put_2digits(unsigned char value);                    // 00->99, table driven, "--" above 99
@@ -15,14 +15,36 @@
 //
 // The display module software interface uses three (3) 16-byte
 // data (RAM) based display buffers - One for each line of the display.  
+//
+// The power-on command sequence (with its 40ms and 200ms delays) is 
+// executed only once. The driver tracks the state of the controller and
+// keeps a shadow copy of its DDRAM, so a refresh only sends the runs of
+// characters that changed since the last update.
+//
+// Refreshes do not block: update_lcd_dog() places the bytes in a transmit
+// queue and returns. The Timer0 compare interrupt sends one queued byte
+// every 32us, which also covers the execution time of the controller.
+// Runs that do not fit in the queue are left in the display buffers:
+// once the queue drains, lcd_tx_ISR posts ev_lcd and the main loop calls
+// update_lcd_dog() again. The buffers are only compared in the main loop.
+//
+// The SPI port is shared, so the LCD is selected through the SPI bus
+// manager (spi_bus.c) which also sets its SPI mode and clock.
 //***********************************************************************  
 #include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "spi_bus.h"
+#include "events.h"
+#include "profile.h"
 
 // Declare external function prototypes
 void init_lcd_dog();
 void update_lcd_dog();
+void invalidate_lcd_dog();
+void set_lcd_tx_callback(void (*callback)(void));
 // Declare local function prototypes
-void init_spi_lcd();
+static void lcd_queue_changes();
+static void lcd_enqueue(unsigned int entry);
+static void start_lcd_tx();
 void lcd_spi_transmit_CMD(char command);
 void lcd_spi_transmit_DATA(char data);
 
@@ -35,11 +57,42 @@ void lcd_spi_transmit_DATA(char data);
 #define	BLC     5
 #define FREQ    16      // Clock Speed (MHz)   
 
+// In 3-line mode the DDRAM of the DOG163 is contiguous (0x00 -> 0x2F), 
+// so all three lines can be written after a single address set.
+#define DDRAM_LINE1     0x80    // Set DDRAM Address command for line 1
+#define LCD_CHARS       48      // Total number of characters on the display
+#define RUN_GAP         1       // Unchanged characters bridged inside a run. A new run
+                                // costs one address byte, so resending a 1 character gap costs no more.
+
 //--------------- Display buffer definitions ---------------//
 char dsp_buff_1[16];    
 char dsp_buff_2[16];
 char dsp_buff_3[16];
 
+//--------------- LCD controller states ---------------//
+typedef enum {lcd_off, lcd_ready} lcd_state;
+static lcd_state lcd_status = lcd_off;  // Set to lcd_ready once the power-on sequence is done
+
+//--------------- Shadow DDRAM ---------------//
+static char lcd_shadow[LCD_CHARS];      // Characters the DOG controller is currently showing
+static char * const lcd_lines[3] = {dsp_buff_1, dsp_buff_2, dsp_buff_3};
+#define LCD_CELL(i)     (lcd_lines[(i) >> 4][(i) & 0x0F])
+
+//--------------- Transmit queue ---------------//
+// Each entry holds the byte in bits 0-7 and the state of the RS line in bit 8
+#define LCD_QUEUE_SIZE  64      // Must be a power of 2. Holds a full 48 character refresh
+#define LCD_QUEUE_MASK  (LCD_QUEUE_SIZE - 1)
+#define LCD_RS_DATA     0x0100  // RS = 1 = data, otherwise command
+#define LCD_TX_OCR      63      // Timer0 compare value: 16MHz / 8 / (63 + 1) = 32us per byte
+
+static volatile unsigned int lcd_queue[LCD_QUEUE_SIZE];
+static volatile unsigned char lcd_head;         // Next free entry (written by update_lcd_dog)
+static volatile unsigned char lcd_tail;         // Next entry to send (written by lcd_tx_ISR)
+static void (*lcd_tx_callback)(void);           // Called from lcd_tx_ISR when the queue drains
+volatile char lcd_tx_done = true;               // True when every queued byte has been sent
+static volatile char lcd_pending;               // A run was deferred, ev_lcd is posted when the queue drains
+volatile unsigned int lcd_queue_overflows;      // Runs that did not fit and were deferred
+
 //*************************************************
 // Function Name        : "init_lcd_dog" 
 // Date                 : 02/24/2018
@@ -51,15 +104,23 @@ char dsp_buff_3[16];
 // operation. 
 //
 // Warnings             : none 
-// Restrictions         : none 
+// Restrictions         : Only the first call runs the
+//                        power-on sequence. Later calls
+//                        return immediately.
 // Algorithms           : none 
 // References           : none 
 // 
 // Revision History     : Initial version  
+//                        10/16/2026 - Run once, track
+//                        controller state
 //*************************************************
 void init_lcd_dog() {
-//--------------- Initialize LCD DOG ---------------//
-  init_spi_lcd();
+  if(lcd_status == lcd_ready) {
+    return;                             // Controller already powered up
+  }
+  
+//--------------- Select LCD on the SPI bus ---------------//
+  spi_begin(spi_lcd);
   
 //--------------- Delay for 40ms ---------------//
   __delay_cycles(FREQ * 40000);
@@ -117,82 +178,221 @@ void init_lcd_dog() {
 
   __delay_cycles(FREQ * 30);      // Delay for 30us
   
+  spi_end(spi_lcd);
+  lcd_status = lcd_ready;
+  invalidate_lcd_dog();                 // Clear display leaves spaces in DDRAM
 }
 
 //*************************************************
-// Function Name        : "init_spi_lcd" 
+// Function Name        : "lcd_spi_transmit_CMD" 
 // Date                 : 02/24/2018
 // Version              : 1.0 
 // Target MCU           : ATMEGA128A 
 // Author               : Wilmer Suarez
 // DESCRIPTION 
-// Initializes SPI port for command and data writes
-// to LCD via SPI.
+// Outputs the byte passed via SPI port. Waits for
+// data to be written by SPI port before continuing.
 //
 // Warnings             : none 
-// Restrictions         : none 
+// Restrictions         : The LCD must own the SPI bus
 // Algorithms           : none 
 // References           : none 
 // 
 // Revision History     : Initial version  
+//                        10/16/2026 - /SS and SPI mode
+//                        handled by spi_bus.c
 //*************************************************
 
-void init_spi_lcd() {
-   // Enables SPI, Master, SCLK Freq: fosc/64
-   SPCR = ((1 << SPE) | (1 << MSTR) | (1 << CPOL) | (1 << CPHA) | (1 << SPR1) | (1 << SPR0));
-  
-   // Kill spurious data
-   // Reading SPSR and SPDR, clears the SPIF bit
-   TESTBIT(SPSR, SPIF);
-   TESTBIT(SPDR, 0);
+void lcd_spi_transmit_CMD(char command) {
+  CLEARBIT(PORTB, RS);          // RS = 0 = command
+  spi_transfer(command);        // Write data to SPI port
 }
 
 //*************************************************
-// Function Name        : "lcd_spi_transmit_CMD" 
+// Function Name        : "update_lcd_dog" 
 // Date                 : 02/24/2018
+// Version              : 4.0 
+// Target MCU           : ATMEGA128A 
+// Author               : Wilmer Suarez
+// DESCRIPTION 
+// Updates all 3 lines of the LCD using the contents
+// of dsp_buff_1, dsp_buff_2, dsp_buff_3
+//
+// Warnings             : Runs that do not fit in the
+//                        transmit queue are sent by the
+//                        next call, made by the main 
+//                        loop on ev_lcd once lcd_tx_ISR
+//                        has drained the queue. 
+// Restrictions         : none 
+// Algorithms           : see lcd_queue_changes
+// References           : none 
+// 
+// Revision History     : Initial version  
+//                        10/16/2026 - Fast path: one
+//                        DDRAM address set, then the 
+//                        48 bytes are streamed
+//                        10/16/2026 - Only changed runs
+//                        are sent
+//                        10/16/2026 - Runs are queued 
+//                        for lcd_tx_ISR, returns at once
+//*************************************************
+
+void update_lcd_dog() {
+  PROF_ENTER(prof_update_lcd);
+  
+//--------------- Bring up the LCD if needed ---------------//
+  if(lcd_status != lcd_ready) {
+    init_lcd_dog();
+  }
+  
+  lcd_pending = false;
+  lcd_queue_changes();
+  
+  start_lcd_tx();
+  PROF_EXIT(prof_update_lcd);
+}
+
+//*************************************************
+// Function Name        : "lcd_queue_changes" 
+// Date                 : 10/16/2026
 // Version              : 1.0 
 // Target MCU           : ATMEGA128A 
 // Author               : Wilmer Suarez
 // DESCRIPTION 
-// Outputs the byte passed via SPI port. Waits for
-// data to be written by SPI port before continuing.
+// Queues the characters of dsp_buff_1, dsp_buff_2,
+// dsp_buff_3 that differ from the shadow DDRAM.
 //
 // Warnings             : none 
-// Restrictions         : none 
+// Restrictions         : Called by update_lcd_dog only,
+//                        never from an interrupt.
+// Algorithms           : Buffers are compared with the
+//                        shadow DDRAM. Each run of changed
+//                        characters costs one DDRAM address
+//                        set plus its data bytes. Runs
+//                        separated by RUN_GAP or fewer
+//                        unchanged characters are merged.
+//                        A run that does not fit in the 
+//                        queue sets lcd_pending.
+// References           : none 
+// 
+// Revision History     : Initial version  
+//*************************************************
+
+static void lcd_queue_changes() {
+  char i = 0, j, last;          // Start, scan, and last changed position of a run
+  unsigned char space;          // Free entries in the transmit queue
+  
+  while(i < LCD_CHARS) {
+    // Skip characters the display is already showing
+    if(LCD_CELL(i) == lcd_shadow[i]) {
+      i++;
+      continue;
+    }
+    
+    // Find the end of the run starting at i
+    last = i;
+    for(j = i + 1; (j < LCD_CHARS) && (j <= last + RUN_GAP + 1); j++) {
+      if(LCD_CELL(j) != lcd_shadow[j]) {
+        last = j;
+      }
+    }
+    
+    // The run is left in the buffers (and sent once the queue drains) if 
+    // its address and data bytes do not fit in the queue
+    space = (lcd_tail - lcd_head - 1) & LCD_QUEUE_MASK;
+    if(space < (last - i + 2)) {
+      lcd_queue_overflows++;
+      lcd_pending = true;
+      break;
+    }
+    
+    // Queue DDRAM Address of the run
+    lcd_enqueue(DDRAM_LINE1 | i);
+    
+    // Queue the run and update the shadow copy
+    while(i <= last) {
+      lcd_shadow[i] = LCD_CELL(i);
+      lcd_enqueue(LCD_RS_DATA | (unsigned char)lcd_shadow[i]);
+      i++;
+    }
+  }
+}
+
+//*************************************************
+// Function Name        : "lcd_enqueue" 
+// Date                 : 10/16/2026
+// Version              : 1.0 
+// Target MCU           : ATMEGA128A 
+// Author               : Wilmer Suarez
+// DESCRIPTION 
+// Adds one command (RS = 0) or data (LCD_RS_DATA
+// set) byte to the transmit queue.
+//
+// Warnings             : none 
+// Restrictions         : Caller must check that
+//                        the queue has space.
 // Algorithms           : none 
 // References           : none 
 // 
 // Revision History     : Initial version  
 //*************************************************
 
-void lcd_spi_transmit_CMD(char command) {
-  CLEARBIT(PORTB, RS);          // RS = 0 = command
-  CLEARBIT(PORTB, SS_bar);      // /SS = slave selected
+static void lcd_enqueue(unsigned int entry) {
+  lcd_queue[lcd_head] = entry;
+  lcd_head = (lcd_head + 1) & LCD_QUEUE_MASK;
+  lcd_tx_done = false;
+}
 
-  SPDR = command;               // Write data to SPI port
+//*************************************************
+// Function Name        : "start_lcd_tx" 
+// Date                 : 10/16/2026
+// Version              : 1.0 
+// Target MCU           : ATMEGA128A 
+// Author               : Wilmer Suarez
+// DESCRIPTION 
+// Starts Timer0 in CTC mode (fosc/8) and enables
+// its compare interrupt if there are bytes in the
+// queue and the timer is not already running.
+//
+// Warnings             : none 
+// Restrictions         : none 
+// Algorithms           : none 
+// References           : none 
+// 
+// Revision History     : Initial version  
+//*************************************************
 
-  // Wait for transmission complete
-  while(!(SPSR & (1 << SPIF)));
+static void start_lcd_tx() {
+  unsigned char sreg = __save_interrupt();
+  __disable_interrupt();
   
-  // Clear SPIF 
-  TESTBIT(SPSR, SPIF);
-  TESTBIT(SPDR, 0);
+  if((lcd_head != lcd_tail) && !TESTBIT(TIMSK, OCIE0)) {
+    OCR0 = LCD_TX_OCR;
+    TCNT0 = 0;
+    TIFR = (1 << OCF0);                 // Clear a stale compare match
+    TCCR0 = (1 << WGM01) | (1 << CS01); // CTC, fosc/8
+    SETBIT(TIMSK, OCIE0);
+  }
   
-  // De-select slave
-  SETBIT(PORTB, SS_bar);
+  __restore_interrupt(sreg);
 }
 
 //*************************************************
-// Function Name        : "update_lcd_dog" 
-// Date                 : 02/24/2018
+// Function Name        : "lcd_tx_ISR" 
+// Date                 : 10/16/2026
 // Version              : 1.0 
 // Target MCU           : ATMEGA128A 
 // Author               : Wilmer Suarez
 // DESCRIPTION 
-// Updates all 3 lines of the LCD using the contents
-// of dsp_buff_1, dsp_buff_2, dsp_buff_3
+// Timer0 compare interrupt. Sends the next byte in 
+// the transmit queue with the RS line stored in 
+// the entry. Once the queue is empty it stops the
+// timer and either posts ev_lcd if runs were 
+// deferred by a full queue, or sets lcd_tx_done and
+// calls the completion callback.
 //
-// Warnings             : none 
+// Warnings             : The callback runs in 
+//                        interrupt context.
 // Restrictions         : none 
 // Algorithms           : none 
 // References           : none 
@@ -200,53 +400,84 @@ void lcd_spi_transmit_CMD(char command) {
 // Revision History     : Initial version  
 //*************************************************
 
-void update_lcd_dog() {
-//--------------- Initialize LCD DOG ---------------//
-  init_spi_lcd();
+#pragma vector=TIMER0_COMP_vect               // Vector Location for Timer0 compare interrupt
+__interrupt void lcd_tx_ISR() {
+  unsigned int entry;
   
-  char charCount = 16;         // Number of characters per line 
-  char *pLine1 = dsp_buff_1;   // Pointer to beginning of display buffer 1
-  char *pLine2 = dsp_buff_2;   // Pointer to beginning of display buffer 2
-  char *pLine3 = dsp_buff_3;   // Pointer to beginning of display buffer 3
-
- //--------------- Send line 1 to the LCD ---------------//
-  // Send DDRAM Address
-  char ddram_Addr = 0x80;                 // Init DDRAM Addr-Ctr
-  lcd_spi_transmit_CMD(ddram_Addr);
-  __delay_cycles(FREQ * 30);        // Delay for 30us
-  // Send dsp_buff_1
-  while(charCount != 0) {
-    lcd_spi_transmit_DATA(*pLine1++);       // Send byte to LCD
-    __delay_cycles(FREQ * 30);      // Delay for 30us
-    charCount--;
+  // The byte waits for the next tick if another driver owns the bus
+  if((lcd_head != lcd_tail) && spi_try_begin(spi_lcd)) {
+    entry = lcd_queue[lcd_tail];
+    lcd_tail = (lcd_tail + 1) & LCD_QUEUE_MASK;
+    
+    if(entry & LCD_RS_DATA) {
+      lcd_spi_transmit_DATA((char)entry);
+    } else {
+      lcd_spi_transmit_CMD((char)entry);
+    }
+    spi_end(spi_lcd);
   }
   
-//--------------- Send line 2 to the LCD ---------------//
-  charCount = 16;                         // Reinitialize count
-  // Send DDRAM Address
-  ddram_Addr = 0x90;                      // Init DDRAM Addr-Ctr
-  lcd_spi_transmit_CMD(ddram_Addr);
-  __delay_cycles(FREQ * 30);        // Delay for 30us
-  // Send dsp_buff_2
-  while(charCount != 0) {
-    lcd_spi_transmit_DATA(*pLine2++);       // Send byte to LCD
-    __delay_cycles(FREQ * 30);      // Delay for 30us
-    charCount--;
-  }
-//--------------- Send line 3 to the LCD ---------------//
-  charCount = 16;                         // Reinitialize count
-  // Send DDRAM Address
-  ddram_Addr = 0xA0;                      // Init DDRAM Addr-Ctr
-  lcd_spi_transmit_CMD(ddram_Addr);
-  __delay_cycles(FREQ * 30);        // Delay for 30us
-  // Send dsp_buff_3
-  while(charCount != 0) {
-    lcd_spi_transmit_DATA(*pLine3++);       // Send byte to LCD
-    __delay_cycles(FREQ * 30);      // Delay for 30us
-    charCount--;
+  if(lcd_head == lcd_tail) {
+    TCCR0 = 0;                          // Stop Timer0
+    CLEARBIT(TIMSK, OCIE0);
+    if(lcd_pending) {
+      post_event(ev_lcd, 0);            // The main loop queues the deferred runs
+    } else {
+      lcd_tx_done = true;
+      if(lcd_tx_callback) {
+        lcd_tx_callback();
+      }
+    }
   }
 }
 
+//*************************************************
+// Function Name        : "set_lcd_tx_callback" 
+// Date                 : 10/16/2026
+// Version              : 1.0 
+// Target MCU           : ATMEGA128A 
+// Author               : Wilmer Suarez
+// DESCRIPTION 
+// Sets the function called when the transmit queue
+// has been drained. Pass 0 to remove it.
+//
+// Warnings             : none 
+// Restrictions         : none 
+// Algorithms           : none 
+// References           : none 
+// 
+// Revision History     : Initial version  
+//*************************************************
+
+void set_lcd_tx_callback(void (*callback)(void)) {
+  lcd_tx_callback = callback;
+}
+
+//*************************************************
+// Function Name        : "invalidate_lcd_dog" 
+// Date                 : 10/16/2026
+// Version              : 1.0 
+// Target MCU           : ATMEGA128A 
+// Author               : Wilmer Suarez
+// DESCRIPTION 
+// Sets the shadow DDRAM to the blank display left
+// by the Clear Display command. Any non-space 
+// character in the display buffers is resent on
+// the next update.
+//
+// Warnings             : none 
+// Restrictions         : none 
+// Algorithms           : none 
+// References           : none 
+// 
+// Revision History     : Initial version  
+//*************************************************
+
+void invalidate_lcd_dog() {
+  for(char i = 0; i < LCD_CHARS; i++)
+    lcd_shadow[i] = ' ';
+}
+
 //*************************************************
 // Function Name        : "lcd_spi_transmit_DATA" 
 // Date                 : 02/24/2018
@@ -258,26 +489,16 @@ void update_lcd_dog() {
 // data to be written by SPI port before continuing.
 //
 // Warnings             : none 
-// Restrictions         : none 
+// Restrictions         : The LCD must own the SPI bus
 // Algorithms           : none 
 // References           : none 
 // 
 // Revision History     : Initial version  
+//                        10/16/2026 - /SS and SPI mode
+//                        handled by spi_bus.c
 //*************************************************
 
 void lcd_spi_transmit_DATA(char data) {
   SETBIT(PORTB, RS);            // RS = 1 = data
-  CLEARBIT(PORTB, SS_bar);      // /SS = slave selected
-
-  SPDR = data;                  // Write data to SPI port
-
-  // Wait for transmission complete
-  while(!(SPSR & (1 << SPIF)));
-  
-  // Clear SPIF 
-  TESTBIT(SPSR, SPIF);        
-  TESTBIT(SPDR, 0);
-    
-  // De-select slave
-  SETBIT(PORTB, SS_bar);
+  spi_transfer(data);           // Write data to SPI port
 }
\ No newline at end of file
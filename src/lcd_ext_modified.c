@@ -12,6 +12,10 @@
  into the display buffer at the position corresponding to the value of
  variable index. This putchar function replaces the standard putchar funtion,
  so a printf statement will print to the LCD.  
+ 
+ The lcd_put functions are a small replacement for printf on the refresh 
+ path. They write zero-padded integers, fixed-point decimals, and 00->99 
+ clock fields through putchar, without the printf library or floats.
 ****************************************************************************/
 #include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
 #include "lcd.h"
@@ -23,9 +27,28 @@ void formFeed();
 void newline();
 void carriageReturn();
 void charPut();
+void lcd_puts(const char *str);
+void lcd_put_uint(unsigned int value, unsigned char width);
+void lcd_put_fixed(int value, unsigned char decimals);
+void lcd_put_2digits(unsigned char value);
 
 static char index;    // index into display buffer
 
+// ASCII pairs for 00->99, used by lcd_put_2digits
+static const char two_digits[] = "00010203040506070809"
+                                 "10111213141516171819"
+                                 "20212223242526272829"
+                                 "30313233343536373839"
+                                 "40414243444546474849"
+                                 "50515253545556575859"
+                                 "60616263646566676869"
+                                 "70717273747576777879"
+                                 "80818283848586878889"
+                                 "90919293949596979899";
+
+// Divisor for each number of decimal places of lcd_put_fixed
+static const unsigned int pow10[5] = {1, 10, 100, 1000, 10000};
+
 /***********************************************************************
  Function             : int putchar(int c)
  Date                 : 02/18/2018
@@ -167,4 +190,98 @@ void charPut(int c) {
     dsp_buff_1[index++] = (char)c;
   }
 }
-  
\ No newline at end of file
+
+/***********************************************
+ Function             : void lcd_puts(const char *str)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Puts a string through putchar, so the escape 
+ sequences are handled.
+***********************************************/
+void lcd_puts(const char *str) {
+  while(*str) {
+    putchar(*str++);
+  }
+}
+
+/****************************************************
+ Function             : void lcd_put_uint(unsigned int value, 
+                        unsigned char width)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Puts an unsigned integer, padded with leading zeros
+ to at least width digits (same as printf "%0*u").
+****************************************************/
+void lcd_put_uint(unsigned int value, unsigned char width) {
+  char digits[5];               // 65535 has 5 digits
+  unsigned char count = 0;
+  
+  do {
+    digits[count++] = '0' + (value % 10);
+    value /= 10;
+  } while(value != 0);
+  
+  while(width > count) {        // Leading zeros
+    putchar('0');
+    width--;
+  }
+  
+  while(count != 0) {
+    putchar(digits[--count]);
+  }
+}
+
+/****************************************************
+ Function             : void lcd_put_fixed(int value, 
+                        unsigned char decimals)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Puts a fixed-point value that is scaled by 10^decimals,
+ e.g. 2345 with 2 decimals (0.01 units, as returned by 
+ compute_scaled_rh) is put as "23.45". decimals must be
+ 4 or less.
+****************************************************/
+void lcd_put_fixed(int value, unsigned char decimals) {
+  unsigned int magnitude = value;
+  
+  if(value < 0) {
+    putchar('-');
+    magnitude = -magnitude;
+  }
+  
+  lcd_put_uint(magnitude / pow10[decimals], 1);
+  if(decimals != 0) {
+    putchar('.');
+    lcd_put_uint(magnitude % pow10[decimals], decimals);
+  }
+}
+
+/****************************************************
+ Function             : void lcd_put_2digits(unsigned char value)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Puts a 00->99 value as two digits with a table lookup
+ (no division). Used for the clock fields. A value
+ above 99 is put as "--".
+****************************************************/
+void lcd_put_2digits(unsigned char value) {
+  const char *pair = &two_digits[value << 1];
+  
+  if(value > 99) {
+    pair = "--";                        // Past the end of the table
+  }
+  putchar(pair[0]);
+  putchar(pair[1]);
+}
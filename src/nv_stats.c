@@ -0,0 +1,271 @@
+/******************************************************************
+ File Name            : "nv_stats.c"
+ Title                : Persistent Statistics in the DS1306 User RAM
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The DS1306 has 96 bytes of battery-backed user RAM (read 0x20->0x7F,
+ write 0xA0->0xFF). This module keeps a 32 byte block there with the
+ minimum, maximum, and sum of the raw Humidicon and CO2 codes of the
+ current day, the number of samples, and the tempCF setting. The 
+ block ends with a CRC-8 (Dallas/Maxim) so a corrupt block is 
+ detected at boot and reset to defaults.
+ 
+ The block is kept in MCU RAM and a copy of what was last written is
+ kept too. A flush compares them and sends each run of changed bytes
+ in its own block_write_RTC burst. Fields are ordered from the least
+ to the most often changed: settings, minimums and maximums, sums, 
+ sample count, and CRC. A flush after a minute of samples usually 
+ only sends the low bytes of the sums, the count, and the CRC.
+ Samples are added every tick but only flushed every NV_FLUSH_TICKS
+ ticks, so most ticks cost no SPI transfer at all. Settings are 
+ flushed at once.
+ 
+ The stats are reset when a sample is added and the date of the 
+ software clock differs from the date in the block, so a sample of
+ the new day is never added to the previous day.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include <stddef.h>
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "DS1306.h"
+#include "history.h"
+#include "clock.h"
+#include "nv_stats.h"
+
+#define NV_READ_ADDR    0x20        // First user RAM address (read)
+#define NV_WRITE_ADDR   0xA0        // First user RAM address (write)
+#define NV_MAGIC        0x5C        // Layout version
+#define NV_FLUSH_TICKS  60          // Samples are written once a minute
+#define NV_RUN_GAP      1           // Unchanged bytes bridged inside a run. A new run
+                                    // costs one address byte, so resending a 1 byte gap costs no more.
+
+// Daily extremes of one channel
+typedef struct {
+  unsigned int min;
+  unsigned int max;
+} nv_range;
+
+// Layout of the user RAM block. The AVR has no alignment padding.
+// Fields that change on every sample are at the end, next to the CRC.
+typedef struct {
+  unsigned char magic;
+  unsigned char date;               // Day of month of the statistics
+  unsigned char tempCF;
+  nv_range range[hist_channels];
+  unsigned long sum[hist_channels];
+  unsigned long count;              // Samples in the day
+  unsigned char crc;                // CRC-8 of all the bytes above
+} nv_block;
+
+#define NV_SIZE     (offsetof(nv_block, crc) + 1)     // Without trailing padding (none on the AVR)
+
+// ----- Module state ----- //
+static nv_block nv_data;            // Current block
+static nv_block nv_written;         // Block as it is in the DS1306
+static unsigned char nv_ticks;      // Samples since the last flush
+unsigned int nv_bytes_written;
+unsigned int nv_recoveries;
+
+// ----- Local Function Prototypes ----- //
+static unsigned char nv_crc(const unsigned char *data, unsigned char count);
+static void nv_reset(unsigned char date, bool celcius);
+static void nv_flush();
+
+/*************************************************************
+ Function             : void nv_stats_init()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Reads the block with one burst. If the magic byte or the
+ CRC is wrong the block is reset to defaults (Celcius, no
+ samples) and written back. Otherwise tempCF is restored.
+*************************************************************/
+void nv_stats_init() {
+  unsigned char *bytes = (unsigned char *)&nv_data;
+  
+  block_read_RTC((volatile unsigned char *)bytes, NV_READ_ADDR, NV_SIZE);
+  nv_written = nv_data;
+  
+  if((nv_data.magic != NV_MAGIC) || (nv_crc(bytes, NV_SIZE - 1) != nv_data.crc)) {
+    nv_recoveries++;
+    nv_reset(clock_now()->date, true);
+    nv_written.magic = ~NV_MAGIC;   // Write the whole block
+    nv_flush();
+  }
+  
+  tempCF = nv_data.tempCF;
+}
+
+/*************************************************************
+ Function             : void nv_stats_add(unsigned int rh_raw,
+                        unsigned int temp_raw, 
+                        unsigned int co2_counts)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Starts a new day if the date of the software clock 
+ changed, then adds the sample to the daily statistics.
+ Every NV_FLUSH_TICKS samples the changes are flushed.
+*************************************************************/
+void nv_stats_add(unsigned int rh_raw, unsigned int temp_raw, unsigned int co2_counts) {
+  unsigned int values[hist_channels];
+  unsigned char date = clock_now()->date;
+  nv_range *r;
+  
+  // ----- New day ----- //
+  if(date != nv_data.date) {
+    nv_reset(date, nv_data.tempCF);
+  }
+  
+  values[hist_rh] = rh_raw;
+  values[hist_temp] = temp_raw;
+  values[hist_co2] = co2_counts;
+  
+  for(unsigned char ch = 0; ch < hist_channels; ch++) {
+    r = &nv_data.range[ch];
+    if((nv_data.count == 0) || (values[ch] < r->min)) {
+      r->min = values[ch];
+    }
+    if((nv_data.count == 0) || (values[ch] > r->max)) {
+      r->max = values[ch];
+    }
+    nv_data.sum[ch] += values[ch];
+  }
+  nv_data.count++;
+  
+  if(++nv_ticks >= NV_FLUSH_TICKS) {
+    nv_flush();
+  }
+}
+
+/*************************************************************
+ Function             : void nv_stats_set_tempCF(bool celcius)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Saves the temperature unit setting at once.
+*************************************************************/
+void nv_stats_set_tempCF(bool celcius) {
+  nv_data.tempCF = celcius;
+  nv_flush();
+}
+
+/*************************************************************
+ Function             : bool nv_stats_daily(hist_channel ch,
+                        unsigned int *min, unsigned int *max,
+                        unsigned int *avg)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the minimum, maximum, and average raw code of a
+ channel for the current day. False if there are no 
+ samples yet.
+*************************************************************/
+bool nv_stats_daily(hist_channel ch, unsigned int *min, unsigned int *max, unsigned int *avg) {
+  if(nv_data.count == 0) {
+    return false;
+  }
+  
+  *min = nv_data.range[ch].min;
+  *max = nv_data.range[ch].max;
+  *avg = nv_data.sum[ch] / nv_data.count;
+  return true;
+}
+
+/*************************************************************
+ Function             : static void nv_reset(unsigned char date,
+                        bool celcius)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Clears the daily statistics of the block in MCU RAM.
+*************************************************************/
+static void nv_reset(unsigned char date, bool celcius) {
+  unsigned char *bytes = (unsigned char *)&nv_data;
+  
+  for(unsigned char i = 0; i < NV_SIZE; i++) {
+    bytes[i] = 0;
+  }
+  nv_data.magic = NV_MAGIC;
+  nv_data.date = date;
+  nv_data.tempCF = celcius;
+}
+
+/*************************************************************
+ Function             : static void nv_flush()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Updates the CRC and writes each run of bytes that 
+ differ from nv_written in its own burst. Runs separated
+ by NV_RUN_GAP or fewer unchanged bytes are merged.
+*************************************************************/
+static void nv_flush() {
+  unsigned char *bytes = (unsigned char *)&nv_data;
+  unsigned char *old = (unsigned char *)&nv_written;
+  unsigned char i = 0, j, last;     // Start, scan, and last changed byte of a run
+  
+  nv_ticks = 0;
+  nv_data.crc = nv_crc(bytes, NV_SIZE - 1);
+  
+  while(i < NV_SIZE) {
+    // Skip bytes the DS1306 already holds
+    if(bytes[i] == old[i]) {
+      i++;
+      continue;
+    }
+    
+    // Find the end of the run starting at i
+    last = i;
+    for(j = i + 1; (j < NV_SIZE) && (j <= last + NV_RUN_GAP + 1); j++) {
+      if(bytes[j] != old[j]) {
+        last = j;
+      }
+    }
+    
+    block_write_RTC((volatile unsigned char *)&bytes[i], NV_WRITE_ADDR + i, last - i + 1);
+    nv_bytes_written += last - i + 2;
+    i = last + 1;
+  }
+  
+  nv_written = nv_data;
+}
+
+/*************************************************************
+ Function             : static unsigned char nv_crc(
+                        const unsigned char *data, 
+                        unsigned char count)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Computes the Dallas/Maxim CRC-8 (x^8 + x^5 + x^4 + 1).
+*************************************************************/
+static unsigned char nv_crc(const unsigned char *data, unsigned char count) {
+  unsigned char crc = 0;
+  
+  while(count--) {
+    crc ^= *data++;
+    for(unsigned char bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x01) ? ((crc >> 1) ^ 0x8C) : (crc >> 1);
+    }
+  }
+  return crc;
+}
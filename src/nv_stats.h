@@ -0,0 +1,23 @@
+/****************************************************************
+  File Name            : "nv_stats.h" 
+  Title                : Persistent Statistics Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the external functions used to 
+  keep the daily statistics and the user settings in the 
+  battery-backed user RAM of the DS1306.
+  header.h and history.h must be included first.
+****************************************************************/ 
+
+// ------- External Functions for the Persistent Statistics ------- //
+extern void nv_stats_init();                    // Restore (or reset if corrupt) at boot
+extern void nv_stats_add(unsigned int rh_raw, unsigned int temp_raw, unsigned int co2_counts);
+extern void nv_stats_set_tempCF(bool celcius);  // Saved at once
+extern bool nv_stats_daily(hist_channel ch, unsigned int *min, unsigned int *max, unsigned int *avg);
+
+// ------- Counters ------- //
+extern unsigned int nv_bytes_written;           // Bytes sent to the DS1306 user RAM (with addresses)
+extern unsigned int nv_recoveries;              // Times the user RAM was found corrupt at boot
@@ -0,0 +1,97 @@
+/******************************************************************
+ File Name            : "power.c"
+ Title                : Sleep Manager
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ When the event queue is empty the main loop sleeps until the next
+ interrupt. The deepest safe mode is chosen from the pending work:
+ - Idle while a timer clocked by the I/O clock is busy (LCD
+   transmit Timer0, Humidicon conversion Timer1, timeouts Timer2),
+   an EEPROM log record is being written (EE_READY cannot wake 
+   from Power-down), or USART0 is sending telemetry.
+ - ADC Noise Reduction while only a CO2 ADC burst is running. 
+   The I/O clock is halted so the conversions are quieter.
+ - Power-down otherwise. INT0 (keypad) and INT1->INT3 (DS1306 
+   1Hz output and alarms) wake the CPU.
+ 
+ Timer3 (fosc/8) runs while awake and in Idle mode but stops in 
+ ADC Noise Reduction and Power-down, so it is used to record how 
+ long the CPU was awake and idle. A single stretch longer than 32.7ms wraps around.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "events.h"
+#include "power.h"
+#include "telemetry.h"
+
+// MCUCR sleep bits
+#define SLEEP_MODE_MASK     ((1 << SE) | (1 << SM2) | (1 << SM1) | (1 << SM0))
+#define SLEEP_IDLE          (1 << SE)
+#define SLEEP_ADC_NOISE     ((1 << SE) | (1 << SM0))
+#define SLEEP_POWER_DOWN    ((1 << SE) | (1 << SM1))
+
+// ----- Awake time accounting ----- //
+unsigned long awake_counts;         // Time spent running
+unsigned long idle_counts;          // Time spent in Idle mode
+unsigned int idle_entries;          // Times Idle mode was entered
+unsigned int adc_noise_entries;     // Times ADC Noise Reduction mode was entered
+unsigned int powerdown_entries;     // Times Power-down mode was entered
+static unsigned int wake_stamp;     // Timer3 count when the CPU last woke up
+
+/*************************************************************
+ Function             : void sleep_until_event()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Puts the CPU to sleep unless an event is already queued. 
+ The queue is checked with interrupts disabled, and SLEEP
+ is the instruction right after SEI, so an event posted 
+ after the check always wakes the CPU up.
+*************************************************************/
+void sleep_until_event() {
+  unsigned int now;
+  bool idle;
+  
+  __disable_interrupt();
+  if(events_pending()) {
+    __enable_interrupt();
+    return;
+  }
+  
+  // ----- Time awake since the last wake up ----- //
+  now = TCNT3;
+  awake_counts += (unsigned int)(now - wake_stamp);
+  
+  // ----- Pick the deepest safe sleep mode ----- //
+  idle = TESTBIT(TIMSK, OCIE0) || TESTBIT(TIMSK, OCIE1A) || TESTBIT(TIMSK, OCIE2) || 
+         TESTBIT(EECR, EERIE) || telemetry_busy();
+  if(idle) {
+    MCUCR = (MCUCR & ~SLEEP_MODE_MASK) | SLEEP_IDLE;
+    idle_entries++;
+  } else if(TESTBIT(ADCSRA, ADEN)) {
+    MCUCR = (MCUCR & ~SLEEP_MODE_MASK) | SLEEP_ADC_NOISE;
+    adc_noise_entries++;
+  } else {
+    MCUCR = (MCUCR & ~SLEEP_MODE_MASK) | SLEEP_POWER_DOWN;
+    powerdown_entries++;
+  }
+  
+  __enable_interrupt();
+  __sleep();
+  
+  // ----- Woken up by an interrupt ----- //
+  __disable_interrupt();
+  CLEARBIT(MCUCR, SE);
+  wake_stamp = TCNT3;               // Shared TEMP register, read with interrupts off
+  __enable_interrupt();
+  
+  if(idle) {
+    idle_counts += (unsigned int)(wake_stamp - now);
+  }
+}
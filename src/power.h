@@ -0,0 +1,22 @@
+/****************************************************************
+  File Name            : "power.h" 
+  Title                : Sleep Manager Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the external function used by the
+  main loop to sleep until the next event, and the counters 
+  that record how long the CPU was awake.
+****************************************************************/ 
+
+// ------- External Functions for the Sleep Manager ------- //
+extern void sleep_until_event();
+
+// ------- Awake time accounting (Timer3 counts, 0.5us each) ------- //
+extern unsigned long awake_counts;          // Time spent running
+extern unsigned long idle_counts;           // Time spent in Idle mode
+extern unsigned int idle_entries;           // Times Idle mode was entered
+extern unsigned int adc_noise_entries;      // Times ADC Noise Reduction mode was entered
+extern unsigned int powerdown_entries;      // Times Power-down mode was entered
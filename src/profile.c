@@ -0,0 +1,162 @@
+/******************************************************************
+ File Name            : "profile.c"
+ Title                : Cycle Profiler
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Keeps the minimum, maximum, total, and count of the time spent 
+ between the PROF_ENTER and PROF_EXIT probes of each prof_probe.
+ The time base is the free-running Timer3 started by init_events
+ (fosc/8, 0.5us or 8 cycles per count). Timer3 stops in ADC Noise
+ Reduction and Power-down, so probes must not span a sleep.
+ 
+ The overhead of an empty probe pair is measured once by prof_init
+ and taken off every sample. The accumulators are updated with 
+ interrupts disabled since the probes are used in ISRs and in the
+ main loop.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "profile.h"
+
+// ----- Accumulators ----- //
+static prof_stats prof_table[prof_count];
+unsigned int prof_overhead;
+
+// Probe names for the diagnostics screen (16 characters or less)
+static const char * const prof_names[prof_count] = {
+  "Tick ISR",
+  "Key ISR",
+  "Key scan",
+  "Display time",
+  "Humidicon fetch",
+  "LCD update",
+  "RTC block read"
+};
+
+/*************************************************************
+ Function             : void prof_init()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Measures the counts of an empty probe pair and clears the
+ accumulators. Called after init_events has started 
+ Timer3.
+*************************************************************/
+void prof_init() {
+  unsigned int start;
+  
+  prof_overhead = 0;
+  start = prof_now();
+  prof_overhead = prof_now() - start;
+  prof_clear();
+}
+
+/*************************************************************
+ Function             : unsigned int prof_now()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Reads Timer3. Interrupts are disabled during the read 
+ since ISRs also use the shared 16-bit TEMP register.
+*************************************************************/
+unsigned int prof_now() {
+  unsigned char sreg = __save_interrupt();
+  unsigned int now;
+  
+  __disable_interrupt();
+  now = TCNT3;
+  __restore_interrupt(sreg);
+  return now;
+}
+
+/*************************************************************
+ Function             : void prof_record(prof_probe p, 
+                        unsigned int counts)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Adds one sample to the accumulators of a probe. The 
+ overhead of the probe pair is subtracted first.
+*************************************************************/
+void prof_record(prof_probe p, unsigned int counts) {
+  unsigned char sreg = __save_interrupt();
+  prof_stats *s = &prof_table[p];
+  
+  counts = (counts > prof_overhead) ? (counts - prof_overhead) : 0;
+  
+  __disable_interrupt();
+  if((s->count == 0) || (counts < s->min)) {
+    s->min = counts;
+  }
+  if(counts > s->max) {
+    s->max = counts;
+  }
+  s->total += counts;
+  if(++s->count == 0) {
+    s->count--;                     // Saturate
+    s->total -= counts;
+  }
+  __restore_interrupt(sreg);
+}
+
+/*************************************************************
+ Function             : void prof_read(prof_probe p, 
+                        prof_stats *stats)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Copies the accumulators of a probe with interrupts 
+ disabled so they are consistent.
+*************************************************************/
+void prof_read(prof_probe p, prof_stats *stats) {
+  __disable_interrupt();
+  *stats = prof_table[p];
+  __enable_interrupt();
+}
+
+/*************************************************************
+ Function             : void prof_clear()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Clears the accumulators of all the probes.
+*************************************************************/
+void prof_clear() {
+  unsigned char sreg = __save_interrupt();
+  
+  __disable_interrupt();
+  for(unsigned char p = 0; p < prof_count; p++) {
+    prof_table[p].min = 0;
+    prof_table[p].max = 0;
+    prof_table[p].total = 0;
+    prof_table[p].count = 0;
+  }
+  __restore_interrupt(sreg);
+}
+
+/*************************************************************
+ Function             : const char *prof_name(prof_probe p)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Returns the display name of a probe.
+*************************************************************/
+const char *prof_name(prof_probe p) {
+  return prof_names[p];
+}
@@ -0,0 +1,56 @@
+/****************************************************************
+  File Name            : "profile.h" 
+  Title                : Cycle Profiler Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the profiler probes and the enter/
+  exit macros. Set PROFILE_ENABLE to 0 to remove the probes
+  completely. header.h must be included first.
+****************************************************************/ 
+
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE  1
+#endif
+
+// ---------- Probes ---------- //
+typedef enum {
+  prof_tick_ISR,            // display_time_ISR
+  prof_key_ISR,             // ISR_INT0
+  prof_key_scan,            // keypad_tick (Timer2 ISR)
+  prof_display_time,        // display_time (tick handler)
+  prof_fetch_humidicon,     // fetch_humidicon
+  prof_update_lcd,          // update_lcd_dog
+  prof_rtc_block_read,      // block_read_RTC
+  prof_count
+} prof_probe;
+
+// Accumulated times of one probe, in Timer3 counts (0.5us)
+typedef struct {
+  unsigned int min;
+  unsigned int max;
+  unsigned long total;
+  unsigned int count;
+} prof_stats;
+
+// ------- Enter/exit probes ------- //
+// A probe pair times the code between them with Timer3. The time of
+// any interrupt serviced in between is included.
+#if PROFILE_ENABLE
+#define PROF_ENTER(p)   unsigned int prof_start_##p = prof_now()
+#define PROF_EXIT(p)    prof_record(p, prof_now() - prof_start_##p)
+#else
+#define PROF_ENTER(p)
+#define PROF_EXIT(p)
+#endif
+
+// ------- External Functions for the Profiler ------- //
+extern void prof_init();                        // Measures the probe overhead
+extern unsigned int prof_now();
+extern void prof_record(prof_probe p, unsigned int counts);
+extern void prof_read(prof_probe p, prof_stats *stats);
+extern void prof_clear();
+extern const char *prof_name(prof_probe p);
+extern unsigned int prof_overhead;              // Counts of an empty probe pair
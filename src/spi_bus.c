@@ -0,0 +1,161 @@
+/******************************************************************
+ File Name            : "spi_bus.c"
+ Title                : Shared SPI Bus Manager
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The Humidicon, the DS1306 RTC, and the DOG LCD share the SPI port
+ with different modes and clock rates. This module owns the SPI 
+ registers and the three chip selects. A driver calls spi_begin()
+ before a transaction and spi_end() after it. SPCR/SPSR are only 
+ written when the device differs from the one last configured, and
+ only one device can own the bus at a time.
+ 
+ Device     Mode   SCLK               Chip Select
+ Humidicon  0      fosc/32 = 500kHz   one per sensor, humidicon.c
+ DS1306     3      fosc/8  = 2MHz     PA1, active high
+ DOG LCD    3      fosc/8  = 2MHz     PB0, active low
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "spi_bus.h"
+
+// A structure spi_config holds the register values and chip select 
+// of one device on the bus.
+typedef struct {
+  unsigned char spcr;
+  unsigned char spsr;
+  volatile unsigned char *cs_port;          // 0: selected by the driver
+  unsigned char cs_pin;
+  bool cs_active_high;
+} spi_config;
+
+// Configuration for each device, indexed by spi_device
+#define SPI_MODE0   ((1 << SPE) | (1 << MSTR))
+#define SPI_MODE3   ((1 << SPE) | (1 << MSTR) | (1 << CPOL) | (1 << CPHA))
+
+static const spi_config spi_configs[3] = {
+//  SPCR                         SPSR           CS PORT  PIN  ACTIVE HIGH
+    {SPI_MODE0 | (1 << SPR1),    (1 << SPI2X),  0,       0,   false},   // Humidicon (max 800kHz)
+    {SPI_MODE3 | (1 << SPR0),    (1 << SPI2X),  &PORTA,  1,   true},    // DS1306 (max 2MHz)
+    {SPI_MODE3 | (1 << SPR0),    (1 << SPI2X),  &PORTB,  0,   false}    // DOG LCD
+};
+
+// ----- Bus state ----- //
+static volatile spi_device spi_owner = spi_none;    // Device that owns the bus
+static spi_device spi_active = spi_none;            // Device the SPI registers are configured for
+volatile unsigned int spi_reconfig_count;           // Register rewrites for a different device
+
+/*************************************************************
+ Function             : bool spi_try_begin(spi_device dev)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Takes the bus for dev if it is free, configures SPCR/SPSR
+ if another device was configured last, and asserts the 
+ chip select of dev. Returns false without touching the bus
+ if it is already owned. A device without a chip select in 
+ spi_configs (the Humidicons) is selected by its driver.
+*************************************************************/
+bool spi_try_begin(spi_device dev) {
+  const spi_config *cfg = &spi_configs[dev];
+  unsigned char sreg = __save_interrupt();
+  
+  // --- Take ownership of the bus --- //
+  __disable_interrupt();
+  if(spi_owner != spi_none) {
+    __restore_interrupt(sreg);
+    return false;
+  }
+  spi_owner = dev;
+  __restore_interrupt(sreg);
+  
+  // --- Configure the SPI registers only if needed --- //
+  if(spi_active != dev) {
+    SPCR = cfg->spcr;
+    SPSR = cfg->spsr;
+    
+    // Clear SPIF in SPSR //
+    TESTBIT(SPSR, SPIF);
+    TESTBIT(SPDR, 0);
+    
+    spi_active = dev;
+    spi_reconfig_count++;
+  }
+  
+  // --- Select the device --- //
+  if(cfg->cs_port == 0) {
+    // Selected by the driver
+  } else if(cfg->cs_active_high) {
+    SETBIT(*cfg->cs_port, cfg->cs_pin);
+  } else {
+    CLEARBIT(*cfg->cs_port, cfg->cs_pin);
+  }
+  
+  return true;
+}
+
+/*************************************************************
+ Function             : void spi_begin(spi_device dev)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Waits until the bus is free and takes it for dev.
+ Interrupts always release the bus before returning, so 
+ this must not be called from an interrupt that can 
+ preempt code owning the bus. Such interrupts use 
+ spi_try_begin().
+*************************************************************/
+void spi_begin(spi_device dev) {
+  while(!spi_try_begin(dev));
+}
+
+/*************************************************************
+ Function             : void spi_end(spi_device dev)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ De-asserts the chip select of dev and releases the bus.
+*************************************************************/
+void spi_end(spi_device dev) {
+  const spi_config *cfg = &spi_configs[dev];
+  
+  // --- De-select the device --- //
+  if(cfg->cs_port == 0) {
+    // De-selected by the driver
+  } else if(cfg->cs_active_high) {
+    CLEARBIT(*cfg->cs_port, cfg->cs_pin);
+  } else {
+    SETBIT(*cfg->cs_port, cfg->cs_pin);
+  }
+  
+  spi_owner = spi_none;
+}
+
+/*************************************************************
+ Function             : unsigned char spi_transfer(unsigned char data)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sends data and returns the byte shifted in at the same 
+ time. Reading SPSR then SPDR clears SPIF.
+*************************************************************/
+unsigned char spi_transfer(unsigned char data) {
+  SPDR = data;
+  
+  // --- Wait for transfer complete --- //
+  while(!(SPSR & (1 << SPIF))) {}
+  
+  return SPDR;
+}
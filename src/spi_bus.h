@@ -0,0 +1,25 @@
+/****************************************************************
+  File Name            : "spi_bus.h" 
+  Title                : SPI Bus Manager Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the devices sharing the SPI port
+  and the external functions used to own the bus, select a
+  device, and transfer bytes.
+  header.h must be included first.
+****************************************************************/ 
+
+// ------- Devices on the SPI bus ------- //
+typedef enum {spi_humidicon, spi_rtc, spi_lcd, spi_none} spi_device;
+
+// ------- External Functions for the SPI Bus ------- //
+extern bool spi_try_begin(spi_device dev);     // Own the bus and select dev, false if the bus is busy
+extern void spi_begin(spi_device dev);         // Waits for the bus. Not for ISRs that can preempt an owner
+extern void spi_end(spi_device dev);           // De-select dev and release the bus
+extern unsigned char spi_transfer(unsigned char data);   // Send a byte and return the byte received
+
+// Number of times SPCR/SPSR had to be rewritten for a different device
+extern volatile unsigned int spi_reconfig_count;
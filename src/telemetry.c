@@ -0,0 +1,256 @@
+/******************************************************************
+ File Name            : "telemetry.c"
+ Title                : UART Telemetry Stream
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sends a binary frame with the raw sensor readings on USART0 (TXD0, 
+ PE1) every telemetry_period ticks. The frame layout is in 
+ telemetry.h.
+ 
+ Frames are copied to a transmit ring and sent by the USART0 data
+ register empty interrupt, so queuing a frame costs only the copy
+ and the CRC and never waits for the UART. A frame that does not fit
+ in the ring is dropped whole and flagged in the next frame.
+ 
+ 115200 baud is set with U2X (UBRR = 16), 2.1% fast at 16MHz. A 
+ frame takes 1.3ms on the line.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "humidicon.h"
+#include "co2.h"
+#include "telemetry.h"
+
+#define TELEM_UBRR          16      // 115200 baud with U2X at 16MHz
+#define TELEM_RING_SIZE     64      // Must be a power of 2, 256 or less
+#define TELEM_RING_MASK     (TELEM_RING_SIZE - 1)
+
+// ----- Transmit ring ----- //
+static unsigned char telem_ring[TELEM_RING_SIZE];
+static volatile unsigned char telem_head;       // Next free entry (main loop)
+static volatile unsigned char telem_tail;       // Next byte to send (ISR)
+
+static unsigned char telemetry_period = 1;      // Ticks between frames, 0 = off
+static unsigned char telem_ticks;
+static unsigned char telem_seq;
+static bool telem_lost;                         // A frame was dropped since the last one queued
+
+unsigned int telemetry_frames;
+unsigned int telemetry_dropped;
+
+// ----- Local Function Prototypes ----- //
+static void telem_put(unsigned char data, unsigned int *crc);
+static unsigned int crc16_ccitt(unsigned int crc, unsigned char data);
+
+/*************************************************************
+ Function             : void init_telemetry()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Configures USART0 for 115200 baud, 8 data bits, no parity,
+ 1 stop bit, transmitter only.
+*************************************************************/
+void init_telemetry() {
+  UBRR0H = 0;
+  UBRR0L = TELEM_UBRR;
+  UCSR0A = (1 << U2X0);
+  UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);       // 8N1
+  UCSR0B = (1 << TXEN0);                        // UDRIE0 is set while the ring has data
+}
+
+/*************************************************************
+ Function             : void telemetry_set_period(
+                        unsigned char ticks)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the number of ticks between frames. 0 stops the
+ stream.
+*************************************************************/
+void telemetry_set_period(unsigned char ticks) {
+  telemetry_period = ticks;
+  telem_ticks = 0;
+}
+
+/*************************************************************
+ Function             : void telemetry_tick(unsigned int stamp,
+                        unsigned int rh_raw, 
+                        unsigned int temp_raw)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Called on every tick. Every telemetry_period ticks a
+ frame is built and queued with the CO2 status and the
+ Humidicon status. The frame is dropped if the ring does
+ not have room for all of it.
+*************************************************************/
+void telemetry_tick(unsigned int stamp, unsigned int rh_raw, unsigned int temp_raw) {
+  unsigned int co2, ppm, crc = 0xFFFF;
+  unsigned char flags = 0;
+  
+  if((telemetry_period == 0) || (++telem_ticks < telemetry_period)) {
+    return;
+  }
+  telem_ticks = 0;
+  
+  // ----- Room for the whole frame? ----- //
+  if(((telem_tail - telem_head - 1) & TELEM_RING_MASK) < TELEM_FRAME_SIZE) {
+    telemetry_dropped++;
+    telem_lost = true;
+    return;
+  }
+  
+  // ----- Status flags ----- //
+  if(humidicon_status != 0) {
+    flags |= TELEM_RH_STALE;
+  }
+  if(!co2_read(&co2)) {
+    flags |= TELEM_CO2_NONE;
+  } else {
+    switch(co2_convert(co2, &ppm)) {
+      case co2_preheating:
+        flags |= TELEM_CO2_PREHEAT;
+        break;
+      case co2_fault:
+        flags |= TELEM_CO2_FAULT;
+        break;
+      case co2_valid:
+        break;
+    }
+  }
+  if(telem_lost) {
+    flags |= TELEM_DROPPED;
+    telem_lost = false;
+  }
+  
+  // ----- Queue the frame ----- //
+  telem_put(TELEM_SYNC1, 0);
+  telem_put(TELEM_SYNC2, 0);
+  telem_put(TELEM_PAYLOAD, &crc);
+  telem_put(telem_seq++, &crc);
+  telem_put(stamp, &crc);
+  telem_put(stamp >> 8, &crc);
+  telem_put(rh_raw, &crc);
+  telem_put(rh_raw >> 8, &crc);
+  telem_put(temp_raw, &crc);
+  telem_put(temp_raw >> 8, &crc);
+  telem_put(co2, &crc);
+  telem_put(co2 >> 8, &crc);
+  telem_put(flags, &crc);
+  telem_put(crc, 0);
+  telem_put(crc >> 8, 0);
+  telemetry_frames++;
+  
+  // ----- Start sending ----- //
+  __disable_interrupt();
+  CLEARBIT(UCSR0B, TXCIE0);
+  SETBIT(UCSR0B, UDRIE0);
+  __enable_interrupt();
+}
+
+/*************************************************************
+ Function             : void telemetry_ISR()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ USART0 data register empty interrupt. Sends the next 
+ byte of the ring. When the ring is empty it disables
+ itself and enables the transmit complete interrupt.
+*************************************************************/
+#pragma vector=USART0_UDRE_vect                 // Vector Location for USART0 Data Register Empty interrupt
+__interrupt void telemetry_ISR() {
+  unsigned char tail = telem_tail;
+  
+  if(tail == telem_head) {
+    CLEARBIT(UCSR0B, UDRIE0);
+    SETBIT(UCSR0B, TXCIE0);                     // Wait for the last byte to leave
+    return;
+  }
+  
+  UCSR0A = (1 << U2X0) | (1 << TXC0);           // Clear TXC0 so it marks the end of this byte
+  UDR0 = telem_ring[tail];
+  telem_tail = (tail + 1) & TELEM_RING_MASK;
+}
+
+/*************************************************************
+ Function             : void telemetry_TXC_ISR()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ USART0 transmit complete interrupt. The last byte has 
+ left the shift register, so the CPU may enter 
+ Power-down again.
+*************************************************************/
+#pragma vector=USART0_TXC_vect                  // Vector Location for USART0 Transmit Complete interrupt
+__interrupt void telemetry_TXC_ISR() {
+  CLEARBIT(UCSR0B, TXCIE0);
+}
+
+/*************************************************************
+ Function             : bool telemetry_busy()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ True until the last byte of the ring has been sent.
+ The sleep manager stays in Idle mode while it is true.
+*************************************************************/
+bool telemetry_busy() {
+  return (UCSR0B & ((1 << UDRIE0) | (1 << TXCIE0))) != 0;
+}
+
+/*************************************************************
+ Function             : static void telem_put(unsigned char
+                        data, unsigned int *crc)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Adds a byte to the ring and to the CRC if crc is not 0.
+ The caller has checked there is room. Only the main loop
+ moves the head, so no interrupt lock is needed.
+*************************************************************/
+static void telem_put(unsigned char data, unsigned int *crc) {
+  unsigned char head = telem_head;
+  
+  telem_ring[head] = data;
+  telem_head = (head + 1) & TELEM_RING_MASK;
+  if(crc) {
+    *crc = crc16_ccitt(*crc, data);
+  }
+}
+
+/*************************************************************
+ Function             : static unsigned int crc16_ccitt(
+                        unsigned int crc, unsigned char data)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Adds a byte to a CRC-16/CCITT (x^16 + x^12 + x^5 + 1),
+ most significant bit first, without a table.
+*************************************************************/
+static unsigned int crc16_ccitt(unsigned int crc, unsigned char data) {
+  crc ^= (unsigned int)data << 8;
+  for(unsigned char bit = 0; bit < 8; bit++) {
+    crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+  }
+  return crc;
+}
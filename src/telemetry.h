@@ -0,0 +1,45 @@
+/****************************************************************
+  File Name            : "telemetry.h" 
+  Title                : UART Telemetry Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the telemetry frame layout and the
+  external functions used to stream the readings on USART0.
+  header.h must be included first.
+  
+  Frame (15 bytes, multi-byte fields little endian):
+  0-1   : sync 0xA5 0x5A
+  2     : payload length (10)
+  3     : sequence number
+  4-5   : time stamp (seconds since reset)
+  6-7   : raw Humidicon humidity code (14 bits)
+  8-9   : raw Humidicon temperature code (14 bits)
+  10-11 : filtered CO2 counts (12 bits, 0.625mV each)
+  12    : status flags (TELEM_xxx)
+  13-14 : CRC-16/CCITT (0x1021, start 0xFFFF) of bytes 2->12
+****************************************************************/ 
+
+#define TELEM_SYNC1         0xA5
+#define TELEM_SYNC2         0x5A
+#define TELEM_PAYLOAD       10
+#define TELEM_FRAME_SIZE    (TELEM_PAYLOAD + 5)
+
+// ---------- Status flags ---------- //
+#define TELEM_RH_STALE      0x01    // Last Humidicon fetch was rejected
+#define TELEM_CO2_PREHEAT   0x02    // CO2 sensor is preheating
+#define TELEM_CO2_FAULT     0x04    // CO2 sensor output is out of range
+#define TELEM_CO2_NONE      0x08    // No CO2 sample yet
+#define TELEM_DROPPED       0x80    // Frames were dropped since the last one sent
+
+// ------- External Functions for the Telemetry ------- //
+extern void init_telemetry();                   // USART0, 115200 baud 8N1
+extern void telemetry_set_period(unsigned char ticks);   // 0 = off
+extern void telemetry_tick(unsigned int stamp, unsigned int rh_raw, unsigned int temp_raw);
+extern bool telemetry_busy();
+
+// ------- Counters ------- //
+extern unsigned int telemetry_frames;           // Frames queued
+extern unsigned int telemetry_dropped;          // Frames dropped because the ring was full
@@ -0,0 +1,156 @@
+/******************************************************************
+ File Name            : "timeout.c"
+ Title                : Software Timeouts
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Timer2 runs in CTC mode at fosc/1024 with OCR2 = 155, so its 
+ compare interrupt comes every 9.98ms. Each timeout is a down 
+ counter of these ticks. When one reaches zero an ev_timeout 
+ event is posted with the timeout id, so the main loop handles 
+ it like any other event.
+ 
+ The same interrupt runs the keypad scan (keypad.c) while a key
+ is down. Timer2 only runs while a timeout is armed or the keypad
+ is scanned. It stops in Power-down, so the sleep manager uses 
+ Idle mode while OCIE2 is set.
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "events.h"
+#include "timeout.h"
+#include "keypad.h"
+
+#define TIMEOUT_OCR     155         // 16MHz / 1024 / 156 = 100.16Hz
+
+static volatile unsigned int timeout_ticks[to_count];   // Ticks left, 0 = not armed
+
+/*************************************************************
+ Function             : void init_timeouts()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets up Timer2 in CTC mode. The timer is started by the
+ first timeout_start.
+*************************************************************/
+void init_timeouts() {
+  TCCR2 = 0;                    // Stopped
+  OCR2 = TIMEOUT_OCR;
+  CLEARBIT(TIMSK, OCIE2);
+}
+
+/*************************************************************
+ Function             : void timeout_start(timeout_id id,
+                        unsigned int ms)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Arms (or re-arms) a timeout. ms is rounded up to the 
+ next 10ms tick. Starts Timer2 if it is stopped.
+*************************************************************/
+void timeout_start(timeout_id id, unsigned int ms) {
+  unsigned int ticks = (ms + TIMEOUT_TICK_MS - 1) / TIMEOUT_TICK_MS;
+  unsigned char sreg = __save_interrupt();
+  
+  __disable_interrupt();
+  timeout_ticks[id] = ticks ? ticks : 1;
+  timeout_run_timer();
+  __restore_interrupt(sreg);
+}
+
+/*************************************************************
+ Function             : void timeout_run_timer()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Starts Timer2 if it is stopped. Also called by ISR_INT0
+ to start the keypad scan.
+*************************************************************/
+void timeout_run_timer() {
+  unsigned char sreg = __save_interrupt();
+  
+  __disable_interrupt();
+  if(!TESTBIT(TIMSK, OCIE2)) {
+    TCNT2 = 0;
+    TIFR = (1 << OCF2);         // Clear a stale compare match
+    TCCR2 = (1 << WGM21) | (1 << CS22) | (1 << CS20);   // CTC, fosc/1024
+    SETBIT(TIMSK, OCIE2);
+  }
+  __restore_interrupt(sreg);
+}
+
+/*************************************************************
+ Function             : void timeout_cancel(timeout_id id)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Disarms a timeout. An ev_timeout already posted for it
+ is not removed, so handlers check timeout_running or 
+ their own state.
+*************************************************************/
+void timeout_cancel(timeout_id id) {
+  __disable_interrupt();
+  timeout_ticks[id] = 0;
+  __enable_interrupt();
+}
+
+/*************************************************************
+ Function             : bool timeout_running(timeout_id id)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ True while a timeout is armed.
+*************************************************************/
+bool timeout_running(timeout_id id) {
+  bool running;
+  
+  __disable_interrupt();
+  running = timeout_ticks[id] != 0;
+  __enable_interrupt();
+  return running;
+}
+
+/*************************************************************
+ Function             : void timeout_ISR()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Timer2 compare interrupt (every 9.98ms). Counts the 
+ armed timeouts down and posts ev_timeout for the ones 
+ that expire, and scans the keypad. Stops Timer2 when 
+ no timeout is armed and the keypad scan is finished.
+*************************************************************/
+#pragma vector=TIMER2_COMP_vect                 // Vector Location for Timer2 compare interrupt
+__interrupt void timeout_ISR() {
+  bool armed = keypad_tick();
+  
+  for(unsigned char id = 0; id < to_count; id++) {
+    if(timeout_ticks[id] != 0) {
+      if(--timeout_ticks[id] == 0) {
+        post_event(ev_timeout, id);
+      } else {
+        armed = true;
+      }
+    }
+  }
+  
+  if(!armed) {
+    TCCR2 = 0;                  // Stop Timer2
+    CLEARBIT(TIMSK, OCIE2);
+  }
+}
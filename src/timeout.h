@@ -0,0 +1,25 @@
+/****************************************************************
+  File Name            : "timeout.h" 
+  Title                : Software Timeouts Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the software timeouts and the
+  external functions used to arm and cancel them. An expired
+  timeout posts an ev_timeout event with its id.
+  header.h must be included first.
+****************************************************************/ 
+
+#define TIMEOUT_TICK_MS     10      // Resolution of the timeouts
+
+// ---------- Timeouts ---------- //
+typedef enum {to_prompt, to_count} timeout_id;
+
+// ------- External Functions for the Timeouts ------- //
+extern void init_timeouts();
+extern void timeout_start(timeout_id id, unsigned int ms);
+extern void timeout_cancel(timeout_id id);
+extern bool timeout_running(timeout_id id);
+extern void timeout_run_timer();                // Keep Timer2 running for the keypad scan
@@ -0,0 +1,341 @@
+/******************************************************************
+ File Name            : "view.c"
+ Title                : Display Page Manager
+ Date                 : 10/16/2026  
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ The sensor and CO2 screens are drawn from a display model (time,
+ Humidicon readings, CO2 sample, temperature unit, alarm levels)
+ instead of by the code that measured the values. The main loop writes the new
+ values into the model and calls view_render() after each event.
+ 
+ A setter only marks the active page dirty when the value differs
+ and is shown on that page, so view_render() costs nothing while 
+ the model is unchanged. A page switch always redraws. While the
+ FSM owns the LCD (page_none) the model is still kept up to date.
+ 
+ Page         Content
+ page_sensor  Time, temperature, and humidity of one Humidicon,
+              first active alarm after the time
+ page_co2     CO2 sensor voltage and concentration, CO2 alarm
+******************************************************************/
+
+// ----- Include Files ----- //
+#include "header.h"     // Includes the ATmega128 Definitions, Macros, and Instinsic functions
+#include "lcd.h"
+#include "humidicon.h"
+#include "co2.h"
+#include "alarm.h"
+#include "view.h"
+
+// A structure view_model holds every value drawn by the pages.
+typedef struct {
+  unsigned char hours;                      // Time, binary 24 hour
+  unsigned char minutes;
+  unsigned char seconds;
+  unsigned int rh[HUMIDICON_COUNT];         // 0.01% RH
+  unsigned int tempC[HUMIDICON_COUNT];      // 0.01 degrees C
+  unsigned int co2_counts;                  // Filtered 12-bit ADC value
+  unsigned int co2_ppm;
+  co2_status co2_state;
+  bool celsius;
+  alarm_level alarms[alarm_channels];
+} view_model;
+
+// Alarm indicator on the sensor page, indexed by alarm_channel
+static const char alarm_letters[alarm_channels] = {'T', 'H', 'C'};
+
+static view_model model = {0, 0, 0, {0}, {0}, 0, 0, co2_preheating, true, {alarm_ok}};
+static view_page view_active = page_none;   // Page on the LCD
+static unsigned char view_sensor;           // Humidicon on the sensor page
+static bool view_dirty;                     // The active page must be drawn again
+unsigned int view_renders;
+
+// ----- Local Function Prototypes ----- //
+static void view_changed(view_page page);
+static void render_sensor_page();
+static void render_co2_page();
+
+/*************************************************************
+ Function             : void view_show(view_page page)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Makes page the active page. A different page is drawn 
+ by the next view_render(), since the LCD was used for
+ something else. page_none hands the LCD to the FSM.
+*************************************************************/
+void view_show(view_page page) {
+  if(page != view_active) {
+    view_active = page;
+    view_dirty = true;
+  }
+}
+
+/*************************************************************
+ Function             : bool view_select_sensor(
+                        unsigned char n)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Shows Humidicon n on the sensor page. Returns false, 
+ and keeps the page, if sensor n is not fitted.
+*************************************************************/
+bool view_select_sensor(unsigned char n) {
+  if(n >= HUMIDICON_COUNT) {
+    return false;
+  }
+  if(n != view_sensor) {
+    view_sensor = n;
+    view_changed(page_sensor);
+  }
+  return true;
+}
+
+/*************************************************************
+ Function             : void view_render()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Draws the active page if the model shown on it changed
+ or the page was switched since the last render. The LCD
+ driver then only sends the characters that differ.
+*************************************************************/
+void view_render() {
+  if(!view_dirty || (view_active == page_none)) {
+    return;
+  }
+  view_dirty = false;
+  
+  switch(view_active) {
+    case page_sensor:
+      render_sensor_page();
+      break;
+    case page_co2:
+      render_co2_page();
+      break;
+    default:
+      return;
+  }
+  update_lcd_dog();
+  view_renders++;
+}
+
+/*************************************************************
+ Function             : void view_set_time(
+                        unsigned char hours, 
+                        unsigned char minutes,
+                        unsigned char seconds)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the time of the model, shown on the sensor page.
+*************************************************************/
+void view_set_time(unsigned char hours, unsigned char minutes, unsigned char seconds) {
+  if((hours != model.hours) || (minutes != model.minutes) || (seconds != model.seconds)) {
+    model.hours = hours;
+    model.minutes = minutes;
+    model.seconds = seconds;
+    view_changed(page_sensor);
+  }
+}
+
+/*************************************************************
+ Function             : void view_set_sensor(
+                        unsigned char n, unsigned int rh,
+                        unsigned int tempC)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the scaled humidity (0.01% RH) and temperature
+ (0.01 degrees C) of Humidicon n. The sensor page is only
+ redrawn if it shows sensor n.
+*************************************************************/
+void view_set_sensor(unsigned char n, unsigned int rh, unsigned int tempC) {
+  if((rh != model.rh[n]) || (tempC != model.tempC[n])) {
+    model.rh[n] = rh;
+    model.tempC[n] = tempC;
+    if(n == view_sensor) {
+      view_changed(page_sensor);
+    }
+  }
+}
+
+/*************************************************************
+ Function             : void view_set_co2(unsigned int counts)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the filtered CO2 sample of the model. It is 
+ converted here so the page also changes when only the
+ sensor status does (end of the preheating time).
+*************************************************************/
+void view_set_co2(unsigned int counts) {
+  unsigned int ppm = 0;
+  co2_status status = co2_convert(counts, &ppm);
+  
+  if((counts != model.co2_counts) || (status != model.co2_state) || (ppm != model.co2_ppm)) {
+    model.co2_counts = counts;
+    model.co2_state = status;
+    model.co2_ppm = ppm;
+    view_changed(page_co2);
+  }
+}
+
+/*************************************************************
+ Function             : void view_set_tempCF(bool celsius)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the unit of the temperature on the sensor page.
+*************************************************************/
+void view_set_tempCF(bool celsius) {
+  if(celsius != model.celsius) {
+    model.celsius = celsius;
+    view_changed(page_sensor);
+  }
+}
+
+/*************************************************************
+ Function             : void view_set_alarm(
+                        alarm_channel ch, alarm_level level)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Sets the alarm level of channel ch. Every alarm is 
+ shown on the sensor page, the CO2 alarm also on the 
+ CO2 page.
+*************************************************************/
+void view_set_alarm(alarm_channel ch, alarm_level level) {
+  if(level != model.alarms[ch]) {
+    model.alarms[ch] = level;
+    view_changed(page_sensor);
+    if(ch == alarm_co2) {
+      view_changed(page_co2);
+    }
+  }
+}
+
+/*************************************************************
+ Function             : static void view_changed(
+                        view_page page)
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Marks the active page dirty if it is page.
+*************************************************************/
+static void view_changed(view_page page) {
+  if(page == view_active) {
+    view_dirty = true;
+  }
+}
+
+/*************************************************************
+ Function             : static void render_sensor_page()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Writes the sensor page to the display buffers:
+ Time: hh:mm:ssAd
+ Temp: temp C (or F)
+ RH:   rh% Sn
+ Ad is the first active alarm: T (temperature), H
+ (humidity), or C (CO2) and ^ (high) or v (low).
+ The sensor number is only shown with more than one 
+ Humidicon.
+*************************************************************/
+static void render_sensor_page() {
+  int temp = (int)model.tempC[view_sensor];
+  unsigned char ch;
+  bool line_full = false;           // The alarm indicator ends the line
+  
+  lcd_puts("\fTime: ");
+  lcd_put_2digits(model.hours);
+  putchar(':');
+  lcd_put_2digits(model.minutes);
+  putchar(':');
+  lcd_put_2digits(model.seconds);
+  for(ch = 0; ch < alarm_channels; ch++) {
+    if(model.alarms[ch] != alarm_ok) {
+      putchar(alarm_letters[ch]);
+      putchar((model.alarms[ch] == alarm_high) ? '^' : 'v');
+      line_full = true;
+      break;
+    }
+  }
+  
+  // A full line already moved to the next one, a newline would skip it
+  lcd_puts(line_full ? "Temp: " : "\nTemp: ");
+  if(!model.celsius) {
+    temp = (int)(((long)temp * 9) / 5 + 3200);    // Fahrenheit
+  }
+  lcd_put_fixed(temp, 2);
+  putchar(0xDF);
+  putchar(model.celsius ? 'C' : 'F');
+  
+  lcd_puts("\nRH:   ");
+  lcd_put_fixed(model.rh[view_sensor], 2);
+  putchar('%');
+#if HUMIDICON_COUNT > 1
+  lcd_puts(" S");
+  putchar('0' + view_sensor);
+#endif
+}
+
+/*************************************************************
+ Function             : static void render_co2_page()
+ Date                 : 10/16/2026
+ Version              : 1.0
+ Target MCU           : ATmega128
+ Author               : Wilmer Suarez
+ DESCRIPTION
+ Writes the CO2 page to the display buffers: the sensor
+ voltage, the concentration, and a CO2 alarm, or the 
+ sensor status if there is no valid concentration.
+*************************************************************/
+static void render_co2_page() {
+  switch(model.co2_state) {
+    case co2_fault:
+      lcd_puts("\f      CO2:\n");    
+      lcd_puts("      Fault");
+      break;
+    case co2_preheating:
+      lcd_puts("\f      CO2:\n");    
+      lcd_puts("   Preheating");
+      break;
+    case co2_valid:
+      lcd_puts("\fV: ");
+      lcd_put_fixed((int)(((unsigned long)model.co2_counts * 25) >> 2), 1);   // 0.625mV per count, in 0.1mV units
+      lcd_puts("mv\nCO2: ");
+      lcd_put_uint(model.co2_ppm, 1);
+      lcd_puts("ppm\n");    
+      if(model.alarms[alarm_co2] == alarm_high) {
+        lcd_puts("Alarm: high");
+      } else if(model.alarms[alarm_co2] == alarm_low) {
+        lcd_puts("Alarm: low");
+      }
+      break;
+  }
+}
@@ -0,0 +1,32 @@
+/****************************************************************
+  File Name            : "view.h" 
+  Title                : Display Page Manager Header File
+  Date                 : 10/16/2026  
+  Version              : 1.0 
+  Target MCU           : ATMEGA128A
+  Author               : Wilmer Suarez 
+  DESCRIPTION 
+  This header file declares the pages drawn from the display
+  model and the external functions used to update the model,
+  switch pages, and render the active page.
+  header.h and alarm.h must be included first.
+****************************************************************/ 
+
+// ------- Pages drawn by the view ------- //
+// page_none: the FSM (prompts, time/alarm entry, diagnostics) owns the LCD
+typedef enum {page_none, page_sensor, page_co2} view_page;
+
+// ------- External Functions for the Page Manager ------- //
+extern void view_show(view_page page);              // Switch page, rendered by the next view_render()
+extern bool view_select_sensor(unsigned char n);    // Humidicon on the sensor page, false if not fitted
+extern void view_render();                          // Draw the active page if it changed
+
+// ------- Display model ------- //
+extern void view_set_time(unsigned char hours, unsigned char minutes, unsigned char seconds);
+extern void view_set_sensor(unsigned char n, unsigned int rh, unsigned int tempC);   // 0.01% RH, 0.01 degrees C
+extern void view_set_co2(unsigned int counts);      // Filtered 12-bit ADC value
+extern void view_set_tempCF(bool celsius);
+extern void view_set_alarm(alarm_channel ch, alarm_level level);
+
+// Number of pages drawn (model changes and page switches)
+extern unsigned int view_renders;